@@ -21,6 +21,29 @@
  *      indirection during runtime. The client will need to provide nodes with
  *      buckets via the 'add_bucket' operation, otherwise the 'add_edge'
  *      operation will fail.
+ *   3. Nothing is locked. To build a graph from several threads at once, use
+ *      'graph_add_edge_concurrent' and 'graph_add_bucket_concurrent', which
+ *      claim empty slots and append buckets with compare-and-swap instead of
+ *      a plain store, and define GRAPH_CAS_PTR as an atomic compare-and-swap
+ *      before including this header, eg with GCC:
+ *        #define GRAPH_CAS_PTR(ptr, old, new) \
+ *            __sync_bool_compare_and_swap((ptr), (old), (new))
+ *      The default GRAPH_CAS_PTR is a plain compare and store, which is only
+ *      safe on one thread. Define GRAPH_ATOMIC_ADD and GRAPH_ATOMIC_OR the
+ *      same way, eg as __sync_fetch_and_add and __sync_fetch_and_or, so the
+ *      counters and occupancy masks below stay exact. Deleting edges while
+ *      other threads insert is not supported.
+ *   4. The graph counts its edges and buckets and each node counts its edges
+ *      out as they are added and deleted. 'graph_stats' reports those counts
+ *      along with how well the buckets are used.
+ *   5. Each bucket keeps a mask of which of its slots hold edges. To visit the
+ *      edges out of a node, use GRAPH_FOR_EACH_OUT_EDGE, which skips straight
+ *      from one live slot to the next instead of reading the empty ones.
+ *   6. A single 'graph_has_edge' is a chain of cache misses, the node and then
+ *      each bucket, with nothing to do while waiting. To check many edges at
+ *      once, use 'graph_has_edges', which keeps GRAPH_BATCH_WIDTH lookups in
+ *      flight and prefetches the next node or bucket of each while working on
+ *      the others, so the misses overlap.
  *
  * === How to Modify ===
  * This header was desigend to be extensible and basic, not a catch-all graphing
@@ -49,24 +72,109 @@
 typedef struct BucketTag Bucket;
 typedef struct NodeTag Node;
 typedef struct GraphTag Graph;
+typedef struct GraphStatsTag GraphStats;
+typedef struct GraphLookupTag GraphLookup;
 
-/*  how many edges out per bucket  */
+/*  how many edges out per bucket, at most 16 so a bucket's slots fit in the
+ *  bits of an unsigned int  */
 #define BUCKET_SIZE 10
 
+/*  the occupancy mask of a bucket with every slot holding an edge  */
+#define GRAPH_BUCKET_FULL ((unsigned int)((1UL << BUCKET_SIZE) - 1))
+
+/*  index of the lowest set bit of a non-zero unsigned int  */
+#ifndef GRAPH_CTZ
+#ifdef __GNUC__
+#define GRAPH_CTZ(bits) __builtin_ctz(bits)
+#else
+#define GRAPH_CTZ(bits) graph_ctz(bits)
+#endif
+#endif
+
+/*
+ * Iterate over the edges out of a node, visiting only live slots.
+ * Each bucket's occupancy mask is copied into @bits and the lowest set bit is
+ * cleared after each edge, so empty slots are never read.
+ * CAUTION: this is two nested loops. 'break' only leaves the current bucket;
+ *   use goto to stop early.
+ *
+ * @node: Pointer to the node whose edges to visit.
+ * @cursor: A Bucket pointer variable, the bucket being visited.
+ * @bits: An unsigned int variable, the slots of @cursor left to visit.
+ * @adj_node: A Node pointer variable. Receives the end of each edge.
+ */
+#define GRAPH_FOR_EACH_OUT_EDGE(node, cursor, bits, adj_node) \
+    for ((cursor) = (node)->edges_out; (cursor) != 0; \
+         (cursor) = (cursor)->next) \
+        for ((bits) = (cursor)->used; \
+             (bits) != 0 && \
+             ((adj_node) = (cursor)->adj_nodes[GRAPH_CTZ(bits)], 1); \
+             (bits) &= (bits) - 1)
+
+/*  compare-and-swap on a pointer: if *ptr == old, store new and yield 1,
+ *  otherwise yield 0. Define as an atomic operation for concurrent use.  */
+#ifndef GRAPH_CAS_PTR
+#define GRAPH_CAS_PTR(ptr, old, new) \
+    (*(ptr) == (old) ? (*(ptr) = (new), 1) : 0)
+#endif
+
+/*  add to an int counter. Define as an atomic operation for concurrent use.  */
+#ifndef GRAPH_ATOMIC_ADD
+#define GRAPH_ATOMIC_ADD(ptr, val) (*(ptr) += (val))
+#endif
+
+/*  set bits of an unsigned int mask. Define as an atomic operation for
+ *  concurrent use.  */
+#ifndef GRAPH_ATOMIC_OR
+#define GRAPH_ATOMIC_OR(ptr, val) (*(ptr) |= (val))
+#endif
+
+/*  hint that memory will be read soon. Define as nothing to disable.  */
+#ifndef GRAPH_PREFETCH
+#ifdef __GNUC__
+#define GRAPH_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define GRAPH_PREFETCH(addr) ((void)(addr))
+#endif
+#endif
+
+/*  how many lookups 'graph_has_edges' keeps in flight. Enough to cover a
+ *  memory access with work on the others, few enough to stay in registers
+ *  and L1.  */
+#ifndef GRAPH_BATCH_WIDTH
+#define GRAPH_BATCH_WIDTH 16
+#endif
+
+/*  BUCKET_SIZE must fit in the occupancy mask  */
+typedef char graph_bucket_size_check[(BUCKET_SIZE >= 1 && BUCKET_SIZE <= 16) ?
+                                     1 : -1];
+
 static Node *graph_find_node_by_id(Graph *graph, int node_id);
-static Node **graph_find_edge(Graph *graph, int from_id, int to_id);
-static Node **graph_find_empty_edge(Graph *graph, int node_id);
-static Node **graph_find_pointer(Graph *graph, Node *node_from, Node *node_to);
+static Node **graph_find_edge(Graph *graph, int from_id, int to_id,
+                              Bucket **bucket);
+static Node **graph_find_empty_edge(Graph *graph, int node_id,
+                                    Bucket **bucket);
+static Node **graph_find_pointer(Graph *graph, Node *node_from, Node *node_to,
+                                 Bucket **bucket);
+static void graph_lookup_start(Graph *graph, GraphLookup *look,
+                               const int *from_ids, const int *to_ids,
+                               long index);
+static int graph_ctz(unsigned int bits);
 
 /*
  * A bucket of edges out of a node.
  *
  * @adj_nodes: Array of edges out of the node.
+ * @used: Occupancy mask. Bit i is set if and only if @adj_nodes[i] holds an
+ *   edge, so a bucket with no edges has a @used of 0.
+ * @count: The number of edges in the bucket, the set bits of @used.
  * @next: The next bucket. Null if this is the last bucket.
  */
 struct BucketTag
 {
     Node *adj_nodes[BUCKET_SIZE];
+    unsigned int used;
+    int count;
     Bucket *next;
 };
 
@@ -74,11 +182,13 @@ struct BucketTag
  * A node in the graph.
  *
  * @id: The node's unique identifying number. Always positive.
+ * @degree: The number of edges leaving this node.
  * @edges_out: Linked list of each edge leaving this node.
  */
 struct NodeTag
 {
     int id;
+    int degree;
     Bucket *edges_out;
 };
 
@@ -89,6 +199,7 @@ struct NodeTag
  * @size: The maximum number of nodes the graph can hold.
  * @num_nodes: The number of nodes in the graph.
  * @num_edges: The number of edges in the graph.
+ * @num_buckets: The number of buckets given to the graph's nodes.
  * @nodes: A pointer to an array containing the graph's nodes.
  */
 struct GraphTag
@@ -96,19 +207,68 @@ struct GraphTag
     int size;
     int num_nodes;
     int num_edges;
+    int num_buckets;
     Node *nodes;
 };
 
+/*
+ * A summary of a graph's shape and memory use, from 'graph_stats'.
+ *
+ * @num_nodes: Number of nodes the graph can hold, its size.
+ * @num_edges: Number of edges.
+ * @num_buckets: Number of buckets.
+ * @max_degree: Largest number of edges out of one node.
+ * @max_chain: Longest bucket chain of one node.
+ * @avg_chain: Average bucket chain length over nodes with any buckets.
+ * @fill_ratio: Fraction of all bucket slots holding an edge.
+ * @hole_ratio: Fraction of the slots up to the last edge of each chain that
+ *   are empty. These are the holes deletions leave behind, which cost a read
+ *   on every traversal.
+ * @bytes: Memory held by the graph, its nodes and its buckets.
+ * @histogram: Number of nodes by degree. Bin 0 counts degree 0 and bin k
+ *   degrees in [2^(k-1), 2^k), with the last bin taking everything larger.
+ * @num_bins: Number of bins in @histogram.
+ */
+struct GraphStatsTag
+{
+    int num_nodes;
+    int num_edges;
+    int num_buckets;
+    int max_degree;
+    int max_chain;
+    double avg_chain;
+    double fill_ratio;
+    double hole_ratio;
+    long bytes;
+    int *histogram;
+    int num_bins;
+};
+
+/*
+ * One edge lookup of a batch, stopped where it waits on memory.
+ *
+ * @index: Index of the lookup in the batch, -1 if the lookup is idle.
+ * @target: The node the edge must end at.
+ * @cursor: The bucket to scan next. Null while the node hasn't been read.
+ */
+struct GraphLookupTag
+{
+    long index;
+    Node *target;
+    Bucket *cursor;
+};
+
 /*
  * Initialize a graph.
  * @graph will be initialized to use @node_arr for its node storage and its
  * attributes will be initialized to:
  *   - size: @node_arr_size
- *   - num_nodes, num_edges: 0
- *   - nodes: Each node in the array will get an id equal to their index and its
- *     edges_out attribute will be null.
+ *   - num_nodes, num_edges, num_buckets: 0
+ *   - nodes: Each node in the array will get an id equal to their index, a
+ *     degree of 0 and its edges_out attribute will be null.
  * @graph's previous 'nodes' attribute will not be modified, so this function
- * can also be used to re-initialize a graph to expand/contract it.
+ * can also be used to re-initialize a graph to expand/contract it; copy the
+ * nodes' edges_out and degree and the graph's counts over after.
  *
  * @node_arr: An array for the graph to keep its nodes in.
  * @node_arr_size: The size of @node_arr.
@@ -120,11 +280,13 @@ static void graph_init(Graph *graph, Node* node_arr, int node_arr_size)
     graph->size = node_arr_size;
     graph->num_nodes = 0;
     graph->num_edges = 0;
+    graph->num_buckets = 0;
     graph->nodes = node_arr;
 
     for (idx = 0; idx < node_arr_size; idx++)
     {
         node_arr[idx].id = idx;
+        node_arr[idx].degree = 0;
         node_arr[idx].edges_out = 0;
     }
 }
@@ -147,6 +309,8 @@ static void graph_add_bucket(Graph *graph, int node_id, Bucket* bucket)
 
     /*  initialize the bucket  */
     bucket->next = 0;
+    bucket->used = 0;
+    bucket->count = 0;
     for (idx = 0; idx < BUCKET_SIZE; idx++)
     {
         bucket->adj_nodes[idx] = 0;
@@ -167,6 +331,7 @@ static void graph_add_bucket(Graph *graph, int node_id, Bucket* bucket)
         }
         cursor->next = bucket;
     }
+    graph->num_buckets++;
 }
 
 /*
@@ -180,8 +345,9 @@ static int graph_add_edge(Graph *graph, int from_id, int to_id)
 {
     Node *node_to;
     Node **edge_spot;
+    Bucket *bucket;
 
-    edge_spot = graph_find_empty_edge(graph, from_id);
+    edge_spot = graph_find_empty_edge(graph, from_id, &bucket);
     if (edge_spot == 0)
     {
         /*  no empty edges  */
@@ -190,10 +356,108 @@ static int graph_add_edge(Graph *graph, int from_id, int to_id)
 
     node_to = graph_find_node_by_id(graph, to_id);
     (*edge_spot) = node_to;
+    bucket->used |= 1U << (edge_spot - bucket->adj_nodes);
+    bucket->count++;
+    graph->nodes[from_id].degree++;
+    graph->num_edges++;
 
     return 0;
 }
 
+/*
+ * Initialize and add a bucket to a node's edge list, safely alongside other
+ * threads adding buckets and edges.
+ * The bucket is linked in with a compare-and-swap on the last bucket's next
+ * link, retried from the new last bucket if another thread got there first.
+ *
+ * @node_id: Id of the node to add @bucket.
+ * @bucket: pointer to bucket object to use for @node. Assumed to be just
+ *   allocated and not yet visible to other threads.
+ */
+static void graph_add_bucket_concurrent(Graph *graph, int node_id,
+                                        Bucket *bucket)
+{
+    int idx;
+    Bucket *cursor;
+    Node *node;
+
+    node = graph_find_node_by_id(graph, node_id);
+
+    /*  initialize the bucket before it is published  */
+    bucket->next = 0;
+    bucket->used = 0;
+    bucket->count = 0;
+    for (idx = 0; idx < BUCKET_SIZE; idx++)
+    {
+        bucket->adj_nodes[idx] = 0;
+    }
+
+    GRAPH_ATOMIC_ADD(&graph->num_buckets, 1);
+    if (GRAPH_CAS_PTR(&node->edges_out, (Bucket *)0, bucket))
+    {
+        return;
+    }
+    cursor = node->edges_out;
+    while (1)
+    {
+        while (cursor->next != 0)
+        {
+            cursor = cursor->next;
+        }
+        if (GRAPH_CAS_PTR(&cursor->next, (Bucket *)0, bucket))
+        {
+            return;
+        }
+    }
+}
+
+/*
+ * Add an edge to a graph, safely alongside other threads adding buckets and
+ * edges.
+ * Empty slots are claimed with a compare-and-swap, so two threads never
+ * store into the same slot; a thread that loses a slot moves on to the next.
+ * The slot's occupancy bit is set after the claim, so a slot is only ever
+ * marked used once it holds its edge.
+ *
+ * @from_id: The id of the node the edge starts at. Assumed to be valid.
+ * @to_id: The id of the node the edge ends at. Assumed to be valid.
+ * @return: 0 if the edge was added, 1 if there wasn't enough space for it.
+ */
+static int graph_add_edge_concurrent(Graph *graph, int from_id, int to_id)
+{
+    int idx;
+    unsigned int free_bits;
+    Bucket *cursor;
+    Node *node_to;
+    Node **adj_nodes;
+
+    node_to = graph_find_node_by_id(graph, to_id);
+    cursor = graph_find_node_by_id(graph, from_id)->edges_out;
+    while (cursor != 0)
+    {
+        adj_nodes = cursor->adj_nodes;
+        for (free_bits = ~cursor->used & GRAPH_BUCKET_FULL; free_bits != 0;
+             free_bits &= free_bits - 1)
+        {
+            idx = GRAPH_CTZ(free_bits);
+            if (adj_nodes[idx] == 0 &&
+                GRAPH_CAS_PTR(&adj_nodes[idx], (Node *)0, node_to))
+            {
+                GRAPH_ATOMIC_OR(&cursor->used, 1U << idx);
+                GRAPH_ATOMIC_ADD(&cursor->count, 1);
+                GRAPH_ATOMIC_ADD(&graph->nodes[from_id].degree, 1);
+                GRAPH_ATOMIC_ADD(&graph->num_edges, 1);
+                return 0;
+            }
+        }
+
+        cursor = cursor->next;
+    }
+
+    /*  no empty edges  */
+    return 1;
+}
+
 /*
  * Remove an edge from a graph.
  *
@@ -203,9 +467,10 @@ static int graph_add_edge(Graph *graph, int from_id, int to_id)
 static void graph_del_edge(Graph *graph, int from_id, int to_id)
 {
     Node **edge;
+    Bucket *bucket;
 
-    /*  find first null pointer in @from_ids list of edges out  */
-    edge = graph_find_edge(graph, from_id, to_id);
+    /*  find the edge in @from_ids list of edges out  */
+    edge = graph_find_edge(graph, from_id, to_id, &bucket);
 
     if (edge == 0)
     {
@@ -215,6 +480,10 @@ static void graph_del_edge(Graph *graph, int from_id, int to_id)
 
     /*  delete the edge  */
     (*edge) = 0;
+    bucket->used &= ~(1U << (edge - bucket->adj_nodes));
+    bucket->count--;
+    graph->nodes[from_id].degree--;
+    graph->num_edges--;
 }
 
 /*
@@ -228,7 +497,7 @@ static int graph_has_edge(Graph *graph, int from_id, int to_id)
 {
     Node **edge_ptr;
 
-    edge_ptr = graph_find_edge(graph, from_id, to_id);
+    edge_ptr = graph_find_edge(graph, from_id, to_id, 0);
 
     if (edge_ptr == 0)
     {
@@ -241,6 +510,107 @@ static int graph_has_edge(Graph *graph, int from_id, int to_id)
     }
 }
 
+/*
+ * Determine if a graph has each of a batch of edges.
+ * Lookups are interleaved: each takes one step, reading a node or scanning a
+ * bucket, prefetches what it needs next and yields to the next lookup, so
+ * GRAPH_BATCH_WIDTH cache misses are outstanding at a time instead of one.
+ *
+ * @from_ids: Id of the node each edge starts at. Assumed to be valid.
+ * @to_ids: Id of the node each edge ends at. Assumed to be valid.
+ * @count: Number of edges to look up.
+ * @found: Array of (@count + 7) / 8 bytes. Bit i % 8 of byte i / 8 is set if
+ *   the graph has edge i and cleared if not. Note this is the opposite sense
+ *   of 'graph_has_edge's result.
+ * @return: The number of edges the graph has.
+ */
+static long graph_has_edges(Graph *graph, const int *from_ids,
+                            const int *to_ids, long count,
+                            unsigned char *found)
+{
+    GraphLookup lanes[GRAPH_BATCH_WIDTH];
+    GraphLookup *look;
+    long next;
+    long hits;
+    int active;
+    int lane;
+    int done;
+    unsigned int bits;
+
+    for (next = 0; next < (count + 7) / 8; next++)
+    {
+        found[next] = 0;
+    }
+
+    next = 0;
+    active = 0;
+    for (lane = 0; lane < GRAPH_BATCH_WIDTH; lane++)
+    {
+        lanes[lane].index = -1;
+        if (next < count)
+        {
+            graph_lookup_start(graph, &lanes[lane], from_ids, to_ids, next++);
+            active++;
+        }
+    }
+
+    hits = 0;
+    lane = 0;
+    while (active > 0)
+    {
+        look = &lanes[lane];
+        lane = (lane + 1 == GRAPH_BATCH_WIDTH ? 0 : lane + 1);
+        if (look->index < 0)
+        {
+            continue;
+        }
+
+        done = 0;
+        if (look->cursor == 0)
+        {
+            /*  the node has arrived, fetch its first bucket  */
+            look->cursor = graph->nodes[from_ids[look->index]].edges_out;
+            done = (look->cursor == 0);
+        }
+        else
+        {
+            /*  the bucket has arrived, scan its live slots  */
+            for (bits = look->cursor->used; bits != 0; bits &= bits - 1)
+            {
+                if (look->cursor->adj_nodes[GRAPH_CTZ(bits)] == look->target)
+                {
+                    found[look->index / 8] |= 1U << (look->index % 8);
+                    hits++;
+                    done = 1;
+                    break;
+                }
+            }
+            if (!done)
+            {
+                look->cursor = look->cursor->next;
+                done = (look->cursor == 0);
+            }
+        }
+
+        if (!done)
+        {
+            GRAPH_PREFETCH(look->cursor);
+            GRAPH_PREFETCH(&look->cursor->used);
+        }
+        else if (next < count)
+        {
+            graph_lookup_start(graph, look, from_ids, to_ids, next++);
+        }
+        else
+        {
+            look->index = -1;
+            active--;
+        }
+    }
+
+    return hits;
+}
+
 /*
  * Determine if a node id is valid.
  *
@@ -256,6 +626,103 @@ static int graph_node_id_valid(Graph *graph, int node_id)
     return 0;
 }
 
+/*
+ * Summarize a graph's shape and memory use.
+ * The counts are kept up to date as the graph changes; the chain, slot and
+ * degree figures come from one walk over every bucket.
+ *
+ * @stats: Receives the summary.
+ * @histogram: Array of @num_bins ints for the degree histogram. May be null.
+ * @num_bins: Number of bins in @histogram.
+ */
+static void graph_stats(Graph *graph, GraphStats *stats, int *histogram,
+                        int num_bins)
+{
+    int node_id;
+    int idx;
+    int bin;
+    int chain;
+    int chained_nodes;
+    long chain_total;
+    long slots;
+    long live;
+    long slots_to_last;
+    long last_used;
+    Bucket *cursor;
+    Node *node;
+
+    stats->num_nodes = graph->size;
+    stats->num_edges = graph->num_edges;
+    stats->num_buckets = graph->num_buckets;
+    stats->max_degree = 0;
+    stats->max_chain = 0;
+    stats->histogram = histogram;
+    stats->num_bins = num_bins;
+    stats->bytes = (long)sizeof(Graph) + (long)graph->size * sizeof(Node) +
+                   (long)graph->num_buckets * sizeof(Bucket);
+    for (bin = 0; histogram != 0 && bin < num_bins; bin++)
+    {
+        histogram[bin] = 0;
+    }
+
+    chained_nodes = 0;
+    chain_total = 0;
+    slots = 0;
+    live = 0;
+    slots_to_last = 0;
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        node = &graph->nodes[node_id];
+        if (node->degree > stats->max_degree)
+        {
+            stats->max_degree = node->degree;
+        }
+        if (histogram != 0 && num_bins > 0)
+        {
+            for (bin = 0; bin + 1 < num_bins && (node->degree >> bin) > 0;
+                 bin++)
+            {
+            }
+            histogram[bin]++;
+        }
+
+        /*  slots up to the last edge of the chain, live or not  */
+        chain = 0;
+        last_used = 0;
+        for (cursor = node->edges_out; cursor != 0; cursor = cursor->next)
+        {
+            if (cursor->used != 0)
+            {
+                /*  one past the highest set bit  */
+                for (idx = BUCKET_SIZE; !(cursor->used >> (idx - 1) & 1);
+                     idx--)
+                {
+                }
+                last_used = (long)chain * BUCKET_SIZE + idx;
+                live += cursor->count;
+            }
+            chain++;
+        }
+        slots += (long)chain * BUCKET_SIZE;
+        slots_to_last += last_used;
+        if (chain > 0)
+        {
+            chained_nodes++;
+            chain_total += chain;
+        }
+        if (chain > stats->max_chain)
+        {
+            stats->max_chain = chain;
+        }
+    }
+
+    stats->avg_chain = (chained_nodes > 0 ?
+                        (double)chain_total / chained_nodes : 0.0);
+    stats->fill_ratio = (slots > 0 ? (double)live / slots : 0.0);
+    stats->hole_ratio = (slots_to_last > 0 ?
+                         (double)(slots_to_last - live) / slots_to_last : 0.0);
+}
+
 
 /* === HELPER FUNCTIONS === */
 
@@ -277,12 +744,14 @@ static Node *graph_find_node_by_id(Graph *graph, int node_id)
  *
  * @from_id: Id of the node the edge starts at. Assumed to be valid.
  * @to_id: Id of he node the edge ends at. Assumed to be valid.
+ * @bucket: Receives the bucket holding the edge. May be null.
  * @return:
  *   1. A pointer to the edge. Points to the spot in @from_id's list of edges
  *      out that points to @to_id.
  *   2. Null if the edge doesn't exist or either node id is invalid.
  */
-static Node **graph_find_edge(Graph *graph, int from_id, int to_id)
+static Node **graph_find_edge(Graph *graph, int from_id, int to_id,
+                              Bucket **bucket)
 {
     Node *node_to;
     Node *node_from;
@@ -290,57 +759,70 @@ static Node **graph_find_edge(Graph *graph, int from_id, int to_id)
     node_to = graph_find_node_by_id(graph, to_id);
     node_from = graph_find_node_by_id(graph, from_id);
 
-    return graph_find_pointer(graph, node_from, node_to);
+    return graph_find_pointer(graph, node_from, node_to, bucket);
 }
 
 /*
  * Find the first empty spot to put a new edge in a graph.
  *
  * @node_id: Id of the node to find the empty edge in. Assumed to be valid.
+ * @bucket: Receives the bucket holding the empty edge. May be null.
  * @return:
  *   1. A pointer to the emtpy edge. Points to the spot in @node_id's list of
  *      edges out that is empty.
  *   2. Null if there is no empty edges
  */
-static Node **graph_find_empty_edge(Graph *graph, int node_id)
+static Node **graph_find_empty_edge(Graph *graph, int node_id,
+                                    Bucket **bucket)
 {
     Node *node;
 
     node = graph_find_node_by_id(graph, node_id);
 
     /*  find first null pointer in @node's list of edges out  */
-    return graph_find_pointer(graph, node, 0);
+    return graph_find_pointer(graph, node, 0, bucket);
 }
 
 /*
  * Find a specific pointer in a node's list of edges.
+ * Only the slots the occupancy masks mark live are compared against a
+ * non-null @node_to, and the first empty slot of a bucket is one bit scan of
+ * its free slots.
  *
  * @node_from: The node whose list of edges out to find the pointer in. Assumed
  *   to be non-null.
  * @node_to: The target pointer to find in @node_from's list of edges out. Can
  *   be null, in which case it will find the first null edge.
+ * @bucket: Receives the bucket holding the spot. May be null.
  * @return:
  *   1. A pointer to the spot that points to @node_to.
  *   2. Null, if the pointer doesn't exist.
  */
-static Node **graph_find_pointer(Graph *graph, Node *node_from, Node *node_to)
+static Node **graph_find_pointer(Graph *graph, Node *node_from, Node *node_to,
+                                 Bucket **bucket)
 {
     int idx;
+    unsigned int bits;
     Bucket *cursor;
-    Node **adj_nodes;
 
     /*  iterate through each bucket  */
     cursor = node_from->edges_out;
     while (cursor != 0)
     {
-        /*  iterate through each spot in the bucket  */
-        for (idx = 0; idx < BUCKET_SIZE; idx++)
+        /*  iterate through the live spots, or the free ones for null  */
+        bits = (node_to == 0 ? ~cursor->used & GRAPH_BUCKET_FULL :
+                               cursor->used);
+        for (; bits != 0; bits &= bits - 1)
         {
-            adj_nodes = cursor->adj_nodes;
-            if (adj_nodes[idx] == node_to)
+            idx = GRAPH_CTZ(bits);
+            if (cursor->adj_nodes[idx] == node_to)
             {
                 /*  pointer is found  */
-                return &(adj_nodes[idx]);
+                if (bucket != 0)
+                {
+                    (*bucket) = cursor;
+                }
+                return &(cursor->adj_nodes[idx]);
             }
         }
 
@@ -351,5 +833,37 @@ static Node **graph_find_pointer(Graph *graph, Node *node_from, Node *node_to)
     return 0;
 }
 
+/*
+ * Start a lookup of a batch by prefetching the node the edge starts at.
+ *
+ * @index: Index of the lookup in the batch.
+ */
+static void graph_lookup_start(Graph *graph, GraphLookup *look,
+                               const int *from_ids, const int *to_ids,
+                               long index)
+{
+    look->index = index;
+    look->target = &graph->nodes[to_ids[index]];
+    look->cursor = 0;
+    GRAPH_PREFETCH(&graph->nodes[from_ids[index]]);
+}
+
+/*
+ * Find the lowest set bit of a mask, for compilers without a builtin.
+ *
+ * @bits: The mask. Assumed to be non-zero.
+ * @return: The index of the lowest set bit.
+ */
+static int graph_ctz(unsigned int bits)
+{
+    int idx;
+
+    for (idx = 0; !(bits & 1U); idx++)
+    {
+        bits >>= 1;
+    }
+    return idx;
+}
+
 
 #endif
@@ -0,0 +1,352 @@
+/*
+ * Approximate neighborhood function, effective diameter and harmonic
+ * centrality with HyperLogLog counters (HyperANF).
+ * See Boldi, Rosa and Vigna, "HyperANF: Approximating the Neighbourhood
+ * Function of Very Large Graphs on a Budget" (2011) for the theory.
+ *
+ * The neighborhood function N(t) counts the pairs of nodes (u, v) such that v
+ * can be reached from u in at most t steps. Computing it exactly needs a
+ * search from every node. HyperANF instead gives every node a HyperLogLog
+ * counter, a sketch of a set of nodes in a few bytes, starting with the node
+ * itself. Since the nodes within t + 1 steps of u are u's own ball of radius
+ * t plus the radius t balls of its successors, one pass over the edges taking
+ * the union of counters moves every ball one step further. Unions of
+ * HyperLogLog counters are a register-wise max, done here four registers at a
+ * time with broadword arithmetic on 32-bit words. Passes stop once no counter
+ * changes, which takes as many passes as the graph's diameter.
+ *
+ * From the per-pass estimates this header derives:
+ *   - the neighborhood function N(0), N(1), ...
+ *   - the effective diameter, the distance within which a given fraction
+ *     (usually 90%) of the reachable pairs lie,
+ *   - the harmonic centrality of every node, the sum over other nodes of
+ *     1 / distance, from how much each node's ball grows at each distance.
+ *
+ * === How to Use ===
+ * This header does no memory management. Choose log2m, the log2 of the
+ * registers per counter: relative standard error is about 1.04 / sqrt(2^log2m),
+ * so 6 gives 13% per node and much better on sums over nodes. Allocate two
+ * arrays of num_nodes * ANF_WORDS(log2m) AnfWords and, for harmonic
+ * centrality, one of num_nodes doubles, then call 'graph_anf_init' and
+ * 'graph_anf_run'.
+ *
+ * Counters follow edges out, so on a directed snapshot N counts (u, v) with v
+ * reachable from u. Use an undirected snapshot for undirected statistics.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_ANF_H
+#define GRAPH_ANF_H
+
+#include <limits.h>
+#include <math.h>
+#include "graph_csr.h"
+#include "graph_rng.h"
+
+/*  a word of four 8-bit registers, the smallest type of at least 32 bits  */
+#if UINT_MAX >= 0xFFFFFFFFUL
+typedef unsigned int AnfWord;
+#else
+typedef unsigned long AnfWord;
+#endif
+
+typedef struct HyperAnfTag HyperAnf;
+
+/*  number of AnfWords in one counter of 2^log2m registers  */
+#define ANF_WORDS(log2m) ((1 << (log2m)) / 4)
+
+/*  broadword masks: the high bit of every byte, and the low 32 bits  */
+#define ANF_HIGH_BITS ((AnfWord)0x80808080UL)
+#define ANF_LOW_32 ((AnfWord)0xFFFFFFFFUL)
+
+static double graph_anf_estimate(const HyperAnf *anf, int node_id);
+static AnfWord graph_anf_max(AnfWord left, AnfWord right);
+
+/*
+ * The state of a HyperANF computation.
+ *
+ * @num_nodes: Number of nodes.
+ * @log2m: Log2 of the number of registers per counter, in [4, 16].
+ * @words: Number of AnfWords per counter.
+ * @current: Counters of the balls of the current radius.
+ * @next: Counters of the balls of the next radius.
+ * @last_estimate: Size estimate of every ball at the current radius. May be
+ *   null if harmonic centrality isn't wanted.
+ * @seed: Seed of the hash that places nodes in registers.
+ */
+struct HyperAnfTag
+{
+    int num_nodes;
+    int log2m;
+    int words;
+    AnfWord *current;
+    AnfWord *next;
+    double *last_estimate;
+    unsigned long seed;
+};
+
+/*
+ * Initialize HyperANF, giving every node a counter holding just itself.
+ *
+ * @num_nodes: Number of nodes.
+ * @log2m: Log2 of the registers per counter, in [4, 16].
+ * @counters_a: Array of num_nodes * ANF_WORDS(@log2m) AnfWords.
+ * @counters_b: Array of num_nodes * ANF_WORDS(@log2m) AnfWords.
+ * @last_estimate: Array of num_nodes doubles, or null to skip harmonic
+ *   centrality.
+ * @seed: Seed of the node hash. Different seeds give independent estimates.
+ */
+static void graph_anf_init(HyperAnf *anf, int num_nodes, int log2m,
+                           AnfWord *counters_a, AnfWord *counters_b,
+                           double *last_estimate, unsigned long seed)
+{
+    int node_id;
+    int word;
+    int reg;
+    int rank;
+    unsigned long hash;
+    AnfWord *counter;
+
+    anf->num_nodes = num_nodes;
+    anf->log2m = log2m;
+    anf->words = ANF_WORDS(log2m);
+    anf->current = counters_a;
+    anf->next = counters_b;
+    anf->last_estimate = last_estimate;
+    anf->seed = seed;
+
+    for (node_id = 0; node_id < num_nodes; node_id++)
+    {
+        counter = anf->current + (long)node_id * anf->words;
+        for (word = 0; word < anf->words; word++)
+        {
+            counter[word] = 0;
+        }
+
+        /*  low bits pick the register, the rest give the rank  */
+        hash = graph_rng_hash(seed, (unsigned long)node_id);
+        reg = (int)(hash & ((1UL << log2m) - 1));
+        hash >>= log2m;
+        for (rank = 1; rank <= 32 - log2m && !(hash & 1); rank++)
+        {
+            hash >>= 1;
+        }
+        counter[reg / 4] |= (AnfWord)rank << (8 * (reg % 4));
+
+        if (last_estimate != 0)
+        {
+            last_estimate[node_id] = 1.0;
+        }
+    }
+}
+
+/*
+ * Run HyperANF until the counters stop changing.
+ *
+ * @anf: State initialized for @csr's number of nodes.
+ * @csr: Snapshot to measure.
+ * @neighborhood: Array of @max_dist + 1 doubles. Receives N(0), N(1), ...
+ * @max_dist: The most passes to make.
+ * @harmonic: Array of num_nodes doubles, or null. Receives the harmonic
+ *   centrality of each node. Requires @last_estimate.
+ * @return: The last distance T whose N(T) was computed. Less than
+ *   @max_dist means the counters converged and N(T) is the final count of
+ *   reachable pairs.
+ */
+static int graph_anf_run(HyperAnf *anf, const CsrGraph *csr,
+                         double *neighborhood, int max_dist, double *harmonic)
+{
+    int dist;
+    int node_id;
+    int entry;
+    int word;
+    int words;
+    int changed;
+    double estimate;
+    double total;
+    AnfWord *target;
+    AnfWord *source;
+    AnfWord *swap;
+
+    words = anf->words;
+    total = 0.0;
+    for (node_id = 0; node_id < anf->num_nodes; node_id++)
+    {
+        total += graph_anf_estimate(anf, node_id);
+        if (harmonic != 0)
+        {
+            harmonic[node_id] = 0.0;
+        }
+    }
+    neighborhood[0] = total;
+
+    for (dist = 1; dist <= max_dist; dist++)
+    {
+        /*  grow every ball by one step: union with the successors' balls  */
+        changed = 0;
+        for (node_id = 0; node_id < anf->num_nodes; node_id++)
+        {
+            target = anf->next + (long)node_id * words;
+            source = anf->current + (long)node_id * words;
+            for (word = 0; word < words; word++)
+            {
+                target[word] = source[word];
+            }
+            for (entry = csr->offsets[node_id];
+                 entry < csr->offsets[node_id + 1]; entry++)
+            {
+                source = anf->current + (long)csr->adj[entry] * words;
+                for (word = 0; word < words; word++)
+                {
+                    target[word] = graph_anf_max(target[word], source[word]);
+                }
+            }
+            source = anf->current + (long)node_id * words;
+            for (word = 0; word < words && !changed; word++)
+            {
+                changed = (target[word] != source[word]);
+            }
+        }
+        if (!changed)
+        {
+            return dist - 1;
+        }
+
+        swap = anf->current;
+        anf->current = anf->next;
+        anf->next = swap;
+
+        total = 0.0;
+        for (node_id = 0; node_id < anf->num_nodes; node_id++)
+        {
+            estimate = graph_anf_estimate(anf, node_id);
+            total += estimate;
+            if (harmonic != 0 && anf->last_estimate != 0)
+            {
+                /*  nodes first reached at this distance add 1 / dist each  */
+                if (estimate > anf->last_estimate[node_id])
+                {
+                    harmonic[node_id] += (estimate -
+                                          anf->last_estimate[node_id]) / dist;
+                }
+                anf->last_estimate[node_id] = estimate;
+            }
+        }
+        neighborhood[dist] = total;
+    }
+
+    return max_dist;
+}
+
+/*
+ * Compute the effective diameter from a neighborhood function: the smallest
+ * distance within which a fraction of the reachable pairs lie, interpolated
+ * linearly between integer distances.
+ *
+ * @neighborhood: N(0) .. N(@last) from 'graph_anf_run'.
+ * @last: The last distance of @neighborhood.
+ * @fraction: The fraction of pairs, usually 0.9.
+ * @return: The effective diameter.
+ */
+static double graph_anf_effective_diameter(const double *neighborhood,
+                                           int last, double fraction)
+{
+    int dist;
+    double target;
+
+    target = fraction * neighborhood[last];
+    if (neighborhood[0] >= target)
+    {
+        return 0.0;
+    }
+    for (dist = 1; dist <= last; dist++)
+    {
+        if (neighborhood[dist] >= target)
+        {
+            return (dist - 1) + (target - neighborhood[dist - 1]) /
+                                (neighborhood[dist] - neighborhood[dist - 1]);
+        }
+    }
+
+    return (double)last;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Estimate the number of nodes in a node's current counter.
+ * The HyperLogLog estimate, with linear counting for small sets.
+ *
+ * @node_id: The node whose ball to estimate.
+ */
+static double graph_anf_estimate(const HyperAnf *anf, int node_id)
+{
+    const AnfWord *counter;
+    int word;
+    int byte;
+    int reg;
+    int zeros;
+    double num_regs;
+    double alpha;
+    double sum;
+    double estimate;
+
+    counter = anf->current + (long)node_id * anf->words;
+    sum = 0.0;
+    zeros = 0;
+    for (word = 0; word < anf->words; word++)
+    {
+        for (byte = 0; byte < 4; byte++)
+        {
+            reg = (int)((counter[word] >> (8 * byte)) & 0xFF);
+            sum += 1.0 / (double)(1UL << reg);
+            zeros += (reg == 0);
+        }
+    }
+
+    num_regs = (double)(anf->words * 4);
+    if (anf->log2m == 4)
+    {
+        alpha = 0.673;
+    }
+    else if (anf->log2m == 5)
+    {
+        alpha = 0.697;
+    }
+    else if (anf->log2m == 6)
+    {
+        alpha = 0.709;
+    }
+    else
+    {
+        alpha = 0.7213 / (1.0 + 1.079 / num_regs);
+    }
+
+    estimate = alpha * num_regs * num_regs / sum;
+    if (estimate <= 2.5 * num_regs && zeros > 0)
+    {
+        estimate = num_regs * log(num_regs / zeros);
+    }
+    return estimate;
+}
+
+/*
+ * Take the byte-wise maximum of two words of four registers.
+ * Registers never exceed 127, so (x | 0x80) - y can't borrow across bytes and
+ * its high bit per byte says whether x >= y there.
+ */
+static AnfWord graph_anf_max(AnfWord left, AnfWord right)
+{
+    AnfWord ge;
+    AnfWord mask;
+
+    ge = (((left | ANF_HIGH_BITS) - (right & ~ANF_HIGH_BITS)) & ANF_HIGH_BITS);
+    mask = ((ge - (ge >> 7)) | ge) & ANF_LOW_32;
+    return (left & mask) | (right & ~mask & ANF_LOW_32);
+}
+
+
+#endif
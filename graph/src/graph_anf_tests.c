@@ -0,0 +1,174 @@
+/*
+ * Unit tests for the HyperANF header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_anf.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+#define MAX_ENTRIES 64
+#define LOG2M 8
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static CsrGraph csr;
+static int offsets[INIT_SIZE + 1];
+static int adj[MAX_ENTRIES];
+static HyperAnf anf;
+static AnfWord counters_a[INIT_SIZE * ANF_WORDS(LOG2M)];
+static AnfWord counters_b[INIT_SIZE * ANF_WORDS(LOG2M)];
+static double last_estimate[INIT_SIZE];
+
+static void init_path(int undirected);
+
+
+void test_broadword_max()
+{
+    AnfWord left, right, result;
+    int trial;
+    int byte;
+    unsigned int left_byte, right_byte;
+
+    srand(8);
+    for (trial = 0; trial < 1000; trial++)
+    {
+        left = 0;
+        right = 0;
+        for (byte = 0; byte < 4; byte++)
+        {
+            left |= (AnfWord)(rand() % 128) << (8 * byte);
+            right |= (AnfWord)(rand() % 128) << (8 * byte);
+        }
+        result = graph_anf_max(left, right);
+        for (byte = 0; byte < 4; byte++)
+        {
+            left_byte = (unsigned int)((left >> (8 * byte)) & 0xFF);
+            right_byte = (unsigned int)((right >> (8 * byte)) & 0xFF);
+            TEST_ASSERT_EQUAL_UINT(left_byte > right_byte ?
+                                   left_byte : right_byte,
+                                   (unsigned int)((result >> (8 * byte)) &
+                                                  0xFF));
+        }
+    }
+}
+
+void test_single_node_counters()
+{
+    int node_id;
+
+    init_path(0);
+    graph_anf_init(&anf, INIT_SIZE, LOG2M, counters_a, counters_b, 0, 1);
+
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.01, 1.0, graph_anf_estimate(&anf, node_id));
+    }
+}
+
+void test_directed_path_neighborhood()
+{
+    double neighborhood[INIT_SIZE + 5];
+    double exact;
+    int last;
+    int dist;
+    int node_id;
+
+    init_path(0);
+    graph_anf_init(&anf, INIT_SIZE, LOG2M, counters_a, counters_b, 0, 1);
+    last = graph_anf_run(&anf, &csr, neighborhood, INIT_SIZE + 4, 0);
+
+    /* The path is 9 steps long, so the balls stop growing after 9 passes. */
+    TEST_ASSERT_EQUAL(INIT_SIZE - 1, last);
+    for (dist = 0; dist <= last; dist++)
+    {
+        exact = 0.0;
+        for (node_id = 0; node_id < INIT_SIZE; node_id++)
+        {
+            exact += 1 + (dist < INIT_SIZE - 1 - node_id ?
+                          dist : INIT_SIZE - 1 - node_id);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.1 * exact, exact, neighborhood[dist]);
+    }
+}
+
+void test_harmonic_centrality()
+{
+    double neighborhood[INIT_SIZE + 5];
+    double harmonic[INIT_SIZE];
+    double exact;
+    int dist;
+
+    init_path(1);
+    graph_anf_init(&anf, INIT_SIZE, LOG2M, counters_a, counters_b,
+                   last_estimate, 3);
+    graph_anf_run(&anf, &csr, neighborhood, INIT_SIZE + 4, harmonic);
+
+    /* An end of the path sees one node at every distance. */
+    exact = 0.0;
+    for (dist = 1; dist < INIT_SIZE; dist++)
+    {
+        exact += 1.0 / dist;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.15 * exact, exact, harmonic[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.15 * exact, exact, harmonic[INIT_SIZE - 1]);
+    /* The middle sees two nodes at most distances. */
+    TEST_ASSERT_TRUE(harmonic[INIT_SIZE / 2] > harmonic[0]);
+}
+
+void test_effective_diameter()
+{
+    double neighborhood[4] = { 10.0, 30.0, 80.0, 100.0 };
+
+    /* 90 pairs lie between distance 2 (80) and 3 (100). */
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 2.5,
+        graph_anf_effective_diameter(neighborhood, 3, 0.9));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0,
+        graph_anf_effective_diameter(neighborhood, 3, 0.1));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0,
+        graph_anf_effective_diameter(neighborhood, 3, 0.3));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  compare the broadword max against a byte-by-byte max  */
+    RUN_TEST(test_broadword_max);
+    /*  verify fresh counters each estimate one node  */
+    RUN_TEST(test_single_node_counters);
+    /*  run on a directed path, verify the neighborhood function  */
+    RUN_TEST(test_directed_path_neighborhood);
+    /*  run on an undirected path, verify harmonic centrality  */
+    RUN_TEST(test_harmonic_centrality);
+    /*  interpolate the effective diameter of a known function  */
+    RUN_TEST(test_effective_diameter);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build the path 0 -> 1 -> ... -> 9 and snapshot it.
+ *
+ * @undirected: Nonzero to snapshot it as an undirected path.
+ */
+static void init_path(int undirected)
+{
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (idx = 0; idx + 1 < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, idx + 1);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, undirected);
+}
@@ -0,0 +1,640 @@
+/*
+ * A benchmark suite for the graph headers, in the style of the GAP Benchmark
+ * Suite (Beamer, Asanovic and Patterson, 2015).
+ *
+ * Generates an R-MAT graph of 2^scale nodes and degree * 2^scale edges, then
+ * times each phase:
+ *   - build: adding every edge to a Graph.
+ *   - csr: snapshotting the Graph with graph_csr.h.
+ *   - bfs, sssp, pr, cc, tc: breadth-first search, Dijkstra shortest paths,
+ *     20 PageRank iterations, connected components and triangle counting
+ *     over the snapshot.
+ *   - add_edge, has_edge, del_edge: the raw graph.h operations.
+ *   - has_edges: the same lookups as has_edge, as one batch.
+ * Results are printed as one JSON object with per-phase seconds, edges (or
+ * operations) per second and a result to check runs against each other, plus
+ * the built graph's 'graph_stats'.
+ *
+ * Usage: graph_bench [scale] [degree] [seed]
+ *
+ * Times are wall time from clock_gettime(CLOCK_MONOTONIC) where available,
+ * and processor time from clock() elsewhere. Peak memory is read with
+ * getrusage where available and reported as -1 elsewhere.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#if defined(__unix__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#include "graph.h"
+#include "graph_csr.h"
+#include "graph_generators.h"
+
+#define MAX_PHASES 16
+#define PR_ITERS 20
+#define PR_DAMPING 0.85
+
+/*  whether phases are timed by the monotonic wall clock  */
+#if (defined(__unix__) || defined(__APPLE__)) && defined(CLOCK_MONOTONIC)
+#define BENCH_MONOTONIC
+#endif
+
+/*
+ * The measurements of one phase.
+ *
+ * @name: Name of the phase.
+ * @seconds: Time taken.
+ * @work: Edges or operations processed.
+ * @result: Value to check the phase's output by.
+ */
+typedef struct PhaseTag
+{
+    const char *name;
+    double seconds;
+    double work;
+    double result;
+} Phase;
+
+static Phase phases[MAX_PHASES];
+static int num_phases;
+static double phase_start;
+
+double bench_seconds(void);
+void phase_begin(void);
+void phase_end(const char *name, double work, double result);
+long peak_memory_kb(void);
+double bench_bfs(const CsrGraph *csr, int source, int *dist, int *queue);
+double bench_sssp(const CsrGraph *csr, int source, double *dist, int *heap,
+                  double *heap_keys);
+double bench_pagerank(const CsrGraph *csr, double *rank, double *next);
+double bench_cc(const CsrGraph *csr, int *parent);
+double bench_tc(const CsrGraph *csr);
+
+int main(int argc, char **argv)
+{
+    int scale;
+    int degree;
+    unsigned long seed;
+    int num_nodes;
+    long num_edges;
+    long edge;
+    long num_buckets;
+    int source;
+    int idx;
+    int *from;
+    int *to;
+    int *offsets;
+    int *adj;
+    int *sym_offsets;
+    int *sym_adj;
+    int *node_ints;
+    int *heap;
+    int *targets;
+    double *weights;
+    double *node_doubles;
+    double *heap_keys;
+    unsigned char *found;
+    Bucket *pool;
+    Node *nodes;
+    Graph graph;
+    GraphStats stats;
+    CsrGraph csr;
+    CsrGraph sym;
+    double result;
+
+    scale = (argc > 1 ? atoi(argv[1]) : 16);
+    degree = (argc > 2 ? atoi(argv[2]) : 16);
+    seed = (argc > 3 ? strtoul(argv[3], 0, 10) : 1UL);
+    num_nodes = 1 << scale;
+    num_edges = (long)num_nodes * degree;
+    num_buckets = num_edges / BUCKET_SIZE + num_nodes;
+
+    from = malloc(num_edges * sizeof(int));
+    to = malloc(num_edges * sizeof(int));
+    nodes = malloc(num_nodes * sizeof(Node));
+    pool = malloc(num_buckets * sizeof(Bucket));
+    offsets = malloc((num_nodes + 1) * sizeof(int));
+    adj = malloc(num_edges * sizeof(int));
+    sym_offsets = malloc((num_nodes + 1) * sizeof(int));
+    sym_adj = malloc(2 * num_edges * sizeof(int));
+    node_ints = malloc(2 * (long)num_nodes * sizeof(int));
+    node_doubles = malloc(2 * (long)num_nodes * sizeof(double));
+    weights = malloc(num_edges * sizeof(double));
+    heap = malloc((num_edges + 1) * sizeof(int));
+    heap_keys = malloc((num_edges + 1) * sizeof(double));
+    targets = malloc(num_edges * sizeof(int));
+    found = malloc((num_edges + 7) / 8);
+    if (from == 0 || to == 0 || nodes == 0 || pool == 0 || offsets == 0 ||
+        adj == 0 || sym_offsets == 0 || sym_adj == 0 || node_ints == 0 ||
+        node_doubles == 0 || weights == 0 || heap == 0 || heap_keys == 0 ||
+        targets == 0 || found == 0)
+    {
+        fprintf(stderr, "graph_bench: out of memory\n");
+        return 1;
+    }
+
+    phase_begin();
+    graph_gen_rmat(scale, 0.57, 0.19, 0.19, seed, from, to, 0, num_edges);
+    phase_end("generate", (double)num_edges, 0.0);
+
+    phase_begin();
+    graph_init(&graph, nodes, num_nodes);
+    result = (double)graph_gen_fill(&graph, from, to, num_edges, pool,
+                                    (int)num_buckets);
+    phase_end("build", (double)num_edges, result);
+    graph_stats(&graph, &stats, 0, 0);
+
+    phase_begin();
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+    graph_csr_build(&graph, &sym, sym_offsets, sym_adj, 1);
+    phase_end("csr", (double)num_edges, (double)csr.num_entries);
+
+    /*  integer weights in [1, 255], as in GAP  */
+    csr.weights = weights;
+    for (edge = 0; edge < csr.num_entries; edge++)
+    {
+        weights[edge] = (double)(graph_rng_hash(seed, (unsigned long)edge) %
+                                 255 + 1);
+    }
+
+    /*  search from the node with the most edges  */
+    source = 0;
+    for (idx = 1; idx < num_nodes; idx++)
+    {
+        if (graph_csr_degree(&csr, idx) > graph_csr_degree(&csr, source))
+        {
+            source = idx;
+        }
+    }
+
+    phase_begin();
+    result = bench_bfs(&csr, source, node_ints, node_ints + num_nodes);
+    phase_end("bfs", (double)csr.num_entries, result);
+
+    phase_begin();
+    result = bench_sssp(&csr, source, node_doubles, heap, heap_keys);
+    phase_end("sssp", (double)csr.num_entries, result);
+
+    phase_begin();
+    result = bench_pagerank(&csr, node_doubles, node_doubles + num_nodes);
+    phase_end("pr", (double)csr.num_entries * PR_ITERS, result);
+
+    phase_begin();
+    result = bench_cc(&sym, node_ints);
+    phase_end("cc", (double)sym.num_entries, result);
+
+    phase_begin();
+    result = bench_tc(&sym);
+    phase_end("tc", (double)sym.num_entries, result);
+
+    /*  raw operations on a fresh graph, with every bucket provisioned  */
+    graph_init(&graph, nodes, num_nodes);
+    for (idx = 0; idx < num_nodes; idx++)
+    {
+        node_ints[idx] = 0;
+    }
+    for (edge = 0; edge < num_edges; edge++)
+    {
+        node_ints[from[edge]]++;
+    }
+    num_buckets = 0;
+    for (idx = 0; idx < num_nodes; idx++)
+    {
+        for (; node_ints[idx] > 0; node_ints[idx] -= BUCKET_SIZE)
+        {
+            graph_add_bucket(&graph, idx, &pool[num_buckets++]);
+        }
+    }
+
+    phase_begin();
+    result = 0.0;
+    for (edge = 0; edge < num_edges; edge++)
+    {
+        result += (graph_add_edge(&graph, from[edge], to[edge]) == 0);
+    }
+    phase_end("add_edge", (double)num_edges, result);
+
+    /*  half of the queries hit, half are random pairs  */
+    for (edge = 0; edge < num_edges; edge++)
+    {
+        targets[edge] = (edge % 2 == 0 ? to[edge] :
+                         (int)(graph_rng_hash(seed, edge) % num_nodes));
+    }
+    phase_begin();
+    result = 0.0;
+    for (edge = 0; edge < num_edges; edge++)
+    {
+        result += (graph_has_edge(&graph, from[edge], targets[edge]) == 0);
+    }
+    phase_end("has_edge", (double)num_edges, result);
+
+    phase_begin();
+    result = (double)graph_has_edges(&graph, from, targets, num_edges,
+                                      found);
+    phase_end("has_edges", (double)num_edges, result);
+
+    phase_begin();
+    for (edge = 0; edge < num_edges; edge++)
+    {
+        graph_del_edge(&graph, from[edge], to[edge]);
+    }
+    phase_end("del_edge", (double)num_edges, 0.0);
+
+    printf("{\n  \"scale\": %d,\n  \"degree\": %d,\n  \"seed\": %lu,\n",
+           scale, degree, seed);
+    printf("  \"nodes\": %d,\n  \"edges\": %ld,\n", num_nodes, num_edges);
+    printf("  \"peak_memory_kb\": %ld,\n", peak_memory_kb());
+    printf("  \"graph\": {\"bytes\": %ld, \"buckets\": %d, "
+           "\"max_degree\": %d, \"max_chain\": %d, \"avg_chain\": %.3f, "
+           "\"fill_ratio\": %.3f},\n", stats.bytes, stats.num_buckets,
+           stats.max_degree, stats.max_chain, stats.avg_chain,
+           stats.fill_ratio);
+    printf("  \"phases\": [\n");
+    for (idx = 0; idx < num_phases; idx++)
+    {
+        printf("    {\"name\": \"%s\", \"seconds\": %.6f, "
+               "\"edges_per_second\": %.0f, \"result\": %.10g}%s\n",
+               phases[idx].name, phases[idx].seconds,
+               phases[idx].seconds > 0 ?
+                   phases[idx].work / phases[idx].seconds : 0.0,
+               phases[idx].result, idx + 1 < num_phases ? "," : "");
+    }
+    printf("  ]\n}\n");
+
+    free(from);
+    free(to);
+    free(nodes);
+    free(pool);
+    free(offsets);
+    free(adj);
+    free(sym_offsets);
+    free(sym_adj);
+    free(node_ints);
+    free(node_doubles);
+    free(weights);
+    free(heap);
+    free(heap_keys);
+    free(targets);
+    free(found);
+    return 0;
+}
+
+/*
+ * Read the clock phases are timed by.
+ *
+ * @return: The time in seconds, from an arbitrary start.
+ */
+double bench_seconds(void)
+{
+#ifdef BENCH_MONOTONIC
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/*
+ * Start timing a phase.
+ */
+void phase_begin(void)
+{
+    phase_start = bench_seconds();
+}
+
+/*
+ * Finish timing a phase and record it.
+ *
+ * @name: Name of the phase.
+ * @work: Edges or operations processed.
+ * @result: Value to check the phase's output by.
+ */
+void phase_end(const char *name, double work, double result)
+{
+    phases[num_phases].name = name;
+    phases[num_phases].seconds = bench_seconds() - phase_start;
+    phases[num_phases].work = work;
+    phases[num_phases].result = result;
+    num_phases++;
+}
+
+/*
+ * Get the most memory the process has held, in kilobytes, or -1 if unknown.
+ */
+long peak_memory_kb(void)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+#if defined(__APPLE__)
+    return (long)(usage.ru_maxrss / 1024);
+#else
+    return (long)usage.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+/*
+ * Breadth-first search.
+ *
+ * @dist: Array of num_nodes ints, receives each node's distance or -1.
+ * @queue: Array of num_nodes ints.
+ * @return: The number of nodes reached.
+ */
+double bench_bfs(const CsrGraph *csr, int source, int *dist, int *queue)
+{
+    int head;
+    int tail;
+    int node_id;
+    int entry;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        dist[node_id] = -1;
+    }
+    dist[source] = 0;
+    queue[0] = source;
+    tail = 1;
+    for (head = 0; head < tail; head++)
+    {
+        node_id = queue[head];
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (dist[csr->adj[entry]] == -1)
+            {
+                dist[csr->adj[entry]] = dist[node_id] + 1;
+                queue[tail++] = csr->adj[entry];
+            }
+        }
+    }
+    return (double)tail;
+}
+
+/*
+ * Dijkstra's algorithm with a binary heap of (distance, node) pairs. Stale
+ * pairs are skipped when popped instead of being updated in place.
+ *
+ * @dist: Array of num_nodes doubles, receives each node's distance or -1.
+ * @heap: Array of num_entries + 1 ints.
+ * @heap_keys: Array of num_entries + 1 doubles.
+ * @return: The sum of the distances of the nodes reached.
+ */
+double bench_sssp(const CsrGraph *csr, int source, double *dist, int *heap,
+                  double *heap_keys)
+{
+    int size;
+    int node_id;
+    int entry;
+    int pos;
+    int child;
+    int moving;
+    double key;
+    double moving_key;
+    double total;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        dist[node_id] = -1.0;
+    }
+    dist[source] = 0.0;
+    heap[0] = source;
+    heap_keys[0] = 0.0;
+    size = 1;
+    total = 0.0;
+
+    while (size > 0)
+    {
+        node_id = heap[0];
+        key = heap_keys[0];
+
+        /*  pop: sift the last pair down from the root  */
+        size--;
+        moving = heap[size];
+        moving_key = heap_keys[size];
+        pos = 0;
+        while ((child = 2 * pos + 1) < size)
+        {
+            if (child + 1 < size && heap_keys[child + 1] < heap_keys[child])
+            {
+                child++;
+            }
+            if (heap_keys[child] >= moving_key)
+            {
+                break;
+            }
+            heap[pos] = heap[child];
+            heap_keys[pos] = heap_keys[child];
+            pos = child;
+        }
+        heap[pos] = moving;
+        heap_keys[pos] = moving_key;
+
+        if (key > dist[node_id])
+        {
+            continue;
+        }
+        total += key;
+
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            moving = csr->adj[entry];
+            moving_key = key + graph_csr_weight(csr, entry);
+            if (dist[moving] >= 0.0 && dist[moving] <= moving_key)
+            {
+                continue;
+            }
+            dist[moving] = moving_key;
+
+            /*  push: sift the new pair up  */
+            pos = size++;
+            while (pos > 0 && heap_keys[(pos - 1) / 2] > moving_key)
+            {
+                heap[pos] = heap[(pos - 1) / 2];
+                heap_keys[pos] = heap_keys[(pos - 1) / 2];
+                pos = (pos - 1) / 2;
+            }
+            heap[pos] = moving;
+            heap_keys[pos] = moving_key;
+        }
+    }
+    return total;
+}
+
+/*
+ * PageRank by push-style power iteration, PR_ITERS iterations.
+ *
+ * @rank: Array of num_nodes doubles, receives the ranks.
+ * @next: Array of num_nodes doubles.
+ * @return: The rank of node 0.
+ */
+double bench_pagerank(const CsrGraph *csr, double *rank, double *next)
+{
+    int iter;
+    int node_id;
+    int entry;
+    int degree;
+    double share;
+    double dangling;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        rank[node_id] = 1.0 / csr->num_nodes;
+    }
+    for (iter = 0; iter < PR_ITERS; iter++)
+    {
+        dangling = 0.0;
+        for (node_id = 0; node_id < csr->num_nodes; node_id++)
+        {
+            next[node_id] = 0.0;
+        }
+        for (node_id = 0; node_id < csr->num_nodes; node_id++)
+        {
+            degree = graph_csr_degree(csr, node_id);
+            if (degree == 0)
+            {
+                dangling += rank[node_id];
+                continue;
+            }
+            share = rank[node_id] / degree;
+            for (entry = csr->offsets[node_id];
+                 entry < csr->offsets[node_id + 1]; entry++)
+            {
+                next[csr->adj[entry]] += share;
+            }
+        }
+        for (node_id = 0; node_id < csr->num_nodes; node_id++)
+        {
+            rank[node_id] = (1.0 - PR_DAMPING + PR_DAMPING * dangling) /
+                            csr->num_nodes + PR_DAMPING * next[node_id];
+        }
+    }
+    return rank[0];
+}
+
+/*
+ * Connected components by union-find with path halving.
+ *
+ * @parent: Array of num_nodes ints.
+ * @return: The number of components.
+ */
+double bench_cc(const CsrGraph *csr, int *parent)
+{
+    int node_id;
+    int entry;
+    int root_from;
+    int root_to;
+    int count;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        parent[node_id] = node_id;
+    }
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            root_from = node_id;
+            while (parent[root_from] != root_from)
+            {
+                parent[root_from] = parent[parent[root_from]];
+                root_from = parent[root_from];
+            }
+            root_to = csr->adj[entry];
+            while (parent[root_to] != root_to)
+            {
+                parent[root_to] = parent[parent[root_to]];
+                root_to = parent[root_to];
+            }
+            if (root_from < root_to)
+            {
+                parent[root_to] = root_from;
+            }
+            else if (root_to < root_from)
+            {
+                parent[root_from] = root_to;
+            }
+        }
+    }
+
+    count = 0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        count += (parent[node_id] == node_id);
+    }
+    return (double)count;
+}
+
+/*
+ * Count triangles by merging the sorted rows of each edge's endpoints,
+ * counting each triangle u < v < w once.
+ *
+ * @csr: Undirected snapshot.
+ * @return: The number of triangles.
+ */
+double bench_tc(const CsrGraph *csr)
+{
+    int node_id;
+    int entry;
+    int other;
+    int left;
+    int right;
+    int left_end;
+    int right_end;
+    double count;
+
+    count = 0.0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            other = csr->adj[entry];
+            if (other <= node_id)
+            {
+                continue;
+            }
+            left = entry + 1;
+            left_end = csr->offsets[node_id + 1];
+            right = csr->offsets[other];
+            right_end = csr->offsets[other + 1];
+            while (left < left_end && right < right_end)
+            {
+                if (csr->adj[left] < csr->adj[right])
+                {
+                    left++;
+                }
+                else if (csr->adj[right] < csr->adj[left])
+                {
+                    right++;
+                }
+                else
+                {
+                    count += (csr->adj[left] > other);
+                    left++;
+                    right++;
+                }
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,315 @@
+/*
+ * Articulation points, bridges and biconnected components of an undirected
+ * graph.
+ * See https://en.wikipedia.org/wiki/Biconnected_component for the theory.
+ *
+ * An articulation point is a node whose removal disconnects its component, a
+ * bridge is such an edge, and a biconnected component is a maximal set of
+ * edges in which any two edges lie on a common simple cycle. All three fall
+ * out of a single depth-first search (Hopcroft and Tarjan, 1973) that records
+ * when each node was discovered and the earliest discovered node its subtree
+ * can reach with one back edge (its "low" value). A child whose low value
+ * doesn't reach above its parent cuts the parent off.
+ *
+ * The search runs directly over the bucket chains of graph.h, in O(n + m). It
+ * keeps its own stack of (node, bucket, slot) frames instead of recursing, so
+ * long paths can't overflow the call stack.
+ *
+ * === How to Use ===
+ * The graph must be stored undirected: every edge added in both directions,
+ * as described in graph.h. Adding an edge twice makes a pair of parallel
+ * edges, which is never a bridge.
+ *
+ * This header does no memory management. Let n be the graph's size and m the
+ * number of undirected edges (half the stored edges). Allocate
+ * BICONNECTED_INT_WORDS(n, m) ints, n Bucket pointers and
+ * BICONNECTED_CHAR_WORDS(n) chars, and pass them to 'graph_biconnected_init'.
+ * Then call 'graph_biconnected' after every topology change and read the
+ * results out of the workspace:
+ *   - @articulation[u] is 1 if node u is an articulation point.
+ *   - @bridges holds @num_bridges (from, to) pairs.
+ *   - @edges holds @num_edges (from, to) pairs, one per undirected edge, and
+ *     @edge_labels the biconnected component of each, numbered from 0.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_BICONNECTED_H
+#define GRAPH_BICONNECTED_H
+
+#include "graph.h"
+
+typedef struct BiconnectedTag Biconnected;
+
+/*  workspace size for a graph of n nodes and m undirected edges  */
+#define BICONNECTED_INT_WORDS(n, m) (4 * (n) + 7 * (m))
+#define BICONNECTED_CHAR_WORDS(n) (2 * (n))
+
+static int graph_biconnected_next(Biconnected *bc, int top);
+static void graph_biconnected_finish(Biconnected *bc, int child, int parent);
+
+/*
+ * Workspace and results of a biconnected component search.
+ *
+ * @size: Number of nodes.
+ * @edge_capacity: The most undirected edges the graph may have.
+ * @disc: Discovery time of each node, -1 if not yet discovered.
+ * @low: Earliest discovery time reachable from each node's subtree.
+ * @frame_node: Node of each search stack frame.
+ * @frame_bucket: Bucket each frame is scanning.
+ * @frame_slot: Next slot each frame will read in its bucket.
+ * @skipped_parent: Whether each node has skipped its tree edge back to its
+ *   parent yet. Only one copy is skipped, so parallel edges form cycles.
+ * @edge_stack: Edges of the components still being built, as pairs.
+ * @edge_top: Number of pairs on @edge_stack.
+ * @articulation: Result flag per node.
+ * @bridges: Result bridges, as (from, to) pairs.
+ * @num_bridges: Number of pairs in @bridges.
+ * @edges: Every undirected edge, as (from, to) pairs.
+ * @edge_labels: Biconnected component of each pair of @edges.
+ * @num_edges: Number of pairs in @edges.
+ * @num_components: Number of biconnected components.
+ */
+struct BiconnectedTag
+{
+    int size;
+    int edge_capacity;
+    int *disc;
+    int *low;
+    int *frame_node;
+    Bucket **frame_bucket;
+    int *frame_slot;
+    char *skipped_parent;
+    int *edge_stack;
+    int edge_top;
+    char *articulation;
+    int *bridges;
+    int num_bridges;
+    int *edges;
+    int *edge_labels;
+    int num_edges;
+    int num_components;
+};
+
+/*
+ * Initialize a biconnected component workspace.
+ *
+ * @size: Number of nodes of the graphs to search.
+ * @edge_capacity: The most undirected edges the graphs may have.
+ * @int_buf: Array of BICONNECTED_INT_WORDS(@size, @edge_capacity) ints.
+ * @bucket_buf: Array of @size Bucket pointers.
+ * @char_buf: Array of BICONNECTED_CHAR_WORDS(@size) chars.
+ */
+static void graph_biconnected_init(Biconnected *bc, int size,
+                                   int edge_capacity, int *int_buf,
+                                   Bucket **bucket_buf, char *char_buf)
+{
+    bc->size = size;
+    bc->edge_capacity = edge_capacity;
+    bc->disc = int_buf;
+    bc->low = int_buf + size;
+    bc->frame_node = int_buf + 2 * size;
+    bc->frame_slot = int_buf + 3 * size;
+    bc->edge_stack = int_buf + 4 * size;
+    bc->bridges = bc->edge_stack + 2 * edge_capacity;
+    bc->edges = bc->bridges + 2 * edge_capacity;
+    bc->edge_labels = bc->edges + 2 * edge_capacity;
+    bc->frame_bucket = bucket_buf;
+    bc->skipped_parent = char_buf;
+    bc->articulation = char_buf + size;
+    bc->edge_top = 0;
+    bc->num_bridges = 0;
+    bc->num_edges = 0;
+    bc->num_components = 0;
+}
+
+/*
+ * Find the articulation points, bridges and biconnected components of a graph.
+ *
+ * @graph: Undirected graph, every edge stored in both directions.
+ * @bc: Workspace initialized for the graph's size and edge count.
+ * @return: The number of biconnected components. Isolated nodes belong to
+ *   none.
+ */
+static int graph_biconnected(Graph *graph, Biconnected *bc)
+{
+    int root;
+    int top;
+    int node_id;
+    int to_id;
+    int time;
+    int root_children;
+
+    for (node_id = 0; node_id < bc->size; node_id++)
+    {
+        bc->disc[node_id] = -1;
+        bc->skipped_parent[node_id] = 0;
+        bc->articulation[node_id] = 0;
+    }
+    bc->edge_top = 0;
+    bc->num_bridges = 0;
+    bc->num_edges = 0;
+    bc->num_components = 0;
+
+    time = 0;
+    for (root = 0; root < bc->size; root++)
+    {
+        if (bc->disc[root] != -1)
+        {
+            continue;
+        }
+
+        top = 0;
+        bc->frame_node[0] = root;
+        bc->frame_bucket[0] = graph->nodes[root].edges_out;
+        bc->frame_slot[0] = 0;
+        bc->disc[root] = time;
+        bc->low[root] = time;
+        time++;
+        root_children = 0;
+
+        while (top >= 0)
+        {
+            node_id = bc->frame_node[top];
+            to_id = graph_biconnected_next(bc, top);
+
+            if (to_id == -1)
+            {
+                /*  node finished, report it to its parent  */
+                top--;
+                if (top >= 0)
+                {
+                    graph_biconnected_finish(bc, node_id,
+                                             bc->frame_node[top]);
+                }
+                continue;
+            }
+
+            if (top > 0 && to_id == bc->frame_node[top - 1] &&
+                !bc->skipped_parent[node_id])
+            {
+                /*  the tree edge we came in on, seen from below  */
+                bc->skipped_parent[node_id] = 1;
+            }
+            else if (bc->disc[to_id] == -1)
+            {
+                /*  tree edge, descend  */
+                bc->edge_stack[2 * bc->edge_top] = node_id;
+                bc->edge_stack[2 * bc->edge_top + 1] = to_id;
+                bc->edge_top++;
+                top++;
+                bc->frame_node[top] = to_id;
+                bc->frame_bucket[top] = graph->nodes[to_id].edges_out;
+                bc->frame_slot[top] = 0;
+                bc->disc[to_id] = time;
+                bc->low[to_id] = time;
+                time++;
+                if (top == 1)
+                {
+                    root_children++;
+                }
+            }
+            else if (bc->disc[to_id] < bc->disc[node_id])
+            {
+                /*  back edge to an ancestor  */
+                bc->edge_stack[2 * bc->edge_top] = node_id;
+                bc->edge_stack[2 * bc->edge_top + 1] = to_id;
+                bc->edge_top++;
+                if (bc->disc[to_id] < bc->low[node_id])
+                {
+                    bc->low[node_id] = bc->disc[to_id];
+                }
+            }
+            /*  otherwise a self loop or the far end of a handled back edge  */
+        }
+
+        /*  the root is only a cut node if it has several subtrees  */
+        bc->articulation[root] = (root_children > 1);
+    }
+
+    return bc->num_components;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Read the next edge of a search stack frame.
+ *
+ * @top: Index of the frame.
+ * @return: Id of the next neighbor, or -1 if the frame has no edges left.
+ */
+static int graph_biconnected_next(Biconnected *bc, int top)
+{
+    Bucket *cursor;
+    int slot;
+    unsigned int bits;
+
+    cursor = bc->frame_bucket[top];
+    slot = bc->frame_slot[top];
+    while (cursor != 0)
+    {
+        /*  the live slots at or after @slot  */
+        bits = (slot < BUCKET_SIZE ? cursor->used >> slot << slot : 0);
+        if (bits != 0)
+        {
+            slot = GRAPH_CTZ(bits);
+            bc->frame_bucket[top] = cursor;
+            bc->frame_slot[top] = slot + 1;
+            return cursor->adj_nodes[slot]->id;
+        }
+        cursor = cursor->next;
+        slot = 0;
+    }
+
+    bc->frame_bucket[top] = 0;
+    return -1;
+}
+
+/*
+ * Fold a finished child's subtree into its parent.
+ * If the subtree can't reach above the parent, the parent separates it and
+ * the edges pushed since the tree edge form one biconnected component.
+ *
+ * @child: The node whose search just finished.
+ * @parent: Its parent in the search tree.
+ */
+static void graph_biconnected_finish(Biconnected *bc, int child, int parent)
+{
+    int from;
+    int to;
+
+    if (bc->low[child] < bc->low[parent])
+    {
+        bc->low[parent] = bc->low[child];
+    }
+    if (bc->low[child] < bc->disc[parent])
+    {
+        return;
+    }
+
+    /*  non-root parents are cut nodes, the root is settled by its caller  */
+    bc->articulation[parent] = 1;
+    if (bc->low[child] > bc->disc[parent])
+    {
+        bc->bridges[2 * bc->num_bridges] = parent;
+        bc->bridges[2 * bc->num_bridges + 1] = child;
+        bc->num_bridges++;
+    }
+
+    do
+    {
+        bc->edge_top--;
+        from = bc->edge_stack[2 * bc->edge_top];
+        to = bc->edge_stack[2 * bc->edge_top + 1];
+        bc->edges[2 * bc->num_edges] = from;
+        bc->edges[2 * bc->num_edges + 1] = to;
+        bc->edge_labels[bc->num_edges] = bc->num_components;
+        bc->num_edges++;
+    } while (from != parent || to != child);
+    bc->num_components++;
+}
+
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Unit tests for the biconnected component header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_biconnected.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 2000
+#define MAX_EDGES 4000
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static Biconnected bc;
+static int int_buf[BICONNECTED_INT_WORDS(INIT_SIZE, MAX_EDGES)];
+static Bucket *bucket_buf[INIT_SIZE];
+static char char_buf[BICONNECTED_CHAR_WORDS(INIT_SIZE)];
+
+static void init_graph(void);
+static void add_undirected(int from, int to);
+static int label_of(int from, int to);
+
+
+void test_path()
+{
+    int idx;
+
+    init_graph();
+    for (idx = 0; idx + 1 < 6; idx++)
+    {
+        add_undirected(idx, idx + 1);
+    }
+
+    TEST_ASSERT_EQUAL(5, graph_biconnected(&graph, &bc));
+    TEST_ASSERT_EQUAL(5, bc.num_bridges);
+    TEST_ASSERT_EQUAL(5, bc.num_edges);
+    TEST_ASSERT_FALSE(bc.articulation[0]);
+    TEST_ASSERT_FALSE(bc.articulation[5]);
+    for (idx = 1; idx < 5; idx++)
+    {
+        TEST_ASSERT_TRUE(bc.articulation[idx]);
+    }
+}
+
+void test_cycle()
+{
+    int idx;
+
+    init_graph();
+    for (idx = 0; idx < 6; idx++)
+    {
+        add_undirected(idx, (idx + 1) % 6);
+    }
+
+    TEST_ASSERT_EQUAL(1, graph_biconnected(&graph, &bc));
+    TEST_ASSERT_EQUAL(0, bc.num_bridges);
+    TEST_ASSERT_EQUAL(6, bc.num_edges);
+    for (idx = 0; idx < 6; idx++)
+    {
+        TEST_ASSERT_FALSE(bc.articulation[idx]);
+    }
+}
+
+void test_bowtie_with_tail()
+{
+    int idx;
+
+    /* Triangles 0-1-2 and 2-3-4 share node 2; the edge 4-5 hangs off. */
+    init_graph();
+    add_undirected(0, 1);
+    add_undirected(1, 2);
+    add_undirected(2, 0);
+    add_undirected(2, 3);
+    add_undirected(3, 4);
+    add_undirected(4, 2);
+    add_undirected(4, 5);
+
+    TEST_ASSERT_EQUAL(3, graph_biconnected(&graph, &bc));
+    TEST_ASSERT_EQUAL(7, bc.num_edges);
+    TEST_ASSERT_EQUAL(1, bc.num_bridges);
+    TEST_ASSERT_TRUE((bc.bridges[0] == 4 && bc.bridges[1] == 5) ||
+                     (bc.bridges[0] == 5 && bc.bridges[1] == 4));
+    for (idx = 0; idx < 6; idx++)
+    {
+        TEST_ASSERT_EQUAL(idx == 2 || idx == 4, bc.articulation[idx]);
+    }
+
+    TEST_ASSERT_EQUAL(label_of(0, 1), label_of(1, 2));
+    TEST_ASSERT_EQUAL(label_of(0, 1), label_of(2, 0));
+    TEST_ASSERT_EQUAL(label_of(2, 3), label_of(3, 4));
+    TEST_ASSERT_EQUAL(label_of(2, 3), label_of(4, 2));
+    TEST_ASSERT_TRUE(label_of(0, 1) != label_of(2, 3));
+    TEST_ASSERT_TRUE(label_of(4, 5) != label_of(2, 3));
+    TEST_ASSERT_TRUE(label_of(4, 5) != label_of(0, 1));
+}
+
+void test_parallel_edge_is_not_bridge()
+{
+    init_graph();
+    add_undirected(0, 1);
+    add_undirected(0, 1);
+    add_undirected(1, 2);
+
+    TEST_ASSERT_EQUAL(2, graph_biconnected(&graph, &bc));
+    TEST_ASSERT_EQUAL(1, bc.num_bridges);
+    TEST_ASSERT_EQUAL(1, bc.bridges[0]);
+    TEST_ASSERT_EQUAL(2, bc.bridges[1]);
+    TEST_ASSERT_TRUE(bc.articulation[1]);
+}
+
+void test_long_path_is_not_recursive()
+{
+    int idx;
+
+    init_graph();
+    for (idx = 0; idx + 1 < INIT_SIZE; idx++)
+    {
+        add_undirected(idx, idx + 1);
+    }
+    /* Closing the path into a cycle removes every cut. */
+    TEST_ASSERT_EQUAL(INIT_SIZE - 1, graph_biconnected(&graph, &bc));
+    add_undirected(INIT_SIZE - 1, 0);
+    TEST_ASSERT_EQUAL(1, graph_biconnected(&graph, &bc));
+    TEST_ASSERT_EQUAL(0, bc.num_bridges);
+    TEST_ASSERT_EQUAL(INIT_SIZE, bc.num_edges);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  search a path, verify every edge is a bridge  */
+    RUN_TEST(test_path);
+    /*  search a cycle, verify it is one component  */
+    RUN_TEST(test_cycle);
+    /*  search two triangles and a tail, verify cuts and labels  */
+    RUN_TEST(test_bowtie_with_tail);
+    /*  double an edge, verify it stops being a bridge  */
+    RUN_TEST(test_parallel_edge_is_not_bridge);
+    /*  search a path deeper than a recursive search could go  */
+    RUN_TEST(test_long_path_is_not_recursive);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize an empty graph and the workspace.
+ */
+static void init_graph(void)
+{
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    graph_biconnected_init(&bc, INIT_SIZE, MAX_EDGES, int_buf, bucket_buf,
+                           char_buf);
+}
+
+/*
+ * Add an undirected edge as a pair of directed ones.
+ */
+static void add_undirected(int from, int to)
+{
+    graph_add_edge(&graph, from, to);
+    graph_add_edge(&graph, to, from);
+}
+
+/*
+ * Look up the component label of an undirected edge, -1 if not found.
+ */
+static int label_of(int from, int to)
+{
+    int idx;
+
+    for (idx = 0; idx < bc.num_edges; idx++)
+    {
+        if ((bc.edges[2 * idx] == from && bc.edges[2 * idx + 1] == to) ||
+            (bc.edges[2 * idx] == to && bc.edges[2 * idx + 1] == from))
+        {
+            return bc.edge_labels[idx];
+        }
+    }
+    return -1;
+}
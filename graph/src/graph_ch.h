@@ -0,0 +1,915 @@
+/*
+ * Contraction hierarchies: shortest path distances on road networks in
+ * microseconds, after a one-time preprocessing pass.
+ * See Geisberger, Sanders, Schultes and Delling, "Contraction Hierarchies:
+ * Faster and Simpler Hierarchical Routing in Road Networks" (2008) for the
+ * theory.
+ *
+ * Preprocessing removes, contracts, the nodes one at a time in order of
+ * importance. Contracting a node v must keep every shortest distance between
+ * the nodes left, so for each pair of edges u -> v -> w a shortcut u -> w is
+ * added with their summed weight, unless a witness search finds a path from u
+ * to w no longer than that without v. The next node contracted is the one
+ * with the lowest edge difference: shortcuts it needs, less the edges it
+ * removes, plus how many of its neighbors are contracted already so that
+ * contraction spreads evenly. Priorities are updated lazily: rather than
+ * recomputing every neighbor of each contracted node, the cheapest node is
+ * recomputed before it is contracted, and put back if it grew.
+ *
+ * A node's rank is when it was contracted. The original edges and the
+ * shortcuts then form a hierarchy in which every shortest path climbs to a
+ * node of highest rank and comes back down. A query runs Dijkstra's algorithm
+ * forward from the source and backward from the target, each only along
+ * edges to higher ranked nodes, and the two meet at the top. Each search
+ * reaches a few hundred nodes on a road network of millions, where a plain
+ * search reaches most of the network.
+ *
+ * The finished hierarchy is stored like a CSR snapshot, with nodes numbered by
+ * rank and the upward edges forward and backward of each node in adjacent
+ * rows. The top of the hierarchy, which every query reaches, is then one
+ * small block of memory.
+ *
+ * Witness searches give up after CH_WITNESS_LIMIT settled nodes. A search that
+ * gives up may add a shortcut that wasn't needed, never skip one that was, so
+ * a lower limit trades preprocessing time for a larger hierarchy. Define it
+ * before including this header to change it.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. Weights must
+ * not be negative.
+ *   1. Take a weighted snapshot of the graph with graph_csr.h; an unweighted
+ *      one has weights of 1. Pick the most edges the hierarchy may hold,
+ *      original and shortcuts, about 3 times the snapshot's entries for road
+ *      networks. Allocate CH_BUILD_INT_WORDS(n, capacity) ints and
+ *      CH_BUILD_DOUBLE_WORDS(n, capacity) doubles and call
+ *      'graph_ch_build_init'.
+ *   2. Call 'graph_ch_contract'. It returns 1 if the capacity was too small.
+ *   3. Allocate n ints for ranks, 2 * n + 1 ints for offsets, and
+ *      builder->num_edges ints and doubles, and call 'graph_ch_finish'. The
+ *      builder's buffers can then be freed.
+ *   4. Give each querying thread a ChQuery with CH_QUERY_INT_WORDS(n) ints
+ *      and CH_QUERY_DOUBLE_WORDS(n) doubles, initialized with
+ *      'graph_ch_query_init', and call 'graph_ch_distance'.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_CH_H
+#define GRAPH_CH_H
+
+#include <math.h>
+#include "graph_csr.h"
+
+/*  most nodes a witness search settles before it gives up  */
+#ifndef CH_WITNESS_LIMIT
+#define CH_WITNESS_LIMIT 100
+#endif
+
+/*  workspace sizes of a builder for n nodes and up to @capacity edges  */
+#define CH_BUILD_INT_WORDS(n, capacity) (4 * (capacity) + 9 * (n))
+#define CH_BUILD_DOUBLE_WORDS(n, capacity) ((capacity) + 2 * (n))
+
+/*  workspace sizes of a query over n nodes  */
+#define CH_QUERY_INT_WORDS(n) (6 * (n))
+#define CH_QUERY_DOUBLE_WORDS(n) (2 * (n))
+
+typedef struct ChHeapTag ChHeap;
+typedef struct ChBuilderTag ChBuilder;
+typedef struct ChHierarchyTag ChHierarchy;
+typedef struct ChQueryTag ChQuery;
+
+static int graph_ch_contract_node(ChBuilder *builder, int node_id,
+                                  int simulate);
+static double graph_ch_priority(ChBuilder *builder, int node_id);
+static void graph_ch_witness(ChBuilder *builder, int source, int skip_id,
+                             double bound);
+static void graph_ch_reset(ChBuilder *builder);
+static void graph_ch_prune(ChBuilder *builder, int node_id);
+static int graph_ch_add_edge(ChBuilder *builder, int from_id, int to_id,
+                             double weight);
+static int graph_ch_stalled(const ChHierarchy *ch, const double *dist,
+                            int rank, int dir);
+static void graph_ch_heap_init(ChHeap *heap, int size, int *ids, int *pos,
+                               double *keys);
+static void graph_ch_heap_update(ChHeap *heap, int node_id);
+static int graph_ch_heap_pop(ChHeap *heap);
+static void graph_ch_heap_clear(ChHeap *heap);
+static void graph_ch_heap_swap(ChHeap *heap, int left, int right);
+
+/*
+ * A binary min-heap of node ids, keyed by an array indexed by node id.
+ *
+ * @size: Number of ids in the heap.
+ * @ids: The ids, in heap order.
+ * @pos: Index of each node in @ids, -1 if the node isn't in the heap.
+ * @keys: Key of each node.
+ */
+struct ChHeapTag
+{
+    int size;
+    int *ids;
+    int *pos;
+    double *keys;
+};
+
+/*
+ * The state of preprocessing. The edges, original and shortcuts, are kept in
+ * a pool, each linked into the out-list of its start and the in-list of its
+ * end.
+ *
+ * @num_nodes: Number of nodes.
+ * @capacity: The most edges the pool can hold.
+ * @num_edges: Number of edges in the pool.
+ * @num_shortcuts: Number of shortcuts added.
+ * @next_rank: Rank of the next node to contract.
+ * @from, @to, @weight: Ends and weight of each edge.
+ * @next_out, @next_in: Next edge of each edge's out-list and in-list, -1 at
+ *   the end.
+ * @head_out, @head_in: First edge of each node's out-list and in-list.
+ * @rank: Rank of each node, -1 while it isn't contracted.
+ * @contracted: Number of edges to each node from contracted nodes.
+ * @priority: Last computed priority of each node.
+ * @dist: Distance of each node from the source of a witness search.
+ * @touched: Nodes whose distance the last witness search set.
+ * @num_touched: Number of nodes in @touched.
+ * @order: Nodes not yet contracted, keyed by priority.
+ * @search: The heap of witness searches, keyed by distance.
+ */
+struct ChBuilderTag
+{
+    int num_nodes;
+    int capacity;
+    int num_edges;
+    long num_shortcuts;
+    int next_rank;
+    int *from;
+    int *to;
+    double *weight;
+    int *next_out;
+    int *next_in;
+    int *head_out;
+    int *head_in;
+    int *rank;
+    int *contracted;
+    double *priority;
+    double *dist;
+    int *touched;
+    int num_touched;
+    ChHeap order;
+    ChHeap search;
+};
+
+/*
+ * A finished hierarchy. Nodes are numbered by rank. Row 2r holds the edges
+ * from rank r up to higher ranks, row 2r + 1 the edges into rank r from
+ * higher ranks.
+ *
+ * @num_nodes: Number of nodes.
+ * @num_entries: Number of edges, equal to offsets[2 * num_nodes].
+ * @rank: Rank of each node, by original id.
+ * @offsets: Row offsets. Has 2 * num_nodes + 1 entries.
+ * @adj: Rank of each edge's other end.
+ * @weights: Weight of each edge.
+ */
+struct ChHierarchyTag
+{
+    int num_nodes;
+    int num_entries;
+    int *rank;
+    int *offsets;
+    int *adj;
+    double *weights;
+};
+
+/*
+ * A query workspace, reused from one query to the next. Index 0 is the
+ * forward search, index 1 the backward.
+ *
+ * @heaps: The heap of each search, keyed by its distances.
+ * @dist: Distance of each rank from the search's start.
+ * @touched: Ranks whose distance each search set.
+ * @num_touched: Number of ranks in each @touched.
+ * @settled: Nodes settled by both searches of the last query.
+ */
+struct ChQueryTag
+{
+    ChHeap heaps[2];
+    double *dist[2];
+    int *touched[2];
+    int num_touched[2];
+    int settled;
+};
+
+
+/*
+ * Start preprocessing a weighted snapshot.
+ *
+ * @csr: The snapshot. Self loops are dropped.
+ * @capacity: The most edges the hierarchy may hold, original and shortcuts.
+ * @int_buf: Array of CH_BUILD_INT_WORDS(csr->num_nodes, @capacity) ints.
+ * @double_buf: Array of CH_BUILD_DOUBLE_WORDS(csr->num_nodes, @capacity)
+ *   doubles.
+ * @return: 0 if successful, 1 if the snapshot has more than @capacity edges.
+ */
+static int graph_ch_build_init(ChBuilder *builder, const CsrGraph *csr,
+                               int capacity, int *int_buf,
+                               double *double_buf)
+{
+    int n;
+    int node_id;
+    int entry;
+
+    n = csr->num_nodes;
+    builder->num_nodes = n;
+    builder->capacity = capacity;
+    builder->num_edges = 0;
+    builder->num_shortcuts = 0;
+    builder->next_rank = 0;
+    builder->from = int_buf;
+    builder->to = int_buf + capacity;
+    builder->next_out = int_buf + 2 * capacity;
+    builder->next_in = int_buf + 3 * capacity;
+    builder->head_out = int_buf + 4 * capacity;
+    builder->head_in = builder->head_out + n;
+    builder->rank = builder->head_out + 2 * n;
+    builder->contracted = builder->head_out + 3 * n;
+    builder->touched = builder->head_out + 4 * n;
+    builder->num_touched = 0;
+    builder->weight = double_buf;
+    builder->priority = double_buf + capacity;
+    builder->dist = double_buf + capacity + n;
+    graph_ch_heap_init(&builder->order, n, builder->head_out + 5 * n,
+                       builder->head_out + 6 * n, builder->priority);
+    graph_ch_heap_init(&builder->search, n, builder->head_out + 7 * n,
+                       builder->head_out + 8 * n, builder->dist);
+
+    for (node_id = 0; node_id < n; node_id++)
+    {
+        builder->head_out[node_id] = -1;
+        builder->head_in[node_id] = -1;
+        builder->rank[node_id] = -1;
+        builder->contracted[node_id] = 0;
+        builder->dist[node_id] = HUGE_VAL;
+    }
+    for (node_id = 0; node_id < n; node_id++)
+    {
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (csr->adj[entry] != node_id &&
+                graph_ch_add_edge(builder, node_id, csr->adj[entry],
+                                  graph_csr_weight(csr, entry)) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Contract every node, adding shortcuts.
+ *
+ * @return: 0 if successful, 1 if the shortcuts overran the builder's
+ *   capacity.
+ */
+static int graph_ch_contract(ChBuilder *builder)
+{
+    int node_id;
+    int edge;
+    int other;
+    int side;
+    double priority;
+
+    for (node_id = 0; node_id < builder->num_nodes; node_id++)
+    {
+        builder->priority[node_id] = graph_ch_priority(builder, node_id);
+        graph_ch_heap_update(&builder->order, node_id);
+    }
+
+    while (builder->order.size > 0)
+    {
+        /*  contractions further away change witness paths too, so the
+         *  cheapest priority is recomputed before it is trusted  */
+        node_id = builder->order.ids[0];
+        priority = graph_ch_priority(builder, node_id);
+        if (priority > builder->priority[node_id])
+        {
+            builder->priority[node_id] = priority;
+            graph_ch_heap_update(&builder->order, node_id);
+            continue;
+        }
+
+        graph_ch_heap_pop(&builder->order);
+        if (graph_ch_contract_node(builder, node_id, 0) < 0)
+        {
+            return 1;
+        }
+        builder->rank[node_id] = builder->next_rank++;
+
+        /*  neighbors lose their edges to the node and gain a contracted
+         *  neighbor; their priorities are left to the check above  */
+        for (side = 0; side < 2; side++)
+        {
+            edge = (side == 0 ? builder->head_out[node_id] :
+                    builder->head_in[node_id]);
+            while (edge >= 0)
+            {
+                other = (side == 0 ? builder->to[edge] : builder->from[edge]);
+                if (builder->rank[other] < 0)
+                {
+                    graph_ch_prune(builder, other);
+                    builder->contracted[other]++;
+                }
+                edge = (side == 0 ? builder->next_out[edge] :
+                        builder->next_in[edge]);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Store a contracted builder's edges as a hierarchy.
+ *
+ * @rank: Array of num_nodes ints.
+ * @offsets: Array of 2 * num_nodes + 1 ints.
+ * @adj: Array of builder->num_edges ints.
+ * @weights: Array of builder->num_edges doubles.
+ */
+static void graph_ch_finish(const ChBuilder *builder, ChHierarchy *ch,
+                            int *rank, int *offsets, int *adj,
+                            double *weights)
+{
+    int n;
+    int node_id;
+    int edge;
+    int row;
+    int slot;
+    int from_rank;
+    int to_rank;
+
+    n = builder->num_nodes;
+    ch->num_nodes = n;
+    ch->num_entries = builder->num_edges;
+    ch->rank = rank;
+    ch->offsets = offsets;
+    ch->adj = adj;
+    ch->weights = weights;
+    for (node_id = 0; node_id < n; node_id++)
+    {
+        rank[node_id] = builder->rank[node_id];
+    }
+
+    /*  count the edges of each row, then place them, as in a transpose  */
+    for (row = 0; row <= 2 * n; row++)
+    {
+        offsets[row] = 0;
+    }
+    for (edge = 0; edge < builder->num_edges; edge++)
+    {
+        from_rank = rank[builder->from[edge]];
+        to_rank = rank[builder->to[edge]];
+        row = (from_rank < to_rank ? 2 * from_rank : 2 * to_rank + 1);
+        offsets[row + 1]++;
+    }
+    for (row = 0; row < 2 * n; row++)
+    {
+        offsets[row + 1] += offsets[row];
+    }
+    for (edge = 0; edge < builder->num_edges; edge++)
+    {
+        from_rank = rank[builder->from[edge]];
+        to_rank = rank[builder->to[edge]];
+        if (from_rank < to_rank)
+        {
+            slot = offsets[2 * from_rank]++;
+            adj[slot] = to_rank;
+        }
+        else
+        {
+            slot = offsets[2 * to_rank + 1]++;
+            adj[slot] = from_rank;
+        }
+        weights[slot] = builder->weight[edge];
+    }
+    for (row = 2 * n; row > 0; row--)
+    {
+        offsets[row] = offsets[row - 1];
+    }
+    offsets[0] = 0;
+}
+
+/*
+ * Initialize a query workspace.
+ *
+ * @num_nodes: Number of nodes of the hierarchies it will query.
+ * @int_buf: Array of CH_QUERY_INT_WORDS(@num_nodes) ints.
+ * @double_buf: Array of CH_QUERY_DOUBLE_WORDS(@num_nodes) doubles.
+ */
+static void graph_ch_query_init(ChQuery *query, int num_nodes, int *int_buf,
+                                double *double_buf)
+{
+    int dir;
+    int node_id;
+    int *ints;
+
+    for (dir = 0; dir < 2; dir++)
+    {
+        ints = int_buf + 3 * dir * num_nodes;
+        query->dist[dir] = double_buf + dir * num_nodes;
+        query->touched[dir] = ints + 2 * num_nodes;
+        query->num_touched[dir] = 0;
+        graph_ch_heap_init(&query->heaps[dir], num_nodes, ints,
+                           ints + num_nodes, query->dist[dir]);
+        for (node_id = 0; node_id < num_nodes; node_id++)
+        {
+            query->dist[dir][node_id] = HUGE_VAL;
+        }
+    }
+    query->settled = 0;
+}
+
+/*
+ * Find the length of a shortest path between two nodes.
+ *
+ * @from_id: Id of the node to start from. Assumed to be valid.
+ * @to_id: Id of the node to end at. Assumed to be valid.
+ * @return: The length, or HUGE_VAL if @to_id can't be reached.
+ */
+static double graph_ch_distance(const ChHierarchy *ch, ChQuery *query,
+                                int from_id, int to_id)
+{
+    ChHeap *heap;
+    double *dist;
+    double best;
+    double reach;
+    int dir;
+    int other;
+    int rank;
+    int entry;
+    int idx;
+
+    query->settled = 0;
+    best = HUGE_VAL;
+    for (dir = 0; dir < 2; dir++)
+    {
+        rank = ch->rank[dir == 0 ? from_id : to_id];
+        query->dist[dir][rank] = 0.0;
+        query->touched[dir][0] = rank;
+        query->num_touched[dir] = 1;
+        graph_ch_heap_update(&query->heaps[dir], rank);
+    }
+
+    while (1)
+    {
+        /*  settle from the search with the nearer node, until neither can
+         *  still improve on the best meeting found  */
+        dir = -1;
+        for (other = 0; other < 2; other++)
+        {
+            heap = &query->heaps[other];
+            if (heap->size > 0 && heap->keys[heap->ids[0]] < best &&
+                (dir < 0 || heap->keys[heap->ids[0]] <
+                            query->heaps[dir].keys[query->heaps[dir].ids[0]]))
+            {
+                dir = other;
+            }
+        }
+        if (dir < 0)
+        {
+            break;
+        }
+
+        dist = query->dist[dir];
+        rank = graph_ch_heap_pop(&query->heaps[dir]);
+        query->settled++;
+        if (dist[rank] + query->dist[1 - dir][rank] < best)
+        {
+            best = dist[rank] + query->dist[1 - dir][rank];
+        }
+        if (graph_ch_stalled(ch, dist, rank, dir))
+        {
+            continue;
+        }
+
+        for (entry = ch->offsets[2 * rank + dir];
+             entry < ch->offsets[2 * rank + dir + 1]; entry++)
+        {
+            reach = dist[rank] + ch->weights[entry];
+            other = ch->adj[entry];
+            if (reach < dist[other])
+            {
+                if (dist[other] == HUGE_VAL)
+                {
+                    query->touched[dir][query->num_touched[dir]++] = other;
+                }
+                dist[other] = reach;
+                graph_ch_heap_update(&query->heaps[dir], other);
+            }
+        }
+    }
+
+    for (dir = 0; dir < 2; dir++)
+    {
+        for (idx = 0; idx < query->num_touched[dir]; idx++)
+        {
+            query->dist[dir][query->touched[dir][idx]] = HUGE_VAL;
+        }
+        query->num_touched[dir] = 0;
+        graph_ch_heap_clear(&query->heaps[dir]);
+    }
+
+    return best;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Contract a node: add a shortcut for every pair of edges through it that no
+ * witness path replaces.
+ *
+ * @simulate: Nonzero to only count the shortcuts.
+ * @return: The number of shortcuts, -1 if the pool ran out of room.
+ */
+static int graph_ch_contract_node(ChBuilder *builder, int node_id,
+                                  int simulate)
+{
+    int in_edge;
+    int out_edge;
+    int from_id;
+    int to_id;
+    int count;
+    double bound;
+    double via;
+
+    count = 0;
+    for (in_edge = builder->head_in[node_id]; in_edge >= 0;
+         in_edge = builder->next_in[in_edge])
+    {
+        from_id = builder->from[in_edge];
+        if (builder->rank[from_id] >= 0)
+        {
+            continue;
+        }
+
+        /*  search no further than the longest path through the node  */
+        bound = -1.0;
+        for (out_edge = builder->head_out[node_id]; out_edge >= 0;
+             out_edge = builder->next_out[out_edge])
+        {
+            to_id = builder->to[out_edge];
+            via = builder->weight[in_edge] + builder->weight[out_edge];
+            if (builder->rank[to_id] < 0 && to_id != from_id && via > bound)
+            {
+                bound = via;
+            }
+        }
+        if (bound < 0.0)
+        {
+            continue;
+        }
+
+        graph_ch_witness(builder, from_id, node_id, bound);
+        for (out_edge = builder->head_out[node_id]; out_edge >= 0;
+             out_edge = builder->next_out[out_edge])
+        {
+            to_id = builder->to[out_edge];
+            via = builder->weight[in_edge] + builder->weight[out_edge];
+            if (builder->rank[to_id] >= 0 || to_id == from_id ||
+                builder->dist[to_id] <= via)
+            {
+                continue;
+            }
+
+            count++;
+            if (!simulate)
+            {
+                if (graph_ch_add_edge(builder, from_id, to_id, via) != 0)
+                {
+                    graph_ch_reset(builder);
+                    return -1;
+                }
+                builder->num_shortcuts++;
+            }
+        }
+        graph_ch_reset(builder);
+    }
+
+    return count;
+}
+
+/*
+ * Compute a node's priority: its edge difference plus its contracted
+ * neighbors. Lower is contracted sooner.
+ */
+static double graph_ch_priority(ChBuilder *builder, int node_id)
+{
+    int edge;
+    int removed;
+
+    removed = 0;
+    for (edge = builder->head_out[node_id]; edge >= 0;
+         edge = builder->next_out[edge])
+    {
+        removed += (builder->rank[builder->to[edge]] < 0);
+    }
+    for (edge = builder->head_in[node_id]; edge >= 0;
+         edge = builder->next_in[edge])
+    {
+        removed += (builder->rank[builder->from[edge]] < 0);
+    }
+
+    return (double)graph_ch_contract_node(builder, node_id, 1) - removed +
+           builder->contracted[node_id];
+}
+
+/*
+ * Search for witness paths from a node, over the nodes not yet contracted
+ * other than one, settling nodes until they are further than a bound or
+ * CH_WITNESS_LIMIT are settled. Distances are left in builder->dist until
+ * 'graph_ch_reset'.
+ *
+ * @source: Id of the node to search from.
+ * @skip_id: Id of the node being contracted, which paths may not cross.
+ * @bound: Distance beyond which no path is a witness.
+ */
+static void graph_ch_witness(ChBuilder *builder, int source, int skip_id,
+                             double bound)
+{
+    int node_id;
+    int to_id;
+    int edge;
+    int settled;
+    double reach;
+
+    builder->dist[source] = 0.0;
+    builder->touched[builder->num_touched++] = source;
+    graph_ch_heap_update(&builder->search, source);
+    for (settled = 0; builder->search.size > 0 && settled < CH_WITNESS_LIMIT;
+         settled++)
+    {
+        node_id = graph_ch_heap_pop(&builder->search);
+        if (builder->dist[node_id] > bound)
+        {
+            break;
+        }
+
+        for (edge = builder->head_out[node_id]; edge >= 0;
+             edge = builder->next_out[edge])
+        {
+            to_id = builder->to[edge];
+            reach = builder->dist[node_id] + builder->weight[edge];
+            if (to_id == skip_id || builder->rank[to_id] >= 0 ||
+                reach >= builder->dist[to_id])
+            {
+                continue;
+            }
+
+            if (builder->dist[to_id] == HUGE_VAL)
+            {
+                builder->touched[builder->num_touched++] = to_id;
+            }
+            builder->dist[to_id] = reach;
+            graph_ch_heap_update(&builder->search, to_id);
+        }
+    }
+}
+
+/*
+ * Forget the distances of the last witness search.
+ */
+static void graph_ch_reset(ChBuilder *builder)
+{
+    int idx;
+
+    for (idx = 0; idx < builder->num_touched; idx++)
+    {
+        builder->dist[builder->touched[idx]] = HUGE_VAL;
+    }
+    builder->num_touched = 0;
+    graph_ch_heap_clear(&builder->search);
+}
+
+/*
+ * Unlink the edges of a node to and from contracted nodes from its lists, so
+ * later searches don't step over them. They stay in the pool for
+ * 'graph_ch_finish'.
+ */
+static void graph_ch_prune(ChBuilder *builder, int node_id)
+{
+    int *link;
+
+    link = &builder->head_out[node_id];
+    while (*link >= 0)
+    {
+        if (builder->rank[builder->to[*link]] >= 0)
+        {
+            *link = builder->next_out[*link];
+        }
+        else
+        {
+            link = &builder->next_out[*link];
+        }
+    }
+
+    link = &builder->head_in[node_id];
+    while (*link >= 0)
+    {
+        if (builder->rank[builder->from[*link]] >= 0)
+        {
+            *link = builder->next_in[*link];
+        }
+        else
+        {
+            link = &builder->next_in[*link];
+        }
+    }
+}
+
+/*
+ * Add an edge to the pool, or lower the weight of the edge between the same
+ * nodes if there is one.
+ *
+ * @return: 0 if successful, 1 if the pool is full.
+ */
+static int graph_ch_add_edge(ChBuilder *builder, int from_id, int to_id,
+                             double weight)
+{
+    int edge;
+
+    for (edge = builder->head_out[from_id]; edge >= 0;
+         edge = builder->next_out[edge])
+    {
+        if (builder->to[edge] == to_id)
+        {
+            if (weight < builder->weight[edge])
+            {
+                builder->weight[edge] = weight;
+            }
+            return 0;
+        }
+    }
+    if (builder->num_edges == builder->capacity)
+    {
+        return 1;
+    }
+
+    edge = builder->num_edges++;
+    builder->from[edge] = from_id;
+    builder->to[edge] = to_id;
+    builder->weight[edge] = weight;
+    builder->next_out[edge] = builder->head_out[from_id];
+    builder->head_out[from_id] = edge;
+    builder->next_in[edge] = builder->head_in[to_id];
+    builder->head_in[to_id] = edge;
+
+    return 0;
+}
+
+/*
+ * Determine if a search reaches a node sooner from above, over an edge from a
+ * higher rank, than it did from below. Its distance isn't its shortest, so
+ * nothing a shortest path needs is found from it. Those edges are in the
+ * node's other row, next to the row the search is reading.
+ *
+ * @dist: Distances of the search.
+ * @rank: Rank of the node.
+ * @dir: 0 for the forward search, 1 for the backward.
+ * @return: Bool. 1 if the node can be skipped, 0 if not.
+ */
+static int graph_ch_stalled(const ChHierarchy *ch, const double *dist,
+                            int rank, int dir)
+{
+    int entry;
+
+    for (entry = ch->offsets[2 * rank + 1 - dir];
+         entry < ch->offsets[2 * rank + 2 - dir]; entry++)
+    {
+        if (dist[ch->adj[entry]] + ch->weights[entry] < dist[rank])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Initialize an empty heap.
+ *
+ * @size: Number of nodes that may be in the heap.
+ * @ids: Array of @size ints.
+ * @pos: Array of @size ints.
+ * @keys: Array of @size doubles, the key of each node. Not copied.
+ */
+static void graph_ch_heap_init(ChHeap *heap, int size, int *ids, int *pos,
+                               double *keys)
+{
+    int node_id;
+
+    heap->size = 0;
+    heap->ids = ids;
+    heap->pos = pos;
+    heap->keys = keys;
+    for (node_id = 0; node_id < size; node_id++)
+    {
+        pos[node_id] = -1;
+    }
+}
+
+/*
+ * Restore the heap order around a node whose key was set, adding the node if
+ * it isn't in the heap.
+ */
+static void graph_ch_heap_update(ChHeap *heap, int node_id)
+{
+    int idx;
+    int child;
+
+    idx = heap->pos[node_id];
+    if (idx < 0)
+    {
+        idx = heap->size++;
+        heap->ids[idx] = node_id;
+        heap->pos[node_id] = idx;
+    }
+
+    /*  sift up, then down, only one of which moves the node  */
+    while (idx > 0 && heap->keys[heap->ids[(idx - 1) / 2]] >
+                      heap->keys[node_id])
+    {
+        graph_ch_heap_swap(heap, idx, (idx - 1) / 2);
+        idx = (idx - 1) / 2;
+    }
+    while (2 * idx + 1 < heap->size)
+    {
+        child = 2 * idx + 1;
+        if (child + 1 < heap->size &&
+            heap->keys[heap->ids[child + 1]] < heap->keys[heap->ids[child]])
+        {
+            child++;
+        }
+        if (heap->keys[heap->ids[child]] >= heap->keys[node_id])
+        {
+            break;
+        }
+        graph_ch_heap_swap(heap, idx, child);
+        idx = child;
+    }
+}
+
+/*
+ * Remove the node with the smallest key from a heap.
+ * CAUTION: the heap must not be empty.
+ *
+ * @return: The id of the node.
+ */
+static int graph_ch_heap_pop(ChHeap *heap)
+{
+    int top;
+
+    top = heap->ids[0];
+    graph_ch_heap_swap(heap, 0, --heap->size);
+    heap->pos[top] = -1;
+    if (heap->size > 0)
+    {
+        graph_ch_heap_update(heap, heap->ids[0]);
+    }
+
+    return top;
+}
+
+/*
+ * Remove every node from a heap. O(number of nodes in it).
+ */
+static void graph_ch_heap_clear(ChHeap *heap)
+{
+    int idx;
+
+    for (idx = 0; idx < heap->size; idx++)
+    {
+        heap->pos[heap->ids[idx]] = -1;
+    }
+    heap->size = 0;
+}
+
+/*
+ * Swap two entries of a heap, keeping their positions up to date.
+ */
+static void graph_ch_heap_swap(ChHeap *heap, int left, int right)
+{
+    int tmp;
+
+    tmp = heap->ids[left];
+    heap->ids[left] = heap->ids[right];
+    heap->ids[right] = tmp;
+    heap->pos[heap->ids[left]] = left;
+    heap->pos[heap->ids[right]] = right;
+}
+
+
+#endif
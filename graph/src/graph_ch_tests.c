@@ -0,0 +1,342 @@
+/*
+ * Unit tests for the contraction hierarchy header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_ch.h"
+#include "graph_generators.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 8
+#define MAX_ENTRIES 32
+#define GRID_ROWS 12
+#define GRID_COLS 12
+#define GRID_SIZE (GRID_ROWS * GRID_COLS)
+
+static Graph graph;
+static Node node_arr[GRID_SIZE];
+static CsrGraph csr;
+static int offsets[GRID_SIZE + 1];
+static int *adj;
+static double *weights;
+
+static ChBuilder builder;
+static ChHierarchy ch;
+static ChQuery query;
+
+static void init_graph(const int *from, const int *to, const double *w,
+                       int num_edges, int size, int undirected);
+static int build(int capacity);
+static void free_hierarchy(void);
+static void naive_distances(const CsrGraph *csr, double *dist);
+
+
+void test_shortcuts_keep_distances()
+{
+    /* Two routes from 0 to 5: over 1, 2, 3 at 1 each, or over 4 at 5 + 5. */
+    int from[7] = {0, 1, 2, 3, 0, 4, 6};
+    int to[7] = {1, 2, 3, 5, 4, 5, 6};
+    double w[7] = {1, 1, 1, 1, 5, 5, 1};
+    double dist[INIT_SIZE * INIT_SIZE];
+    int from_id;
+    int to_id;
+
+    init_graph(from, to, w, 7, INIT_SIZE, 1);
+    TEST_ASSERT_EQUAL(0, build(MAX_ENTRIES));
+    TEST_ASSERT_EQUAL(csr.num_entries + builder.num_shortcuts, ch.num_entries);
+
+    naive_distances(&csr, dist);
+    for (from_id = 0; from_id < INIT_SIZE; from_id++)
+    {
+        for (to_id = 0; to_id < INIT_SIZE; to_id++)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(dist[from_id * INIT_SIZE + to_id],
+                                    graph_ch_distance(&ch, &query, from_id,
+                                                      to_id));
+        }
+    }
+    TEST_ASSERT_EQUAL_FLOAT(4.0, graph_ch_distance(&ch, &query, 5, 0));
+    TEST_ASSERT_EQUAL_FLOAT(HUGE_VAL, graph_ch_distance(&ch, &query, 0, 7));
+    free_hierarchy();
+}
+
+void test_one_way_edges()
+{
+    /* A one-way ring 0 -> 1 -> 2 -> 3 -> 0, with a two-way chord 0 - 2. */
+    int from[6] = {0, 1, 2, 3, 0, 2};
+    int to[6] = {1, 2, 3, 0, 2, 0};
+    double w[6] = {1, 1, 1, 1, 3, 3};
+
+    init_graph(from, to, w, 6, INIT_SIZE, 0);
+    TEST_ASSERT_EQUAL(0, build(MAX_ENTRIES));
+    TEST_ASSERT_EQUAL_FLOAT(2.0, graph_ch_distance(&ch, &query, 0, 2));
+    TEST_ASSERT_EQUAL_FLOAT(2.0, graph_ch_distance(&ch, &query, 2, 0));
+    TEST_ASSERT_EQUAL_FLOAT(3.0, graph_ch_distance(&ch, &query, 1, 0));
+    TEST_ASSERT_EQUAL_FLOAT(3.0, graph_ch_distance(&ch, &query, 0, 3));
+    TEST_ASSERT_EQUAL_FLOAT(0.0, graph_ch_distance(&ch, &query, 3, 3));
+    TEST_ASSERT_EQUAL_FLOAT(HUGE_VAL, graph_ch_distance(&ch, &query, 4, 0));
+    free_hierarchy();
+
+    /* The pool can't even hold the original edges. */
+    TEST_ASSERT_EQUAL(1, build(5));
+    free_hierarchy();
+}
+
+void test_ranks_and_layout()
+{
+    int rank_seen[GRID_SIZE];
+    int from[2 * GRID_SIZE];
+    int to[2 * GRID_SIZE];
+    double w[2 * GRID_SIZE];
+    int num_edges;
+    int node_id;
+    int row;
+    int entry;
+
+    num_edges = (int)graph_gen_grid_edges(GRID_ROWS, GRID_COLS);
+    graph_gen_grid(GRID_ROWS, GRID_COLS, from, to, 0, num_edges);
+    for (entry = 0; entry < num_edges; entry++)
+    {
+        w[entry] = 1.0;
+    }
+    init_graph(from, to, w, num_edges, GRID_SIZE, 1);
+    TEST_ASSERT_EQUAL(0, build(4 * csr.num_entries));
+
+    /* Ranks are a permutation, and every edge climbs in its row. */
+    for (node_id = 0; node_id < GRID_SIZE; node_id++)
+    {
+        rank_seen[node_id] = 0;
+    }
+    for (node_id = 0; node_id < GRID_SIZE; node_id++)
+    {
+        rank_seen[ch.rank[node_id]]++;
+    }
+    for (node_id = 0; node_id < GRID_SIZE; node_id++)
+    {
+        TEST_ASSERT_EQUAL(1, rank_seen[node_id]);
+    }
+    for (row = 0; row < 2 * GRID_SIZE; row++)
+    {
+        for (entry = ch.offsets[row]; entry < ch.offsets[row + 1]; entry++)
+        {
+            TEST_ASSERT_TRUE(ch.adj[entry] > row / 2);
+        }
+    }
+    TEST_ASSERT_EQUAL(ch.num_entries, ch.offsets[2 * GRID_SIZE]);
+
+    /* Corner to corner of a grid of unit squares. */
+    TEST_ASSERT_EQUAL_FLOAT(GRID_ROWS + GRID_COLS - 2,
+                            graph_ch_distance(&ch, &query, 0,
+                                              GRID_SIZE - 1));
+    free_hierarchy();
+}
+
+void test_weighted_grid_matches_naive()
+{
+    GraphRng rng;
+    int from[2 * GRID_SIZE];
+    int to[2 * GRID_SIZE];
+    double w[2 * GRID_SIZE];
+    double *dist;
+    int num_edges;
+    int entry;
+    int from_id;
+    int to_id;
+    int most_settled;
+
+    num_edges = (int)graph_gen_grid_edges(GRID_ROWS, GRID_COLS);
+    graph_gen_grid(GRID_ROWS, GRID_COLS, from, to, 0, num_edges);
+    for (entry = 0; entry < num_edges; entry++)
+    {
+        w[entry] = 1.0;
+    }
+    graph_rng_seed(&rng, 9, 0);
+    init_graph(from, to, w, num_edges, GRID_SIZE, 1);
+
+    /*  a different random weight in each direction  */
+    for (entry = 0; entry < csr.num_entries; entry++)
+    {
+        weights[entry] = 1 + graph_rng_below(&rng, 20);
+    }
+    TEST_ASSERT_EQUAL(0, build(4 * csr.num_entries));
+
+    dist = malloc(GRID_SIZE * GRID_SIZE * sizeof(double));
+    naive_distances(&csr, dist);
+    most_settled = 0;
+    for (from_id = 0; from_id < GRID_SIZE; from_id++)
+    {
+        for (to_id = 0; to_id < GRID_SIZE; to_id++)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(dist[from_id * GRID_SIZE + to_id],
+                                    graph_ch_distance(&ch, &query, from_id,
+                                                      to_id));
+            if (query.settled > most_settled)
+            {
+                most_settled = query.settled;
+            }
+        }
+    }
+
+    /* Queries settle a fraction of the graph. */
+    TEST_ASSERT_TRUE(most_settled < GRID_SIZE);
+    free(dist);
+    free_hierarchy();
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  contract a graph with a detour, compare every distance  */
+    RUN_TEST(test_shortcuts_keep_distances);
+    /*  route over one-way edges, run out of room  */
+    RUN_TEST(test_one_way_edges);
+    /*  verify ranks and that every stored edge goes up the hierarchy  */
+    RUN_TEST(test_ranks_and_layout);
+    /*  route between every pair of a weighted grid, compare with naive  */
+    RUN_TEST(test_weighted_grid_matches_naive);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build a weighted snapshot from a list of edges. Each weight goes with its
+ * edge in both directions of an undirected snapshot.
+ */
+static void init_graph(const int *from, const int *to, const double *w,
+                       int num_edges, int size, int undirected)
+{
+    int idx;
+    int entry;
+
+    graph_init(&graph, node_arr, size);
+    graph_gen_fill(&graph, from, to, num_edges,
+                   malloc(num_edges * sizeof(Bucket)), num_edges);
+    adj = malloc(graph_csr_count(&graph, undirected) * sizeof(int));
+    weights = malloc(graph_csr_count(&graph, undirected) * sizeof(double));
+    graph_csr_build(&graph, &csr, offsets, adj, undirected);
+    csr.weights = weights;
+    for (idx = 0; idx < num_edges; idx++)
+    {
+        entry = graph_csr_find(&csr, from[idx], to[idx]);
+        if (entry >= 0)
+        {
+            weights[entry] = w[idx];
+        }
+        entry = graph_csr_find(&csr, to[idx], from[idx]);
+        if (undirected && entry >= 0)
+        {
+            weights[entry] = w[idx];
+        }
+    }
+}
+
+/*
+ * Build a hierarchy of the snapshot and a query workspace for it.
+ *
+ * @return: 0 if successful, 1 if @capacity was too small.
+ */
+static int build(int capacity)
+{
+    int n;
+    int *int_buf;
+    double *double_buf;
+    int result;
+
+    n = csr.num_nodes;
+    int_buf = malloc(CH_BUILD_INT_WORDS(n, capacity) * sizeof(int));
+    double_buf = malloc(CH_BUILD_DOUBLE_WORDS(n, capacity) * sizeof(double));
+    result = graph_ch_build_init(&builder, &csr, capacity, int_buf,
+                                 double_buf);
+    if (result == 0)
+    {
+        result = graph_ch_contract(&builder);
+    }
+    ch.rank = 0;
+    if (result == 0)
+    {
+        graph_ch_finish(&builder, &ch, malloc(n * sizeof(int)),
+                        malloc((2 * n + 1) * sizeof(int)),
+                        malloc(builder.num_edges * sizeof(int)),
+                        malloc(builder.num_edges * sizeof(double)));
+        graph_ch_query_init(&query, n,
+                            malloc(CH_QUERY_INT_WORDS(n) * sizeof(int)),
+                            malloc(CH_QUERY_DOUBLE_WORDS(n) *
+                                   sizeof(double)));
+    }
+    free(int_buf);
+    free(double_buf);
+
+    return result;
+}
+
+/*
+ * Free the hierarchy and query workspace of the last successful build.
+ */
+static void free_hierarchy(void)
+{
+    if (ch.rank != 0)
+    {
+        free(ch.rank);
+        free(ch.offsets);
+        free(ch.adj);
+        free(ch.weights);
+        free(query.heaps[0].ids);
+        free(query.dist[0]);
+        ch.rank = 0;
+    }
+}
+
+/*
+ * Find the distance between every pair of nodes with Floyd-Warshall.
+ *
+ * @dist: Array of n * n doubles. Receives the distance from u to v at
+ *   u * n + v.
+ */
+static void naive_distances(const CsrGraph *csr, double *dist)
+{
+    int n;
+    int mid;
+    int from_id;
+    int to_id;
+    int entry;
+    double via;
+
+    n = csr->num_nodes;
+    for (from_id = 0; from_id < n * n; from_id++)
+    {
+        dist[from_id] = HUGE_VAL;
+    }
+    for (from_id = 0; from_id < n; from_id++)
+    {
+        dist[from_id * n + from_id] = 0.0;
+        for (entry = csr->offsets[from_id];
+             entry < csr->offsets[from_id + 1]; entry++)
+        {
+            to_id = csr->adj[entry];
+            if (csr->weights[entry] < dist[from_id * n + to_id])
+            {
+                dist[from_id * n + to_id] = csr->weights[entry];
+            }
+        }
+    }
+    for (mid = 0; mid < n; mid++)
+    {
+        for (from_id = 0; from_id < n; from_id++)
+        {
+            for (to_id = 0; to_id < n; to_id++)
+            {
+                via = dist[from_id * n + mid] + dist[mid * n + to_id];
+                if (via < dist[from_id * n + to_id])
+                {
+                    dist[from_id * n + to_id] = via;
+                }
+            }
+        }
+    }
+}
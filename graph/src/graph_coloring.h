@@ -0,0 +1,394 @@
+/*
+ * Graph coloring and maximal independent sets by random priorities.
+ * See Jones and Plassmann, "A Parallel Graph Coloring Heuristic" (1993) and
+ * Luby, "A Simple Parallel Algorithm for the Maximal Independent Set Problem"
+ * (1986) for the theory.
+ *
+ * Both algorithms work in rounds. Every node gets a random priority, and in
+ * each round the nodes that beat all of their still-undecided neighbors decide
+ * at once: Jones-Plassmann gives them the smallest color none of their
+ * neighbors has, Luby puts them in the set and knocks their neighbors out.
+ * Nodes deciding in the same round are never adjacent, so a round can be split
+ * between any number of workers without coordination. Rounds shrink quickly;
+ * on graphs of bounded degree only O(log n) of them are expected.
+ *
+ * Both operate on an undirected snapshot from graph_csr.h, so conflicts are
+ * symmetric no matter which way the edges of the Graph point.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. The simple way
+ * to use it is to call 'graph_color_jp' or 'graph_mis_luby', which run every
+ * round on the calling thread. To spread a round over a pool of workers, copy
+ * the driver loop and split the [lo, hi) ranges of each phase between workers
+ * with a barrier after each phase:
+ *   - Coloring: 'graph_color_jp_select', then 'graph_color_jp_assign' (each
+ *     worker with its own @forbidden array), then drop colored nodes from the
+ *     work list.
+ *   - Independent set: 'graph_mis_luby_select', then 'graph_mis_luby_update',
+ *     then drop decided nodes from the work list.
+ *
+ * Results depend only on the seed, never on how rounds were split.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_COLORING_H
+#define GRAPH_COLORING_H
+
+#include "graph_csr.h"
+#include "graph_rng.h"
+
+/*  color of a node that has not been colored yet  */
+#define COLOR_NONE -1
+
+/*  states of a node during Luby's algorithm  */
+#define MIS_UNDECIDED 0
+#define MIS_IN 1
+#define MIS_OUT 2
+
+static int graph_coloring_beats(unsigned long seed, int node_id, int other_id);
+static int graph_color_compact(int *work, int count, const int *colors);
+static int graph_mis_compact(int *work, int count, const char *state);
+
+/*
+ * Mark the uncolored nodes of a work list range that beat all their uncolored
+ * neighbors. Reads @colors, writes only @selected of its own range.
+ *
+ * @colors: Color of each node, COLOR_NONE if uncolored.
+ * @seed: Seed of the node priorities.
+ * @work: List of uncolored nodes.
+ * @lo: First position of @work to process.
+ * @hi: One past the last position of @work to process.
+ * @selected: Flag per node. Set for the selected nodes of the range and
+ *   cleared for the others.
+ */
+static void graph_color_jp_select(const CsrGraph *csr, const int *colors,
+                                  unsigned long seed, const int *work, int lo,
+                                  int hi, char *selected)
+{
+    int pos;
+    int node_id;
+    int entry;
+    int neighbor;
+
+    for (pos = lo; pos < hi; pos++)
+    {
+        node_id = work[pos];
+        selected[node_id] = 1;
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            neighbor = csr->adj[entry];
+            if (colors[neighbor] == COLOR_NONE &&
+                graph_coloring_beats(seed, neighbor, node_id))
+            {
+                selected[node_id] = 0;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Color the selected nodes of a work list range with the smallest color none
+ * of their neighbors has. Selected nodes are never adjacent, so ranges can be
+ * colored concurrently.
+ *
+ * @colors: Color of each node. Receives the colors of the selected nodes.
+ * @work: List of uncolored nodes.
+ * @lo: First position of @work to process.
+ * @hi: One past the last position of @work to process.
+ * @selected: Flags set by 'graph_color_jp_select'.
+ * @forbidden: Scratch array of (largest degree + 1) ints, all -1 before the
+ *   first use. Give each worker its own.
+ */
+static void graph_color_jp_assign(const CsrGraph *csr, int *colors,
+                                  const int *work, int lo, int hi,
+                                  const char *selected, int *forbidden)
+{
+    int pos;
+    int node_id;
+    int entry;
+    int color;
+    int degree;
+
+    for (pos = lo; pos < hi; pos++)
+    {
+        node_id = work[pos];
+        if (!selected[node_id])
+        {
+            continue;
+        }
+
+        /*  stamp the colors of the neighbors with this node's id  */
+        degree = csr->offsets[node_id + 1] - csr->offsets[node_id];
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            color = colors[csr->adj[entry]];
+            if (color != COLOR_NONE && color <= degree)
+            {
+                forbidden[color] = node_id;
+            }
+        }
+        for (color = 0; forbidden[color] == node_id; color++)
+        {
+        }
+        colors[node_id] = color;
+    }
+}
+
+/*
+ * Color a graph with the Jones-Plassmann algorithm.
+ * Adjacent nodes always get different colors, and no node gets a color larger
+ * than its degree.
+ *
+ * @csr: Undirected snapshot.
+ * @colors: Array of csr->num_nodes ints. Receives the colors, from 0.
+ * @seed: Seed of the node priorities.
+ * @work: Scratch array of csr->num_nodes ints.
+ * @selected: Scratch array of csr->num_nodes chars.
+ * @forbidden: Scratch array of (largest degree + 1) ints.
+ * @return: The number of colors used.
+ */
+static int graph_color_jp(const CsrGraph *csr, int *colors, unsigned long seed,
+                          int *work, char *selected, int *forbidden)
+{
+    int node_id;
+    int count;
+    int max_degree;
+    int num_colors;
+
+    max_degree = 0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        colors[node_id] = COLOR_NONE;
+        work[node_id] = node_id;
+        if (graph_csr_degree(csr, node_id) > max_degree)
+        {
+            max_degree = graph_csr_degree(csr, node_id);
+        }
+    }
+    for (node_id = 0; node_id <= max_degree; node_id++)
+    {
+        forbidden[node_id] = -1;
+    }
+
+    count = csr->num_nodes;
+    while (count > 0)
+    {
+        graph_color_jp_select(csr, colors, seed, work, 0, count, selected);
+        graph_color_jp_assign(csr, colors, work, 0, count, selected,
+                              forbidden);
+        count = graph_color_compact(work, count, colors);
+    }
+
+    num_colors = 0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        if (colors[node_id] + 1 > num_colors)
+        {
+            num_colors = colors[node_id] + 1;
+        }
+    }
+    return num_colors;
+}
+
+/*
+ * Mark the undecided nodes of a work list range that beat all their undecided
+ * neighbors in this round. Reads @state, writes only @selected of its range.
+ *
+ * @state: MIS_UNDECIDED, MIS_IN or MIS_OUT for each node.
+ * @seed: Seed of the priorities.
+ * @round: Round number. Priorities are redrawn every round.
+ * @work: List of undecided nodes.
+ * @lo: First position of @work to process.
+ * @hi: One past the last position of @work to process.
+ * @selected: Flag per node. Set for the selected nodes of the range and
+ *   cleared for the others.
+ */
+static void graph_mis_luby_select(const CsrGraph *csr, const char *state,
+                                  unsigned long seed, int round,
+                                  const int *work, int lo, int hi,
+                                  char *selected)
+{
+    int pos;
+    int node_id;
+    int entry;
+    int neighbor;
+    unsigned long round_seed;
+
+    round_seed = graph_rng_hash(seed, (unsigned long)round);
+    for (pos = lo; pos < hi; pos++)
+    {
+        node_id = work[pos];
+        selected[node_id] = 1;
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            neighbor = csr->adj[entry];
+            if (state[neighbor] == MIS_UNDECIDED &&
+                graph_coloring_beats(round_seed, neighbor, node_id))
+            {
+                selected[node_id] = 0;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Decide the nodes of a work list range: selected nodes join the set and
+ * nodes next to a selected node leave it. Reads only @selected of other
+ * nodes, so ranges can be updated concurrently.
+ *
+ * @state: State of each node. Receives the decisions of the range.
+ * @work: List of undecided nodes.
+ * @lo: First position of @work to process.
+ * @hi: One past the last position of @work to process.
+ * @selected: Flags set by 'graph_mis_luby_select' for the whole work list.
+ */
+static void graph_mis_luby_update(const CsrGraph *csr, char *state,
+                                  const int *work, int lo, int hi,
+                                  const char *selected)
+{
+    int pos;
+    int node_id;
+    int entry;
+
+    for (pos = lo; pos < hi; pos++)
+    {
+        node_id = work[pos];
+        if (selected[node_id])
+        {
+            state[node_id] = MIS_IN;
+            continue;
+        }
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (selected[csr->adj[entry]])
+            {
+                state[node_id] = MIS_OUT;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Find a maximal independent set with Luby's algorithm.
+ * No two nodes in the set are adjacent and every node outside of it has a
+ * neighbor in it.
+ *
+ * @csr: Undirected snapshot.
+ * @state: Array of csr->num_nodes chars. Receives MIS_IN or MIS_OUT.
+ * @seed: Seed of the priorities.
+ * @work: Scratch array of csr->num_nodes ints.
+ * @selected: Scratch array of csr->num_nodes chars.
+ * @return: The number of nodes in the set.
+ */
+static int graph_mis_luby(const CsrGraph *csr, char *state, unsigned long seed,
+                          int *work, char *selected)
+{
+    int node_id;
+    int count;
+    int round;
+    int size;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        state[node_id] = MIS_UNDECIDED;
+        work[node_id] = node_id;
+    }
+
+    count = csr->num_nodes;
+    for (round = 0; count > 0; round++)
+    {
+        graph_mis_luby_select(csr, state, seed, round, work, 0, count,
+                              selected);
+        graph_mis_luby_update(csr, state, work, 0, count, selected);
+        count = graph_mis_compact(work, count, state);
+    }
+
+    size = 0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        size += (state[node_id] == MIS_IN);
+    }
+    return size;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Determine if a node's priority beats another's.
+ * Priorities are hashes of the node ids; equal hashes are broken by id.
+ *
+ * @return: Bool. 1 if @node_id has the higher priority, 0 if not.
+ */
+static int graph_coloring_beats(unsigned long seed, int node_id, int other_id)
+{
+    unsigned long prio;
+    unsigned long other_prio;
+
+    prio = graph_rng_hash(seed, (unsigned long)node_id);
+    other_prio = graph_rng_hash(seed, (unsigned long)other_id);
+    if (prio != other_prio)
+    {
+        return prio > other_prio;
+    }
+    return node_id > other_id;
+}
+
+/*
+ * Drop colored nodes from a work list, keeping the order of the rest.
+ *
+ * @work: The work list.
+ * @count: Number of nodes in @work.
+ * @colors: Color of each node.
+ * @return: The number of nodes left in @work.
+ */
+static int graph_color_compact(int *work, int count, const int *colors)
+{
+    int read;
+    int write;
+
+    write = 0;
+    for (read = 0; read < count; read++)
+    {
+        if (colors[work[read]] == COLOR_NONE)
+        {
+            work[write++] = work[read];
+        }
+    }
+    return write;
+}
+
+/*
+ * Drop decided nodes from a work list, keeping the order of the rest.
+ *
+ * @work: The work list.
+ * @count: Number of nodes in @work.
+ * @state: State of each node.
+ * @return: The number of nodes left in @work.
+ */
+static int graph_mis_compact(int *work, int count, const char *state)
+{
+    int read;
+    int write;
+
+    write = 0;
+    for (read = 0; read < count; read++)
+    {
+        if (state[work[read]] == MIS_UNDECIDED)
+        {
+            work[write++] = work[read];
+        }
+    }
+    return write;
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Unit tests for the coloring and independent set header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_coloring.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 40
+#define MAX_ENTRIES 1600
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static CsrGraph csr;
+static int offsets[INIT_SIZE + 1];
+static int adj[MAX_ENTRIES];
+static int colors[INIT_SIZE];
+static int work[INIT_SIZE];
+static char selected[INIT_SIZE];
+static int forbidden[INIT_SIZE];
+static char state[INIT_SIZE];
+
+static void init_graph(void);
+static void assert_proper_coloring(void);
+
+
+void test_color_clique()
+{
+    int from, to;
+
+    init_graph();
+    for (from = 0; from < 6; from++)
+    {
+        for (to = from + 1; to < 6; to++)
+        {
+            graph_add_edge(&graph, from, to);
+        }
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    TEST_ASSERT_EQUAL(6, graph_color_jp(&csr, colors, 1, work, selected,
+                                        forbidden));
+    assert_proper_coloring();
+    /* Isolated nodes all take the first color. */
+    TEST_ASSERT_EQUAL(0, colors[INIT_SIZE - 1]);
+}
+
+void test_color_random_graph()
+{
+    int idx;
+
+    init_graph();
+    srand(12);
+    for (idx = 0; idx < 4 * INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, rand() % INIT_SIZE, rand() % INIT_SIZE);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    graph_color_jp(&csr, colors, 99, work, selected, forbidden);
+    assert_proper_coloring();
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        TEST_ASSERT_TRUE(colors[idx] <= graph_csr_degree(&csr, idx));
+    }
+}
+
+void test_color_split_rounds_match()
+{
+    int expected[INIT_SIZE];
+    int count;
+    int idx;
+
+    init_graph();
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+        graph_add_edge(&graph, idx, (idx * 7 + 3) % INIT_SIZE);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+    graph_color_jp(&csr, expected, 5, work, selected, forbidden);
+
+    /* Drive the rounds by hand, as two workers would. */
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        colors[idx] = COLOR_NONE;
+        work[idx] = idx;
+        forbidden[idx] = -1;
+    }
+    count = INIT_SIZE;
+    while (count > 0)
+    {
+        graph_color_jp_select(&csr, colors, 5, work, count / 2, count,
+                              selected);
+        graph_color_jp_select(&csr, colors, 5, work, 0, count / 2, selected);
+        graph_color_jp_assign(&csr, colors, work, count / 2, count, selected,
+                              forbidden);
+        graph_color_jp_assign(&csr, colors, work, 0, count / 2, selected,
+                              forbidden);
+        count = graph_color_compact(work, count, colors);
+    }
+
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, colors, INIT_SIZE);
+}
+
+void test_mis_is_independent_and_maximal()
+{
+    int node_id;
+    int entry;
+    int covered;
+    int size;
+    int idx;
+
+    init_graph();
+    srand(3);
+    for (idx = 0; idx < 3 * INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, rand() % INIT_SIZE, rand() % INIT_SIZE);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    size = graph_mis_luby(&csr, state, 17, work, selected);
+
+    TEST_ASSERT_TRUE(size > 0);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        covered = 0;
+        for (entry = offsets[node_id]; entry < offsets[node_id + 1]; entry++)
+        {
+            covered |= (state[adj[entry]] == MIS_IN);
+        }
+        if (state[node_id] == MIS_IN)
+        {
+            TEST_ASSERT_FALSE(covered);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(MIS_OUT, state[node_id]);
+            TEST_ASSERT_TRUE(covered);
+        }
+    }
+}
+
+void test_mis_star()
+{
+    int idx;
+
+    /* The center beats nobody forever: either it or every leaf is in. */
+    init_graph();
+    for (idx = 1; idx < 8; idx++)
+    {
+        graph_add_edge(&graph, 0, idx);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    graph_mis_luby(&csr, state, 4, work, selected);
+
+    if (state[0] == MIS_IN)
+    {
+        for (idx = 1; idx < 8; idx++)
+        {
+            TEST_ASSERT_EQUAL(MIS_OUT, state[idx]);
+        }
+    }
+    else
+    {
+        for (idx = 1; idx < 8; idx++)
+        {
+            TEST_ASSERT_EQUAL(MIS_IN, state[idx]);
+        }
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  color a clique, verify it needs one color per node  */
+    RUN_TEST(test_color_clique);
+    /*  color a random graph, verify the coloring is proper  */
+    RUN_TEST(test_color_random_graph);
+    /*  color by hand-driven split rounds, verify the same colors  */
+    RUN_TEST(test_color_split_rounds_match);
+
+    /*  find an independent set, verify independence and maximality  */
+    RUN_TEST(test_mis_is_independent_and_maximal);
+    /*  find an independent set of a star  */
+    RUN_TEST(test_mis_star);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize the graph with enough buckets for any test.
+ */
+static void init_graph(void)
+{
+    int idx;
+    int cnt;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        for (cnt = 0; cnt < 4; cnt++)
+        {
+            graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+        }
+    }
+}
+
+/*
+ * Check that every node is colored and no edge joins two equal colors.
+ */
+static void assert_proper_coloring(void)
+{
+    int node_id;
+    int entry;
+
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_TRUE(colors[node_id] != COLOR_NONE);
+        for (entry = offsets[node_id]; entry < offsets[node_id + 1]; entry++)
+        {
+            TEST_ASSERT_TRUE(colors[node_id] != colors[adj[entry]]);
+        }
+    }
+}
@@ -0,0 +1,823 @@
+/*
+ * Community detection over undirected graph snapshots.
+ * See https://en.wikipedia.org/wiki/Label_propagation_algorithm and
+ * https://en.wikipedia.org/wiki/Louvain_method for the theory.
+ *
+ * Two algorithms are provided:
+ *   - Label propagation: every node repeatedly adopts the label carrying the
+ *     most edge weight among its neighbors. Updates are asynchronous (a node
+ *     sees the labels its neighbors were just given) and only nodes whose
+ *     neighborhood changed are revisited, so work drains away as the labels
+ *     settle instead of sweeping the whole graph every round.
+ *   - Louvain: nodes greedily move to the neighboring community with the best
+ *     modularity gain, then every community is collapsed to a single node and
+ *     the process repeats on the smaller graph.
+ * Both operate on an undirected, optionally weighted snapshot built by
+ * graph_csr.h. Weights of neighbor communities are summed with a CsrAccum.
+ *
+ * === How to Use ===
+ * This header does no memory management. Label propagation needs a queue of
+ * num_nodes ints, num_nodes chars of queue flags and an accumulator whose
+ * capacity is a power of two at least twice the largest degree.
+ *
+ * Louvain keeps its coarse graphs and per-node state in a 'Louvain' workspace.
+ * Allocate LOUVAIN_INT_WORDS(n, m) ints and LOUVAIN_DOUBLE_WORDS(n, m) doubles,
+ * where n and m are the node and entry counts of the snapshot, plus an
+ * accumulator whose capacity is a power of two at least twice n. Hand them to
+ * 'graph_louvain_init' once and run 'graph_louvain' as many times as needed on
+ * snapshots no bigger than that.
+ *
+ * Neither algorithm spawns threads. Independent runs can proceed in parallel as
+ * long as each has its own workspace and accumulator.
+ *
+ * To split one run across workers, drive it in rounds instead. Each round has
+ * a parallel step that only reads the shared state and writes proposals for
+ * its own [lo, hi) range, with an accumulator per worker, and a serial step
+ * that commits them:
+ *   - Label propagation: start with every node in the frontier and labels set,
+ *     then sweep ranges of the frontier with 'graph_label_propagation_sweep'
+ *     and commit with 'graph_label_propagation_apply', which builds the next
+ *     frontier, until the frontier is empty.
+ *   - Louvain: 'graph_louvain_start', then per level propose moves for ranges
+ *     of nodes with 'graph_louvain_propose' and commit them with
+ *     'graph_louvain_apply' until a round moves nothing, then collapse the
+ *     level with 'graph_louvain_next_level'.
+ * A commit skips the proposal of a node next to one that changed earlier in
+ * the round, so neighbors never change together and can't swap back and
+ * forth. The node proposes again in the next round.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_COMMUNITY_H
+#define GRAPH_COMMUNITY_H
+
+#include "graph_csr.h"
+
+typedef struct LouvainTag Louvain;
+
+/*  a move must gain more than this much modularity (times 2m) to be taken  */
+#define LOUVAIN_MIN_GAIN 1e-12
+
+/*  workspace sizes for a snapshot with n nodes and m neighbor entries  */
+#define LOUVAIN_INT_WORDS(n, m) (2 * ((n) + 1) + 2 * (m) + 3 * (n))
+#define LOUVAIN_DOUBLE_WORDS(n, m) (2 * (m) + 2 * (n))
+
+static void graph_louvain_start(Louvain *lv, const CsrGraph *csr,
+                                int *membership);
+static int graph_louvain_next_level(Louvain *lv, int *membership);
+static double graph_modularity(const CsrGraph *csr, const int *membership,
+                               double *internal, double *total);
+static int graph_label_propagation_best(const CsrGraph *csr,
+                                        const int *labels, int node_id,
+                                        CsrAccum *acc);
+static void graph_louvain_level_init(Louvain *lv);
+static int graph_louvain_best(const Louvain *lv, int node_id, CsrAccum *acc);
+static int graph_louvain_move(Louvain *lv);
+static int graph_louvain_coarsen(Louvain *lv, const CsrGraph *level,
+                                 CsrGraph *coarse);
+
+/*
+ * A Louvain workspace.
+ *
+ * @coarse: Two buffers for coarse graphs. Each level is written to the buffer
+ *   the previous level was not read from.
+ * @graph: The snapshot being clustered.
+ * @level: The graph of the current level, @graph or a coarse graph.
+ * @buffer: Index of the coarse graph the next level is written to.
+ * @comm: Community of each node of the current level.
+ * @remap: Dense renumbering of the communities of the current level. Marks
+ *   the nodes next to a move while moves are committed.
+ * @order: Nodes of the current level grouped by community.
+ * @degree: Weighted degree of each node of the current level.
+ * @comm_total: Summed weighted degree of the nodes of each community.
+ * @acc: Accumulator for the weight from a node to each neighbor community.
+ * @two_m: Total weight of all neighbor entries of the graph being clustered.
+ * @levels: Number of levels built by the last run.
+ */
+struct LouvainTag
+{
+    CsrGraph coarse[2];
+    const CsrGraph *graph;
+    const CsrGraph *level;
+    int buffer;
+    int *comm;
+    int *remap;
+    int *order;
+    double *degree;
+    double *comm_total;
+    CsrAccum *acc;
+    double two_m;
+    int levels;
+};
+
+/*
+ * Detect communities by asynchronous label propagation.
+ * Every node starts with a label equal to its id unless @labels is seeded by
+ * the caller. Nodes are visited from a FIFO frontier. A visited node adopts
+ * the label of greatest summed edge weight among its neighbors; ties keep the
+ * current label if it is tied for best, otherwise the smallest label wins.
+ * When a node's label changes, its neighbors rejoin the frontier.
+ *
+ * @csr: Undirected snapshot. Weights are used if present.
+ * @labels: Array of csr->num_nodes ints. Receives the community labels.
+ * @seeded: Nonzero if @labels already holds starting labels to refine.
+ * @queue: Scratch array of csr->num_nodes ints.
+ * @queued: Scratch array of csr->num_nodes chars.
+ * @acc: Accumulator with capacity at least twice the largest degree.
+ * @max_visits: Stop after this many node visits, even if the frontier has not
+ *   drained. Guards against the rare label oscillations of asynchronous
+ *   updates.
+ * @return: The number of node visits made. Less than @max_visits means the
+ *   labels converged.
+ */
+static int graph_label_propagation(const CsrGraph *csr, int *labels,
+                                   int seeded, int *queue, char *queued,
+                                   CsrAccum *acc, int max_visits)
+{
+    int num_nodes;
+    int head;
+    int count;
+    int visits;
+    int node_id;
+    int entry;
+    int idx;
+    int best_label;
+
+    num_nodes = csr->num_nodes;
+    for (node_id = 0; node_id < num_nodes; node_id++)
+    {
+        if (!seeded)
+        {
+            labels[node_id] = node_id;
+        }
+        queue[node_id] = node_id;
+        queued[node_id] = 1;
+    }
+
+    /*  circular frontier, each node is in it at most once  */
+    head = 0;
+    count = num_nodes;
+    visits = 0;
+    while (count > 0 && visits < max_visits)
+    {
+        node_id = queue[head];
+        head = (head + 1 == num_nodes ? 0 : head + 1);
+        count--;
+        queued[node_id] = 0;
+        visits++;
+
+        best_label = graph_label_propagation_best(csr, labels, node_id, acc);
+        if (best_label == labels[node_id])
+        {
+            continue;
+        }
+
+        /*  the label changed, wake up the neighbors  */
+        labels[node_id] = best_label;
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            idx = csr->adj[entry];
+            if (!queued[idx])
+            {
+                queued[idx] = 1;
+                queue[(head + count) % num_nodes] = idx;
+                count++;
+            }
+        }
+    }
+
+    return visits;
+}
+
+/*
+ * Propose a label for each node in a range of a frontier, picked as
+ * 'graph_label_propagation' would. Labels are only read, so separate ranges
+ * can be swept by separate workers at once.
+ *
+ * @csr: Undirected snapshot. Weights are used if present.
+ * @labels: Current label of each node.
+ * @frontier: Ids of the nodes to visit this round.
+ * @lo: First position of @frontier to sweep.
+ * @hi: One past the last position of @frontier to sweep.
+ * @proposed: Array of a label per position of @frontier. Receives the
+ *   proposals of the range.
+ * @acc: Accumulator of this worker, with capacity at least twice the largest
+ *   degree.
+ * @return: The number of nodes in the range proposing a new label.
+ */
+static int graph_label_propagation_sweep(const CsrGraph *csr,
+                                         const int *labels,
+                                         const int *frontier, int lo, int hi,
+                                         int *proposed, CsrAccum *acc)
+{
+    int pos;
+    int changes;
+
+    changes = 0;
+    for (pos = lo; pos < hi; pos++)
+    {
+        proposed[pos] = graph_label_propagation_best(csr, labels,
+                                                     frontier[pos], acc);
+        if (proposed[pos] != labels[frontier[pos]])
+        {
+            changes++;
+        }
+    }
+
+    return changes;
+}
+
+/*
+ * Commit the proposals of a round of label propagation and build the next
+ * frontier from the neighbors of every changed node.
+ * A node already in the next frontier had a neighbor change earlier in the
+ * round, so its proposal is stale and skipped; it is visited again next
+ * round.
+ *
+ * @csr: Undirected snapshot.
+ * @labels: Label of each node. Receives the committed proposals.
+ * @frontier: Ids of the nodes visited this round.
+ * @proposed: Proposed label of each position of @frontier.
+ * @count: Number of nodes in @frontier.
+ * @next: Array of csr->num_nodes ints. Receives the next frontier. Must not
+ *   be @frontier.
+ * @queued: Array of csr->num_nodes chars, all zero. Left all zero.
+ * @return: The number of nodes in @next. 0 means the labels converged.
+ */
+static int graph_label_propagation_apply(const CsrGraph *csr, int *labels,
+                                         const int *frontier,
+                                         const int *proposed, int count,
+                                         int *next, char *queued)
+{
+    int pos;
+    int node_id;
+    int entry;
+    int num_next;
+
+    num_next = 0;
+    for (pos = 0; pos < count; pos++)
+    {
+        node_id = frontier[pos];
+        if (proposed[pos] == labels[node_id] || queued[node_id])
+        {
+            continue;
+        }
+
+        labels[node_id] = proposed[pos];
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (!queued[csr->adj[entry]])
+            {
+                queued[csr->adj[entry]] = 1;
+                next[num_next++] = csr->adj[entry];
+            }
+        }
+    }
+
+    for (pos = 0; pos < num_next; pos++)
+    {
+        queued[next[pos]] = 0;
+    }
+
+    return num_next;
+}
+
+/*
+ * Initialize a Louvain workspace.
+ *
+ * @acc: Accumulator with capacity at least twice @num_nodes.
+ * @int_buf: Array of LOUVAIN_INT_WORDS(@num_nodes, @num_entries) ints.
+ * @double_buf: Array of LOUVAIN_DOUBLE_WORDS(@num_nodes, @num_entries) doubles.
+ * @num_nodes: The most nodes a clustered snapshot will have.
+ * @num_entries: The most neighbor entries a clustered snapshot will have.
+ */
+static void graph_louvain_init(Louvain *lv, CsrAccum *acc, int *int_buf,
+                               double *double_buf, int num_nodes,
+                               int num_entries)
+{
+    int idx;
+
+    for (idx = 0; idx < 2; idx++)
+    {
+        lv->coarse[idx].num_nodes = 0;
+        lv->coarse[idx].num_entries = 0;
+        lv->coarse[idx].offsets = int_buf;
+        int_buf += num_nodes + 1;
+        lv->coarse[idx].adj = int_buf;
+        int_buf += num_entries;
+        lv->coarse[idx].weights = double_buf;
+        double_buf += num_entries;
+    }
+    lv->comm = int_buf;
+    lv->remap = int_buf + num_nodes;
+    lv->order = int_buf + 2 * num_nodes;
+    lv->degree = double_buf;
+    lv->comm_total = double_buf + num_nodes;
+    lv->graph = 0;
+    lv->level = 0;
+    lv->buffer = 0;
+    lv->acc = acc;
+    lv->two_m = 0.0;
+    lv->levels = 0;
+}
+
+/*
+ * Detect communities with the multi-level Louvain method.
+ * Each level moves nodes between communities until no move improves
+ * modularity, then collapses every community into one node of the next level.
+ * Runs stop when a level moves no node or @max_levels levels were built.
+ *
+ * @lv: Workspace initialized for at least the size of @csr.
+ * @csr: Undirected snapshot. Weights are used if present.
+ * @membership: Array of csr->num_nodes ints. Receives each node's community,
+ *   numbered densely from 0.
+ * @max_levels: The most levels to build.
+ * @return: The modularity of @membership.
+ */
+static double graph_louvain(Louvain *lv, const CsrGraph *csr, int *membership,
+                            int max_levels)
+{
+    graph_louvain_start(lv, csr, membership);
+    while (lv->levels < max_levels && lv->two_m > 0.0)
+    {
+        if (graph_louvain_move(lv) == 0)
+        {
+            /*  nothing moved, the previous level was final  */
+            break;
+        }
+        if (!graph_louvain_next_level(lv, membership))
+        {
+            break;
+        }
+    }
+
+    return graph_modularity(csr, membership, lv->degree, lv->comm_total);
+}
+
+/*
+ * Start a Louvain run to be driven a step at a time, with the snapshot as
+ * the first level and every node in its own community.
+ *
+ * @lv: Workspace initialized for at least the size of @csr.
+ * @csr: Undirected snapshot. Weights are used if present.
+ * @membership: Array of csr->num_nodes ints. Receives each node's community.
+ */
+static void graph_louvain_start(Louvain *lv, const CsrGraph *csr,
+                                int *membership)
+{
+    int node_id;
+    int entry;
+
+    lv->two_m = 0.0;
+    for (entry = 0; entry < csr->num_entries; entry++)
+    {
+        lv->two_m += graph_csr_weight(csr, entry);
+    }
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        membership[node_id] = node_id;
+    }
+
+    lv->graph = csr;
+    lv->level = csr;
+    lv->buffer = 0;
+    lv->levels = 0;
+    graph_louvain_level_init(lv);
+}
+
+/*
+ * Propose a move for each node in a range of the current level, to the
+ * neighboring community with the largest modularity gain. Communities are
+ * only read, so separate ranges can be proposed by separate workers at once.
+ *
+ * @lv: Workspace of a started run, with a graph that has edges.
+ * @acc: Accumulator of this worker, with capacity at least twice the number
+ *   of nodes.
+ * @lo: First node to propose for.
+ * @hi: One past the last node to propose for.
+ * @proposed: Array of lv->level->num_nodes ints. Receives the community
+ *   proposed for each node of the range, its own if it stays.
+ * @return: The number of nodes in the range proposing to move.
+ */
+static int graph_louvain_propose(const Louvain *lv, CsrAccum *acc, int lo,
+                                 int hi, int *proposed)
+{
+    int node_id;
+    int changes;
+
+    changes = 0;
+    for (node_id = lo; node_id < hi; node_id++)
+    {
+        proposed[node_id] = graph_louvain_best(lv, node_id, acc);
+        if (proposed[node_id] != lv->comm[node_id])
+        {
+            changes++;
+        }
+    }
+
+    return changes;
+}
+
+/*
+ * Commit the proposed moves of a round on the current level. A move is
+ * skipped if a neighbor of its node moved earlier in the round.
+ * CAUTION: the moves of a round were all weighed against the community
+ *   totals from before it, so a round can lose a little modularity and the
+ *   rounds of a level aren't sure to end. Cap them.
+ *
+ * @lv: Workspace of a started run.
+ * @proposed: Community proposed for each node of the current level.
+ * @return: The number of moves made. 0 means the level is final.
+ */
+static int graph_louvain_apply(Louvain *lv, const int *proposed)
+{
+    const CsrGraph *level;
+    int node_id;
+    int entry;
+    int moves;
+
+    level = lv->level;
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        lv->remap[node_id] = 0;
+    }
+
+    moves = 0;
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        if (proposed[node_id] == lv->comm[node_id] || lv->remap[node_id])
+        {
+            continue;
+        }
+
+        lv->comm_total[lv->comm[node_id]] -= lv->degree[node_id];
+        lv->comm_total[proposed[node_id]] += lv->degree[node_id];
+        lv->comm[node_id] = proposed[node_id];
+        moves++;
+        for (entry = level->offsets[node_id];
+             entry < level->offsets[node_id + 1]; entry++)
+        {
+            lv->remap[level->adj[entry]] = 1;
+        }
+    }
+
+    return moves;
+}
+
+/*
+ * Collapse the communities of the current level into the nodes of the next
+ * one, and follow each node of the snapshot to its new community.
+ *
+ * @lv: Workspace of a started run.
+ * @membership: Community of each node of the snapshot. Receives their
+ *   communities in the next level, numbered densely from 0.
+ * @return: Bool. 1 if the next level is ready, 0 if no communities merged
+ *   and the run is over.
+ */
+static int graph_louvain_next_level(Louvain *lv, int *membership)
+{
+    CsrGraph *coarse;
+    int node_id;
+    int num_comms;
+
+    lv->levels++;
+    coarse = &lv->coarse[lv->buffer];
+    num_comms = graph_louvain_coarsen(lv, lv->level, coarse);
+    for (node_id = 0; node_id < lv->graph->num_nodes; node_id++)
+    {
+        membership[node_id] = lv->remap[lv->comm[membership[node_id]]];
+    }
+
+    if (num_comms == lv->level->num_nodes)
+    {
+        return 0;
+    }
+    lv->level = coarse;
+    lv->buffer = 1 - lv->buffer;
+    graph_louvain_level_init(lv);
+
+    return 1;
+}
+
+/*
+ * Compute the modularity of a partition of a graph into communities.
+ *
+ * @csr: Undirected snapshot. Weights are used if present.
+ * @membership: Community of each node, in [0, csr->num_nodes).
+ * @internal: Scratch array of csr->num_nodes doubles.
+ * @total: Scratch array of csr->num_nodes doubles.
+ * @return: The modularity, in [-0.5, 1]. 0 if the graph has no edges.
+ */
+static double graph_modularity(const CsrGraph *csr, const int *membership,
+                               double *internal, double *total)
+{
+    int node_id;
+    int entry;
+    double two_m;
+    double weight;
+    double modularity;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        internal[node_id] = 0.0;
+        total[node_id] = 0.0;
+    }
+
+    two_m = 0.0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            weight = graph_csr_weight(csr, entry);
+            two_m += weight;
+            total[membership[node_id]] += weight;
+            if (membership[csr->adj[entry]] == membership[node_id])
+            {
+                internal[membership[node_id]] += weight;
+            }
+        }
+    }
+    if (two_m == 0.0)
+    {
+        return 0.0;
+    }
+
+    modularity = 0.0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        modularity += internal[node_id] / two_m -
+                      (total[node_id] / two_m) * (total[node_id] / two_m);
+    }
+
+    return modularity;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the label of greatest summed edge weight among a node's neighbors.
+ * Ties keep the node's label if it is tied for best, otherwise the smallest
+ * label wins.
+ *
+ * @return: The best label, the node's own if it has no neighbors.
+ */
+static int graph_label_propagation_best(const CsrGraph *csr,
+                                        const int *labels, int node_id,
+                                        CsrAccum *acc)
+{
+    int entry;
+    int slot;
+    int idx;
+    int best_label;
+    double best_weight;
+    double weight;
+
+    /*  sum the weight behind each neighboring label  */
+    for (entry = csr->offsets[node_id];
+         entry < csr->offsets[node_id + 1]; entry++)
+    {
+        graph_csr_accum_add(acc, labels[csr->adj[entry]],
+                            graph_csr_weight(csr, entry));
+    }
+
+    best_label = labels[node_id];
+    best_weight = graph_csr_accum_get(acc, best_label);
+    for (idx = 0; idx < acc->num_used; idx++)
+    {
+        slot = acc->used[idx];
+        weight = acc->vals[slot];
+        if (weight > best_weight ||
+            (weight == best_weight && acc->keys[slot] < best_label &&
+             best_label != labels[node_id]))
+        {
+            best_label = acc->keys[slot];
+            best_weight = weight;
+        }
+    }
+    graph_csr_accum_clear(acc);
+
+    return best_label;
+}
+
+/*
+ * Put every node of the current level in its own community.
+ */
+static void graph_louvain_level_init(Louvain *lv)
+{
+    const CsrGraph *level;
+    int node_id;
+    int entry;
+
+    level = lv->level;
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        lv->comm[node_id] = node_id;
+        lv->degree[node_id] = 0.0;
+        for (entry = level->offsets[node_id];
+             entry < level->offsets[node_id + 1]; entry++)
+        {
+            lv->degree[node_id] += graph_csr_weight(level, entry);
+        }
+        lv->comm_total[node_id] = lv->degree[node_id];
+    }
+}
+
+/*
+ * Find the neighboring community a node of the current level gains the most
+ * modularity by joining, weighed as if the node were out of its own.
+ *
+ * @return: The best community, the node's own if no move gains enough.
+ */
+static int graph_louvain_best(const Louvain *lv, int node_id, CsrAccum *acc)
+{
+    const CsrGraph *level;
+    int entry;
+    int neighbor;
+    int slot;
+    int idx;
+    int old_comm;
+    int best_comm;
+    double best_gain;
+    double gain;
+    double total;
+    double scale;
+
+    /*  weight from the node to each neighboring community  */
+    level = lv->level;
+    for (entry = level->offsets[node_id];
+         entry < level->offsets[node_id + 1]; entry++)
+    {
+        neighbor = level->adj[entry];
+        if (neighbor != node_id)
+        {
+            graph_csr_accum_add(acc, lv->comm[neighbor],
+                                graph_csr_weight(level, entry));
+        }
+    }
+
+    old_comm = lv->comm[node_id];
+    scale = lv->degree[node_id] / lv->two_m;
+    best_comm = old_comm;
+    best_gain = graph_csr_accum_get(acc, old_comm) -
+                (lv->comm_total[old_comm] - lv->degree[node_id]) * scale;
+    for (idx = 0; idx < acc->num_used; idx++)
+    {
+        slot = acc->used[idx];
+        total = lv->comm_total[acc->keys[slot]];
+        if (acc->keys[slot] == old_comm)
+        {
+            total -= lv->degree[node_id];
+        }
+        gain = acc->vals[slot] - total * scale;
+        if (gain > best_gain + LOUVAIN_MIN_GAIN)
+        {
+            best_comm = acc->keys[slot];
+            best_gain = gain;
+        }
+    }
+    graph_csr_accum_clear(acc);
+
+    return best_comm;
+}
+
+/*
+ * Run the local moving phase of the current Louvain level.
+ * Nodes are swept in id order, each moving to the neighboring community with
+ * the largest modularity gain as soon as it is found, until a sweep moves
+ * nothing.
+ *
+ * @return: The number of moves made.
+ */
+static int graph_louvain_move(Louvain *lv)
+{
+    int node_id;
+    int old_comm;
+    int best_comm;
+    int moves;
+    int sweep_moves;
+
+    moves = 0;
+    do
+    {
+        sweep_moves = 0;
+        for (node_id = 0; node_id < lv->level->num_nodes; node_id++)
+        {
+            old_comm = lv->comm[node_id];
+            best_comm = graph_louvain_best(lv, node_id, lv->acc);
+            if (best_comm != old_comm)
+            {
+                lv->comm_total[old_comm] -= lv->degree[node_id];
+                lv->comm_total[best_comm] += lv->degree[node_id];
+                lv->comm[node_id] = best_comm;
+                sweep_moves++;
+            }
+        }
+        moves += sweep_moves;
+    } while (sweep_moves > 0);
+
+    return moves;
+}
+
+/*
+ * Collapse the communities of a level into the nodes of a coarse graph.
+ * The weight between two communities is the summed weight of the entries
+ * between their members. Entries within a community become a self loop.
+ *
+ * @level: The graph of the current level. @lv->comm holds its communities.
+ * @coarse: Receives the coarse graph. Must not share storage with @level.
+ * @return: The number of communities. @lv->remap maps each community of the
+ *   level to its node in @coarse.
+ */
+static int graph_louvain_coarsen(Louvain *lv, const CsrGraph *level,
+                                 CsrGraph *coarse)
+{
+    CsrAccum *acc;
+    int num_comms;
+    int node_id;
+    int comm;
+    int idx;
+    int slot;
+    int pos;
+    int entry;
+    int write;
+
+    acc = lv->acc;
+
+    /*  number the communities densely  */
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        lv->remap[node_id] = -1;
+    }
+    num_comms = 0;
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        if (lv->remap[lv->comm[node_id]] == -1)
+        {
+            lv->remap[lv->comm[node_id]] = num_comms++;
+        }
+    }
+
+    /*  group the nodes by community with a counting sort  */
+    for (comm = 0; comm <= num_comms; comm++)
+    {
+        coarse->offsets[comm] = 0;
+    }
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        coarse->offsets[lv->remap[lv->comm[node_id]] + 1]++;
+    }
+    for (comm = 1; comm <= num_comms; comm++)
+    {
+        coarse->offsets[comm] += coarse->offsets[comm - 1];
+    }
+    for (node_id = 0; node_id < level->num_nodes; node_id++)
+    {
+        lv->order[coarse->offsets[lv->remap[lv->comm[node_id]]]++] = node_id;
+    }
+
+    /*  sum the entries leaving each community's members  */
+    write = 0;
+    pos = 0;
+    for (comm = 0; comm < num_comms; comm++)
+    {
+        for (; pos < coarse->offsets[comm]; pos++)
+        {
+            node_id = lv->order[pos];
+            for (entry = level->offsets[node_id];
+                 entry < level->offsets[node_id + 1]; entry++)
+            {
+                graph_csr_accum_add(acc,
+                    lv->remap[lv->comm[level->adj[entry]]],
+                    graph_csr_weight(level, entry));
+            }
+        }
+
+        /*  offsets[comm] was the fill cursor, it is now the row start  */
+        coarse->offsets[comm] = write;
+        for (idx = 0; idx < acc->num_used; idx++)
+        {
+            slot = acc->used[idx];
+            coarse->adj[write] = acc->keys[slot];
+            coarse->weights[write] = acc->vals[slot];
+            write++;
+        }
+        graph_csr_sort_row(coarse->adj + coarse->offsets[comm],
+                           coarse->weights + coarse->offsets[comm],
+                           write - coarse->offsets[comm]);
+        graph_csr_accum_clear(acc);
+    }
+    coarse->offsets[num_comms] = write;
+    coarse->num_nodes = num_comms;
+    coarse->num_entries = write;
+
+    return num_comms;
+}
+
+
+#endif
@@ -0,0 +1,391 @@
+/*
+ * Unit tests for the community detection header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_community.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+#define MAX_ENTRIES 64
+#define ACC_SIZE 32
+#define NUM_RANGES 3
+#define MAX_ROUNDS 100
+
+static void init_two_cliques(Graph *graph, Node *node_arr, CsrGraph *csr,
+                             int *offsets, int *adj);
+
+
+void test_label_propagation_two_cliques()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum acc;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int labels[INIT_SIZE];
+    int queue[INIT_SIZE];
+    char queued[INIT_SIZE];
+    int keys[ACC_SIZE], used[ACC_SIZE];
+    double vals[ACC_SIZE];
+    double weights[MAX_ENTRIES];
+    int idx;
+    int visits;
+
+    /* A light bridge keeps the first label to cross it from winning ties. */
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    for (idx = 0; idx < csr.num_entries; idx++)
+    {
+        weights[idx] = 1.0;
+    }
+    weights[graph_csr_find(&csr, 4, 5)] = 0.5;
+    weights[graph_csr_find(&csr, 5, 4)] = 0.5;
+    csr.weights = weights;
+    graph_csr_accum_init(&acc, keys, vals, used, ACC_SIZE);
+
+    visits = graph_label_propagation(&csr, labels, 0, queue, queued, &acc,
+                                     1000);
+
+    TEST_ASSERT_TRUE(visits < 1000);
+    for (idx = 1; idx < 5; idx++)
+    {
+        TEST_ASSERT_EQUAL(labels[0], labels[idx]);
+        TEST_ASSERT_EQUAL(labels[5], labels[5 + idx]);
+    }
+    TEST_ASSERT_TRUE(labels[0] != labels[5]);
+}
+
+void test_label_propagation_isolated_nodes()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum acc;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int labels[INIT_SIZE];
+    int queue[INIT_SIZE];
+    char queued[INIT_SIZE];
+    int keys[ACC_SIZE], used[ACC_SIZE];
+    double vals[ACC_SIZE];
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+    graph_csr_accum_init(&acc, keys, vals, used, ACC_SIZE);
+
+    /* One visit per node, nobody has neighbors to vote. */
+    TEST_ASSERT_EQUAL(INIT_SIZE, graph_label_propagation(&csr, labels, 0,
+                                                         queue, queued, &acc,
+                                                         1000));
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL(idx, labels[idx]);
+    }
+}
+
+void test_label_propagation_in_ranges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum accs[NUM_RANGES];
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int labels[INIT_SIZE];
+    int frontier[INIT_SIZE];
+    int next[INIT_SIZE];
+    int proposed[INIT_SIZE];
+    char queued[INIT_SIZE];
+    int keys[NUM_RANGES * ACC_SIZE], used[NUM_RANGES * ACC_SIZE];
+    double vals[NUM_RANGES * ACC_SIZE];
+    double weights[MAX_ENTRIES];
+    int count;
+    int rounds;
+    int range;
+    int idx;
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    for (idx = 0; idx < csr.num_entries; idx++)
+    {
+        weights[idx] = 1.0;
+    }
+    weights[graph_csr_find(&csr, 4, 5)] = 0.5;
+    weights[graph_csr_find(&csr, 5, 4)] = 0.5;
+    csr.weights = weights;
+    for (range = 0; range < NUM_RANGES; range++)
+    {
+        graph_csr_accum_init(&accs[range], &keys[range * ACC_SIZE],
+                             &vals[range * ACC_SIZE], &used[range * ACC_SIZE],
+                             ACC_SIZE);
+    }
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        labels[idx] = idx;
+        frontier[idx] = idx;
+        queued[idx] = 0;
+    }
+
+    /*  each range of the frontier is swept as a separate worker would  */
+    count = INIT_SIZE;
+    for (rounds = 0; count > 0 && rounds < MAX_ROUNDS; rounds++)
+    {
+        for (range = 0; range < NUM_RANGES; range++)
+        {
+            graph_label_propagation_sweep(&csr, labels, frontier,
+                                          count * range / NUM_RANGES,
+                                          count * (range + 1) / NUM_RANGES,
+                                          proposed, &accs[range]);
+        }
+        count = graph_label_propagation_apply(&csr, labels, frontier,
+                                              proposed, count, next, queued);
+        for (idx = 0; idx < count; idx++)
+        {
+            frontier[idx] = next[idx];
+        }
+    }
+
+    TEST_ASSERT_TRUE(rounds < MAX_ROUNDS);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL(0, queued[idx]);
+    }
+    for (idx = 1; idx < 5; idx++)
+    {
+        TEST_ASSERT_EQUAL(labels[0], labels[idx]);
+        TEST_ASSERT_EQUAL(labels[5], labels[5 + idx]);
+    }
+    TEST_ASSERT_TRUE(labels[0] != labels[5]);
+}
+
+void test_louvain_two_cliques()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum acc;
+    Louvain lv;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int membership[INIT_SIZE];
+    int int_buf[LOUVAIN_INT_WORDS(INIT_SIZE, MAX_ENTRIES)];
+    double double_buf[LOUVAIN_DOUBLE_WORDS(INIT_SIZE, MAX_ENTRIES)];
+    int keys[ACC_SIZE], used[ACC_SIZE];
+    double vals[ACC_SIZE];
+    double modularity;
+    int idx;
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    graph_csr_accum_init(&acc, keys, vals, used, ACC_SIZE);
+    graph_louvain_init(&lv, &acc, int_buf, double_buf, INIT_SIZE, MAX_ENTRIES);
+
+    modularity = graph_louvain(&lv, &csr, membership, 10);
+
+    for (idx = 1; idx < 5; idx++)
+    {
+        TEST_ASSERT_EQUAL(membership[0], membership[idx]);
+        TEST_ASSERT_EQUAL(membership[5], membership[5 + idx]);
+    }
+    TEST_ASSERT_TRUE(membership[0] != membership[5]);
+    TEST_ASSERT_TRUE(membership[0] < 2 && membership[5] < 2);
+    /* Two communities of 20 internal entries out of 42: 2 * (20/42 - 1/4). */
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 2.0 * (20.0 / 42.0 - 0.25), modularity);
+}
+
+void test_louvain_weighted_merges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum acc;
+    Louvain lv;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    double weights[MAX_ENTRIES];
+    int membership[INIT_SIZE];
+    int int_buf[LOUVAIN_INT_WORDS(INIT_SIZE, MAX_ENTRIES)];
+    double double_buf[LOUVAIN_DOUBLE_WORDS(INIT_SIZE, MAX_ENTRIES)];
+    int keys[ACC_SIZE], used[ACC_SIZE];
+    double vals[ACC_SIZE];
+    int idx;
+
+    /* A ring of 10 where every other edge is heavy pairs the nodes up. */
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+    for (idx = 0; idx < csr.num_entries; idx++)
+    {
+        weights[idx] = 1.0;
+    }
+    for (idx = 0; idx < INIT_SIZE; idx += 2)
+    {
+        weights[graph_csr_find(&csr, idx, idx + 1)] = 10.0;
+        weights[graph_csr_find(&csr, idx + 1, idx)] = 10.0;
+    }
+    csr.weights = weights;
+
+    graph_csr_accum_init(&acc, keys, vals, used, ACC_SIZE);
+    graph_louvain_init(&lv, &acc, int_buf, double_buf, INIT_SIZE, MAX_ENTRIES);
+    graph_louvain(&lv, &csr, membership, 1);
+
+    for (idx = 0; idx < INIT_SIZE; idx += 2)
+    {
+        TEST_ASSERT_EQUAL(membership[idx], membership[idx + 1]);
+        TEST_ASSERT_TRUE(membership[idx] != membership[(idx + 2) % INIT_SIZE]);
+    }
+    TEST_ASSERT_EQUAL(1, lv.levels);
+}
+
+void test_louvain_in_ranges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum acc;
+    CsrAccum accs[NUM_RANGES];
+    Louvain lv;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int membership[INIT_SIZE];
+    int proposed[INIT_SIZE];
+    int int_buf[LOUVAIN_INT_WORDS(INIT_SIZE, MAX_ENTRIES)];
+    double double_buf[LOUVAIN_DOUBLE_WORDS(INIT_SIZE, MAX_ENTRIES)];
+    int keys[(NUM_RANGES + 1) * ACC_SIZE], used[(NUM_RANGES + 1) * ACC_SIZE];
+    double vals[(NUM_RANGES + 1) * ACC_SIZE];
+    double internal[INIT_SIZE], total[INIT_SIZE];
+    int num_nodes;
+    int rounds;
+    int moves;
+    int range;
+    int idx;
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    for (range = 0; range < NUM_RANGES; range++)
+    {
+        graph_csr_accum_init(&accs[range], &keys[range * ACC_SIZE],
+                             &vals[range * ACC_SIZE], &used[range * ACC_SIZE],
+                             ACC_SIZE);
+    }
+    graph_csr_accum_init(&acc, &keys[NUM_RANGES * ACC_SIZE],
+                         &vals[NUM_RANGES * ACC_SIZE],
+                         &used[NUM_RANGES * ACC_SIZE], ACC_SIZE);
+    graph_louvain_init(&lv, &acc, int_buf, double_buf, INIT_SIZE, MAX_ENTRIES);
+
+    /*  each range of nodes proposes as a separate worker would  */
+    graph_louvain_start(&lv, &csr, membership);
+    do
+    {
+        rounds = 0;
+        do
+        {
+            num_nodes = lv.level->num_nodes;
+            for (range = 0; range < NUM_RANGES; range++)
+            {
+                graph_louvain_propose(&lv, &accs[range],
+                                      num_nodes * range / NUM_RANGES,
+                                      num_nodes * (range + 1) / NUM_RANGES,
+                                      proposed);
+            }
+            moves = graph_louvain_apply(&lv, proposed);
+            rounds++;
+        } while (moves > 0 && rounds < MAX_ROUNDS);
+        TEST_ASSERT_TRUE(rounds < MAX_ROUNDS);
+
+        /*  a level whose first round moved nothing was final  */
+    } while (rounds > 1 && graph_louvain_next_level(&lv, membership));
+
+    for (idx = 1; idx < 5; idx++)
+    {
+        TEST_ASSERT_EQUAL(membership[0], membership[idx]);
+        TEST_ASSERT_EQUAL(membership[5], membership[5 + idx]);
+    }
+    TEST_ASSERT_TRUE(membership[0] != membership[5]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 2.0 * (20.0 / 42.0 - 0.25),
+        graph_modularity(&csr, membership, internal, total));
+}
+
+void test_modularity_single_community()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int membership[INIT_SIZE];
+    double internal[INIT_SIZE], total[INIT_SIZE];
+    int idx;
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        membership[idx] = 0;
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0,
+        graph_modularity(&csr, membership, internal, total));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  propagate labels over two cliques joined by a bridge  */
+    RUN_TEST(test_label_propagation_two_cliques);
+    /*  propagate labels over a graph without edges  */
+    RUN_TEST(test_label_propagation_isolated_nodes);
+    /*  propagate labels over two cliques, sweeping the frontier in ranges  */
+    RUN_TEST(test_label_propagation_in_ranges);
+
+    /*  cluster two cliques joined by a bridge, verify modularity  */
+    RUN_TEST(test_louvain_two_cliques);
+    /*  cluster a weighted ring, verify heavy edges stay internal  */
+    RUN_TEST(test_louvain_weighted_merges);
+    /*  cluster two cliques with moves proposed in ranges  */
+    RUN_TEST(test_louvain_in_ranges);
+    /*  verify the modularity of the trivial partition is 0  */
+    RUN_TEST(test_modularity_single_community);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build two 5-cliques, {0..4} and {5..9}, joined by the edge 4-5, and take an
+ * undirected snapshot of them.
+ */
+static void init_two_cliques(Graph *graph, Node *node_arr, CsrGraph *csr,
+                             int *offsets, int *adj)
+{
+    int idx;
+    int from;
+    int to;
+
+    graph_init(graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (from = 0; from < 5; from++)
+    {
+        for (to = from + 1; to < 5; to++)
+        {
+            graph_add_edge(graph, from, to);
+            graph_add_edge(graph, from + 5, to + 5);
+        }
+    }
+    graph_add_edge(graph, 4, 5);
+
+    graph_csr_build(graph, csr, offsets, adj, 1);
+}
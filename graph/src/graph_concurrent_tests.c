@@ -0,0 +1,164 @@
+/*
+ * Stress tests for building a graph from several threads at once.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#define GRAPH_CAS_PTR(ptr, old, new) \
+    __sync_bool_compare_and_swap((ptr), (old), (new))
+#define GRAPH_ATOMIC_ADD(ptr, val) __sync_fetch_and_add((ptr), (val))
+#define GRAPH_ATOMIC_OR(ptr, val) __sync_fetch_and_or((ptr), (val))
+
+#include "graph.h"
+#include "../../deps/unity/unity.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#define INIT_SIZE 64
+#define NUM_THREADS 8
+#define EDGES_PER_NODE 200
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+
+static void *insert_worker(void *arg);
+static int count_edges(int from_id, int to_id);
+static int count_bucket_edges(int node_id);
+
+
+void test_serial_concurrent_calls()
+{
+    Bucket *bucket;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    TEST_ASSERT_EQUAL(1, graph_add_edge_concurrent(&graph, 0, 1));
+
+    bucket = malloc(sizeof(Bucket));
+    graph_add_bucket_concurrent(&graph, 0, bucket);
+    graph_add_bucket_concurrent(&graph, 0, malloc(sizeof(Bucket)));
+    TEST_ASSERT_EQUAL(bucket, node_arr[0].edges_out);
+    TEST_ASSERT_NOT_NULL(bucket->next);
+
+    TEST_ASSERT_EQUAL(0, graph_add_edge_concurrent(&graph, 0, 1));
+    TEST_ASSERT_EQUAL(0, graph_has_edge(&graph, 0, 1));
+}
+
+void test_threads_lose_no_edges()
+{
+    pthread_t threads[NUM_THREADS];
+    long thread_ids[NUM_THREADS];
+    int from_id, to_id;
+    int expected;
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < NUM_THREADS; idx++)
+    {
+        thread_ids[idx] = idx;
+        pthread_create(&threads[idx], 0, insert_worker, &thread_ids[idx]);
+    }
+    for (idx = 0; idx < NUM_THREADS; idx++)
+    {
+        pthread_join(threads[idx], 0);
+    }
+
+    /* Every thread adds edges from every node to the same targets. */
+    for (from_id = 0; from_id < INIT_SIZE; from_id++)
+    {
+        for (to_id = 0; to_id < INIT_SIZE; to_id++)
+        {
+            expected = 0;
+            for (idx = 0; idx < EDGES_PER_NODE; idx++)
+            {
+                expected += ((from_id + idx) % INIT_SIZE == to_id);
+            }
+            TEST_ASSERT_EQUAL(NUM_THREADS * expected,
+                              count_edges(from_id, to_id));
+        }
+        TEST_ASSERT_EQUAL(NUM_THREADS * EDGES_PER_NODE,
+                          node_arr[from_id].degree);
+        TEST_ASSERT_EQUAL(NUM_THREADS * EDGES_PER_NODE,
+                          count_bucket_edges(from_id));
+    }
+    TEST_ASSERT_EQUAL(NUM_THREADS * EDGES_PER_NODE * INIT_SIZE,
+                      graph.num_edges);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  call the concurrent operations from one thread  */
+    RUN_TEST(test_serial_concurrent_calls);
+    /*  build a graph from many threads, verify every edge landed once  */
+    RUN_TEST(test_threads_lose_no_edges);
+
+
+    UNITY_END();
+}
+
+/*
+ * Add EDGES_PER_NODE edges out of every node, adding buckets when full.
+ * All threads fill the same node at the same time, so both slots and bucket
+ * links contend.
+ */
+static void *insert_worker(void *arg)
+{
+    int thread_id;
+    int step;
+    int from_id;
+    int idx;
+
+    thread_id = (int)*(long *)arg;
+    for (step = 0; step < INIT_SIZE; step++)
+    {
+        for (idx = 0; idx < EDGES_PER_NODE; idx++)
+        {
+            from_id = (step + thread_id / 4) % INIT_SIZE;
+            while (graph_add_edge_concurrent(&graph, from_id,
+                                             (from_id + idx) % INIT_SIZE))
+            {
+                graph_add_bucket_concurrent(&graph, from_id,
+                                            malloc(sizeof(Bucket)));
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Count the copies of an edge, visiting only the slots marked live.
+ */
+static int count_edges(int from_id, int to_id)
+{
+    int count;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    count = 0;
+    GRAPH_FOR_EACH_OUT_EDGE(&node_arr[from_id], cursor, bits, adj_node)
+    {
+        count += (adj_node == &node_arr[to_id]);
+    }
+    return count;
+}
+
+/*
+ * Sum the edge counts of a node's buckets.
+ */
+static int count_bucket_edges(int node_id)
+{
+    int count;
+    Bucket *cursor;
+
+    count = 0;
+    for (cursor = node_arr[node_id].edges_out; cursor != 0;
+         cursor = cursor->next)
+    {
+        count += cursor->count;
+    }
+    return count;
+}
@@ -0,0 +1,451 @@
+/*
+ * A compact, read-only snapshot of a graph's adjacency (compressed sparse row).
+ *
+ * The bucket chains of graph.h are good at absorbing edge insertions and
+ * deletions, but every traversal over them follows a pointer per bucket and
+ * reads every slot, live or not. Algorithms that sweep the whole graph many
+ * times are better served by a flattened copy: one array of row offsets and one
+ * array of neighbor ids. This header builds that copy and provides the small
+ * utilities that the graph algorithm headers share.
+ *
+ * === How to Use ===
+ * Like graph.h, this header does no memory management. Building a snapshot is
+ * done in two steps:
+ *   1. Call 'graph_csr_count' to learn how many neighbor entries the snapshot
+ *      may need, and allocate an int array of that size along with an int
+ *      array of size (graph->size + 1) for the row offsets.
+ *   2. Call 'graph_csr_build' with those arrays.
+ * Rows in the snapshot are sorted by neighbor id and contain no duplicates, so
+ * neighbor lists can be binary searched and intersected. In undirected mode
+ * every edge is stored in both directions and self loops are dropped.
+ *
+ * Snapshots are unweighted after building. To attach weights allocate a double
+ * array with one entry per neighbor entry, fill it, and point @weights at it.
+ * Algorithms treat a null @weights as every edge having weight 1.
+ *
+ * The snapshot is not updated when its graph changes; rebuild it instead.
+ *
+ * === Accumulators ===
+ * Many algorithms need to sum values by key for the neighbors of one node
+ * (votes per label, weight per community, paths per endpoint). 'CsrAccum' is a
+ * small open-addressing hash table for that purpose. It remembers which slots
+ * it used so clearing it costs only as much as the keys that were added. Keep
+ * one accumulator per thread of work.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+
+#include "graph.h"
+
+typedef struct CsrGraphTag CsrGraph;
+typedef struct CsrAccumTag CsrAccum;
+
+static void graph_csr_sort_row(int *row, double *weights, int len);
+static int graph_csr_accum_slot(const CsrAccum *acc, int key);
+static void graph_csr_swap_entries(int *row, double *weights, int left,
+                                   int right);
+
+/*
+ * A compact adjacency snapshot.
+ * The neighbors of node u are adj[offsets[u]] .. adj[offsets[u + 1] - 1].
+ *
+ * @num_nodes: Number of nodes. Node ids are in [0, num_nodes).
+ * @num_entries: Number of neighbor entries, equal to offsets[num_nodes].
+ * @offsets: Row offsets. Has num_nodes + 1 entries.
+ * @adj: Neighbor ids, sorted within each row.
+ * @weights: Weight of each neighbor entry, parallel to @adj. May be null.
+ */
+struct CsrGraphTag
+{
+    int num_nodes;
+    int num_entries;
+    int *offsets;
+    int *adj;
+    double *weights;
+};
+
+/*
+ * A hash accumulator mapping non-negative int keys to summed double values.
+ * CAUTION: @capacity must be a power of two larger than the number of distinct
+ * keys added between clears. Twice that number keeps probe chains short.
+ *
+ * @capacity: Number of slots.
+ * @keys: Key of each slot, -1 if the slot is empty.
+ * @vals: Accumulated value of each slot.
+ * @used: Indices of the slots in use, in the order they were first used.
+ * @num_used: Number of slots in use.
+ */
+struct CsrAccumTag
+{
+    int capacity;
+    int *keys;
+    double *vals;
+    int *used;
+    int num_used;
+};
+
+/*
+ * Count the neighbor entries a snapshot of a graph may need.
+ * The count is an upper bound: duplicates and self loops removed by
+ * 'graph_csr_build' are included.
+ *
+ * @undirected: Nonzero to count entries for an undirected snapshot.
+ * @return: The number of ints to allocate for the snapshot's @adj array.
+ */
+static int graph_csr_count(Graph *graph, int undirected)
+{
+    int node_id;
+    int count;
+    Bucket *cursor;
+
+    count = 0;
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        for (cursor = graph->nodes[node_id].edges_out; cursor != 0;
+             cursor = cursor->next)
+        {
+            count += (undirected ? 2 : 1) * cursor->count;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Build a compact snapshot of a graph.
+ *
+ * @csr: The snapshot to build. Its @weights will be null.
+ * @offsets: Array for the row offsets. Must hold graph->size + 1 ints.
+ * @adj: Array for the neighbor ids. Must hold 'graph_csr_count' ints.
+ * @undirected: Nonzero to store every edge in both directions and drop self
+ *   loops. Zero to store edges as they are.
+ */
+static void graph_csr_build(Graph *graph, CsrGraph *csr, int *offsets,
+                            int *adj, int undirected)
+{
+    int node_id;
+    int to_id;
+    int read;
+    int write;
+    int row_start;
+    int row_end;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    csr->num_nodes = graph->size;
+    csr->offsets = offsets;
+    csr->adj = adj;
+    csr->weights = 0;
+
+    /*  count the entries of each row, shifted up by one  */
+    for (node_id = 0; node_id <= graph->size; node_id++)
+    {
+        offsets[node_id] = 0;
+    }
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            to_id = adj_node->id;
+            if (!undirected)
+            {
+                offsets[node_id + 1]++;
+            }
+            else if (to_id != node_id)
+            {
+                offsets[node_id + 1]++;
+                offsets[to_id + 1]++;
+            }
+        }
+    }
+
+    /*  turn the counts into row starts, then use offsets[u] as a fill cursor  */
+    for (node_id = 1; node_id <= graph->size; node_id++)
+    {
+        offsets[node_id] += offsets[node_id - 1];
+    }
+    for (node_id = graph->size; node_id > 0; node_id--)
+    {
+        offsets[node_id] = offsets[node_id - 1];
+    }
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            to_id = adj_node->id;
+            if (!undirected)
+            {
+                adj[offsets[node_id + 1]++] = to_id;
+            }
+            else if (to_id != node_id)
+            {
+                adj[offsets[node_id + 1]++] = to_id;
+                adj[offsets[to_id + 1]++] = node_id;
+            }
+        }
+    }
+
+    /*  sort each row and squeeze out duplicate entries  */
+    write = 0;
+    row_start = 0;
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        row_end = offsets[node_id + 1];
+        graph_csr_sort_row(adj + row_start, 0, row_end - row_start);
+        offsets[node_id] = write;
+        for (read = row_start; read < row_end; read++)
+        {
+            if (read == row_start || adj[read] != adj[read - 1])
+            {
+                adj[write++] = adj[read];
+            }
+        }
+        row_start = row_end;
+    }
+    offsets[graph->size] = write;
+    csr->num_entries = write;
+}
+
+/*
+ * Get the number of neighbors of a node in a snapshot.
+ *
+ * @node_id: Id of the node. Assumed to be valid.
+ */
+static int graph_csr_degree(const CsrGraph *csr, int node_id)
+{
+    return csr->offsets[node_id + 1] - csr->offsets[node_id];
+}
+
+/*
+ * Find the position of a neighbor entry with a binary search.
+ *
+ * @from_id: Id of the node whose row is searched. Assumed to be valid.
+ * @to_id: The neighbor id to find.
+ * @return: Index of the entry in @adj, or -1 if @to_id is not a neighbor.
+ */
+static int graph_csr_find(const CsrGraph *csr, int from_id, int to_id)
+{
+    int low;
+    int high;
+    int mid;
+
+    low = csr->offsets[from_id];
+    high = csr->offsets[from_id + 1];
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        if (csr->adj[mid] < to_id)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    if (low < csr->offsets[from_id + 1] && csr->adj[low] == to_id)
+    {
+        return low;
+    }
+    return -1;
+}
+
+/*
+ * Get the weight of a neighbor entry.
+ *
+ * @entry: Index of the entry in @adj.
+ * @return: The entry's weight, or 1 if the snapshot is unweighted.
+ */
+static double graph_csr_weight(const CsrGraph *csr, int entry)
+{
+    return (csr->weights == 0 ? 1.0 : csr->weights[entry]);
+}
+
+
+/* === ACCUMULATOR === */
+
+/*
+ * Initialize an empty accumulator.
+ *
+ * @keys: Array of @capacity ints.
+ * @vals: Array of @capacity doubles.
+ * @used: Array of @capacity ints.
+ * @capacity: Number of slots. Must be a power of two.
+ */
+static void graph_csr_accum_init(CsrAccum *acc, int *keys, double *vals,
+                                 int *used, int capacity)
+{
+    int idx;
+
+    acc->capacity = capacity;
+    acc->keys = keys;
+    acc->vals = vals;
+    acc->used = used;
+    acc->num_used = 0;
+
+    for (idx = 0; idx < capacity; idx++)
+    {
+        keys[idx] = -1;
+    }
+}
+
+/*
+ * Add a value to a key's sum.
+ *
+ * @key: Non-negative key.
+ * @val: Value to add to the key's sum. The sum starts at 0.
+ * @return: Index of the key's slot.
+ */
+static int graph_csr_accum_add(CsrAccum *acc, int key, double val)
+{
+    int slot;
+
+    slot = graph_csr_accum_slot(acc, key);
+    while (acc->keys[slot] != key)
+    {
+        if (acc->keys[slot] == -1)
+        {
+            acc->keys[slot] = key;
+            acc->vals[slot] = 0.0;
+            acc->used[acc->num_used++] = slot;
+            break;
+        }
+        slot = (slot + 1) & (acc->capacity - 1);
+    }
+
+    acc->vals[slot] += val;
+    return slot;
+}
+
+/*
+ * Get a key's sum.
+ *
+ * @return: The sum added under @key, or 0 if the key was never added.
+ */
+static double graph_csr_accum_get(const CsrAccum *acc, int key)
+{
+    int slot;
+
+    slot = graph_csr_accum_slot(acc, key);
+    while (acc->keys[slot] != -1)
+    {
+        if (acc->keys[slot] == key)
+        {
+            return acc->vals[slot];
+        }
+        slot = (slot + 1) & (acc->capacity - 1);
+    }
+
+    return 0.0;
+}
+
+/*
+ * Remove every key from an accumulator.
+ * O(number of keys added since the last clear).
+ */
+static void graph_csr_accum_clear(CsrAccum *acc)
+{
+    int idx;
+
+    for (idx = 0; idx < acc->num_used; idx++)
+    {
+        acc->keys[acc->used[idx]] = -1;
+    }
+    acc->num_used = 0;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the first slot to probe for a key in an accumulator.
+ * Multiplicative hashing folded onto itself, so small and large capacities
+ * both see well mixed bits. Collisions are resolved by linear probing.
+ */
+static int graph_csr_accum_slot(const CsrAccum *acc, int key)
+{
+    unsigned long hash;
+
+    hash = ((unsigned long)key * 2654435761UL) & 0xFFFFFFFFUL;
+    hash ^= hash >> 15;
+    return (int)(hash & (unsigned long)(acc->capacity - 1));
+}
+
+/*
+ * Sort a row of neighbor ids in ascending order.
+ * Heapsort, so hub rows sort in O(d log d) without recursion or scratch space.
+ *
+ * @row: The ids to sort.
+ * @weights: Weights parallel to @row, moved along with their ids. May be null.
+ * @len: Number of ids in @row.
+ */
+static void graph_csr_sort_row(int *row, double *weights, int len)
+{
+    int start;
+    int end;
+    int root;
+    int child;
+
+    if (len < 2)
+    {
+        return;
+    }
+
+    /*  heapify, then repeatedly move the max to the end  */
+    for (start = len / 2 - 1, end = len; end > 1; )
+    {
+        if (start >= 0)
+        {
+            root = start--;
+        }
+        else
+        {
+            end--;
+            graph_csr_swap_entries(row, weights, 0, end);
+            root = 0;
+        }
+
+        /*  sift the root down  */
+        while ((child = 2 * root + 1) < end)
+        {
+            if (child + 1 < end && row[child + 1] > row[child])
+            {
+                child++;
+            }
+            if (row[root] >= row[child])
+            {
+                break;
+            }
+            graph_csr_swap_entries(row, weights, root, child);
+            root = child;
+        }
+    }
+}
+
+/*
+ * Swap two entries of a row, along with their weights if there are any.
+ */
+static void graph_csr_swap_entries(int *row, double *weights, int left,
+                                   int right)
+{
+    int tmp;
+    double tmp_weight;
+
+    tmp = row[left];
+    row[left] = row[right];
+    row[right] = tmp;
+    if (weights != 0)
+    {
+        tmp_weight = weights[left];
+        weights[left] = weights[right];
+        weights[right] = tmp_weight;
+    }
+}
+
+#endif
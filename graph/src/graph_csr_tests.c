@@ -0,0 +1,205 @@
+/*
+ * Unit tests for the compact graph snapshot header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_csr.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+
+static void init_graph(Graph *graph, Node *node_arr, int buckets_per_node);
+
+
+void test_build_directed()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    int offsets[INIT_SIZE + 1];
+    int adj[64];
+
+    init_graph(&graph, node_arr, 1);
+    graph_add_edge(&graph, 0, 3);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 4, 0);
+
+    TEST_ASSERT_EQUAL(4, graph_csr_count(&graph, 0));
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+
+    TEST_ASSERT_EQUAL(INIT_SIZE, csr.num_nodes);
+    TEST_ASSERT_EQUAL(4, csr.num_entries);
+    TEST_ASSERT_EQUAL(3, graph_csr_degree(&csr, 0));
+    TEST_ASSERT_EQUAL(0, graph_csr_degree(&csr, 1));
+    TEST_ASSERT_EQUAL(1, graph_csr_degree(&csr, 4));
+    /* Rows come out sorted. */
+    TEST_ASSERT_EQUAL(1, adj[0]);
+    TEST_ASSERT_EQUAL(2, adj[1]);
+    TEST_ASSERT_EQUAL(3, adj[2]);
+    TEST_ASSERT_EQUAL(0, adj[3]);
+    TEST_ASSERT_EQUAL(NULL, csr.weights);
+}
+
+void test_build_undirected_dedupes()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    int offsets[INIT_SIZE + 1];
+    int adj[64];
+
+    init_graph(&graph, node_arr, 1);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 1, 0);
+    graph_add_edge(&graph, 1, 2);
+    graph_add_edge(&graph, 1, 2);
+    graph_add_edge(&graph, 3, 3);
+
+    TEST_ASSERT_EQUAL(10, graph_csr_count(&graph, 1));
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    /* Both directions of 0-1 collapse, the double 1-2 collapses, no loop. */
+    TEST_ASSERT_EQUAL(4, csr.num_entries);
+    TEST_ASSERT_EQUAL(1, graph_csr_degree(&csr, 0));
+    TEST_ASSERT_EQUAL(2, graph_csr_degree(&csr, 1));
+    TEST_ASSERT_EQUAL(1, graph_csr_degree(&csr, 2));
+    TEST_ASSERT_EQUAL(0, graph_csr_degree(&csr, 3));
+}
+
+void test_build_skips_deleted_edges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    int offsets[INIT_SIZE + 1];
+    int adj[64];
+    int idx;
+
+    /* Spill node 0 into a second bucket, then punch holes in the first. */
+    init_graph(&graph, node_arr, 2);
+    for (idx = 0; idx < BUCKET_SIZE + 2; idx++)
+    {
+        graph_add_edge(&graph, 0, idx % INIT_SIZE);
+    }
+    graph_del_edge(&graph, 0, 5);
+    graph_del_edge(&graph, 0, 6);
+
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+
+    TEST_ASSERT_EQUAL(INIT_SIZE - 2, csr.num_entries);
+    TEST_ASSERT_EQUAL(-1, graph_csr_find(&csr, 0, 5));
+    TEST_ASSERT_EQUAL(-1, graph_csr_find(&csr, 0, 6));
+    TEST_ASSERT_EQUAL(0, graph_csr_find(&csr, 0, 0));
+    TEST_ASSERT_EQUAL(7, graph_csr_find(&csr, 0, 9));
+}
+
+void test_weights_default_to_one()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    int offsets[INIT_SIZE + 1];
+    int adj[64];
+    double weights[64];
+
+    init_graph(&graph, node_arr, 1);
+    graph_add_edge(&graph, 2, 3);
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+
+    TEST_ASSERT_EQUAL_FLOAT(1.0, graph_csr_weight(&csr, 0));
+    weights[0] = 2.5;
+    csr.weights = weights;
+    TEST_ASSERT_EQUAL_FLOAT(2.5, graph_csr_weight(&csr, 0));
+}
+
+void test_sort_row_carries_weights()
+{
+    int row[6] = { 5, 1, 4, 1, 0, 3 };
+    double weights[6] = { 5.0, 1.0, 4.0, 1.0, 0.0, 3.0 };
+    int idx;
+
+    graph_csr_sort_row(row, weights, 6);
+
+    for (idx = 1; idx < 6; idx++)
+    {
+        TEST_ASSERT_TRUE(row[idx - 1] <= row[idx]);
+    }
+    for (idx = 0; idx < 6; idx++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT((double)row[idx], weights[idx]);
+    }
+}
+
+void test_accum_sums_and_clears()
+{
+    CsrAccum acc;
+    int keys[16];
+    double vals[16];
+    int used[16];
+    int idx;
+
+    graph_csr_accum_init(&acc, keys, vals, used, 16);
+    for (idx = 0; idx < 40; idx++)
+    {
+        graph_csr_accum_add(&acc, idx % 5, 1.0);
+    }
+    graph_csr_accum_add(&acc, 1000000, 0.5);
+
+    TEST_ASSERT_EQUAL(6, acc.num_used);
+    TEST_ASSERT_EQUAL_FLOAT(8.0, graph_csr_accum_get(&acc, 3));
+    TEST_ASSERT_EQUAL_FLOAT(0.5, graph_csr_accum_get(&acc, 1000000));
+    TEST_ASSERT_EQUAL_FLOAT(0.0, graph_csr_accum_get(&acc, 7));
+
+    graph_csr_accum_clear(&acc);
+    TEST_ASSERT_EQUAL(0, acc.num_used);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, graph_csr_accum_get(&acc, 3));
+    for (idx = 0; idx < 16; idx++)
+    {
+        TEST_ASSERT_EQUAL(-1, keys[idx]);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  snapshot a directed graph, verify sorted rows  */
+    RUN_TEST(test_build_directed);
+    /*  snapshot an undirected graph, verify duplicates and loops are gone  */
+    RUN_TEST(test_build_undirected_dedupes);
+    /*  snapshot a graph with deleted edges across buckets  */
+    RUN_TEST(test_build_skips_deleted_edges);
+    /*  verify unweighted snapshots report unit weights  */
+    RUN_TEST(test_weights_default_to_one);
+    /*  sort a row with weights, verify weights follow their ids  */
+    RUN_TEST(test_sort_row_carries_weights);
+
+    /*  add keys to an accumulator, verify sums and clearing  */
+    RUN_TEST(test_accum_sums_and_clears);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize a graph of INIT_SIZE nodes with a number of buckets per node.
+ */
+static void init_graph(Graph *graph, Node *node_arr, int buckets_per_node)
+{
+    int idx;
+    int cnt;
+
+    graph_init(graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        for (cnt = 0; cnt < buckets_per_node; cnt++)
+        {
+            graph_add_bucket(graph, idx, malloc(sizeof(Bucket)));
+        }
+    }
+}
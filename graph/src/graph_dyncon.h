@@ -0,0 +1,629 @@
+/*
+ * Connectivity of an undirected graph under edge insertions and deletions.
+ * See Henzinger and King, "Randomized Fully Dynamic Graph Algorithms with
+ * Polylogarithmic Time per Operation" (1999) for the theory.
+ *
+ * Recomputing connected components after every deleted edge costs a pass over
+ * the whole graph. This header keeps a spanning forest of the graph instead,
+ * with each tree stored as its Euler tour: the sequence of nodes and directed
+ * tree edges met walking around the tree. Tours are kept in treaps, balanced
+ * binary trees ordered by position, so that:
+ *   - Two nodes are connected if their tours have the same treap root, a walk
+ *     up of expected O(log n) steps.
+ *   - Adding an edge between two trees rotates both tours to start at the
+ *     edge's ends and concatenates them around the edge. O(log n).
+ *   - Deleting an edge that isn't in the forest changes nothing. Deleting a
+ *     tree edge cuts its tour into two, and then the smaller of the two trees
+ *     is searched for an edge leading out of it to reconnect them.
+ * Holm, de Lichtenberg and Thorup also give every edge a level so that no edge
+ * is searched more than O(log n) times, for amortized polylog deletions in the
+ * worst case. That bookkeeping is left out here; searching only the smaller
+ * side keeps deletions cheap as long as they rarely split large components,
+ * which is the common case for networks with redundant links.
+ *
+ * === How to Use ===
+ * This header does no memory management. Allocate an int array of
+ * 'graph_dyncon_int_words' ints and call 'graph_dyncon_init', which finds a
+ * spanning forest of the edges already in the graph. From then on add and
+ * delete edges with 'graph_dyncon_add_edge' and 'graph_dyncon_del_edge'
+ * instead of the graph.h functions. They store every edge in both directions,
+ * so a replacement search sees all edges of a node by following its edges out;
+ * edges already in the graph must be stored both ways too.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_DYNCON_H
+#define GRAPH_DYNCON_H
+
+#include "graph.h"
+#include "graph_rng.h"
+
+typedef struct DynConTag DynCon;
+
+static int graph_dyncon_capacity(int size);
+static void graph_dyncon_link(DynCon *dc, int left_id, int right_id);
+static void graph_dyncon_cut(DynCon *dc, int pair);
+static int graph_dyncon_replace(Graph *graph, DynCon *dc, int left_id,
+                                int right_id);
+static int graph_dyncon_reroot(DynCon *dc, int node_id);
+static int graph_dyncon_root(const DynCon *dc, int item);
+static int graph_dyncon_position(const DynCon *dc, int item);
+static int graph_dyncon_merge(DynCon *dc, int left, int right);
+static void graph_dyncon_split(DynCon *dc, int item, int count, int *left,
+                               int *right);
+static void graph_dyncon_update(DynCon *dc, int item);
+static int graph_dyncon_slot(const DynCon *dc, int left_id, int right_id);
+static void graph_dyncon_unmap(DynCon *dc, int slot);
+
+/*
+ * A spanning forest kept as Euler tours in treaps.
+ * Treap items 0 to size - 1 stand for the nodes, and items size + 2p and
+ * size + 2p + 1 for the two directions of the tree edge in pair p.
+ *
+ * @size: Number of nodes.
+ * @num_components: Number of connected components.
+ * @scanned: Number of edges looked at by replacement searches, for tuning.
+ * @left: Left child of each item, -1 if none.
+ * @right: Right child of each item, -1 if none.
+ * @parent: Parent of each item, -1 for treap roots.
+ * @prio: Heap priority of each item.
+ * @items: Number of items in the treap under each item.
+ * @nodes: Number of node items in the treap under each item.
+ * @free_pairs: Stack of unused edge pairs.
+ * @num_free: Number of pairs on @free_pairs.
+ * @capacity: Number of slots of the tree edge table, a power of two.
+ * @slot_lo: Smaller node id of the tree edge in each slot, -1 if empty.
+ * @slot_hi: Larger node id of the tree edge in each slot.
+ * @slot_pair: Pair of the tree edge in each slot.
+ */
+struct DynConTag
+{
+    int size;
+    int num_components;
+    long scanned;
+    int *left;
+    int *right;
+    int *parent;
+    int *prio;
+    int *items;
+    int *nodes;
+    int *free_pairs;
+    int num_free;
+    int capacity;
+    int *slot_lo;
+    int *slot_hi;
+    int *slot_pair;
+};
+
+
+/*
+ * Determine how many ints 'graph_dyncon_init' needs for a graph.
+ *
+ * @size: Number of nodes in the graph.
+ */
+static long graph_dyncon_int_words(int size)
+{
+    return 19L * size + 3L * graph_dyncon_capacity(size);
+}
+
+/*
+ * Find a spanning forest of a graph.
+ *
+ * @graph: The graph, with every edge stored in both directions.
+ * @int_buf: Array of 'graph_dyncon_int_words' ints.
+ */
+static void graph_dyncon_init(Graph *graph, DynCon *dc, int *int_buf)
+{
+    int size;
+    int item;
+    int node_id;
+    int slot;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    size = graph->size;
+    dc->size = size;
+    dc->num_components = size;
+    dc->scanned = 0;
+    dc->left = int_buf;
+    dc->right = dc->left + 3 * size;
+    dc->parent = dc->right + 3 * size;
+    dc->prio = dc->parent + 3 * size;
+    dc->items = dc->prio + 3 * size;
+    dc->nodes = dc->items + 3 * size;
+    dc->free_pairs = dc->nodes + 3 * size;
+    dc->capacity = graph_dyncon_capacity(size);
+    dc->slot_lo = dc->free_pairs + size;
+    dc->slot_hi = dc->slot_lo + dc->capacity;
+    dc->slot_pair = dc->slot_hi + dc->capacity;
+
+    for (item = 0; item < 3 * size; item++)
+    {
+        dc->left[item] = -1;
+        dc->right[item] = -1;
+        dc->parent[item] = -1;
+        dc->prio[item] = (int)(graph_rng_hash(0x5EED, (unsigned long)item) >>
+                               1);
+        dc->items[item] = 1;
+        dc->nodes[item] = (item < size ? 1 : 0);
+    }
+    dc->num_free = 0;
+    for (item = size - 1; item >= 0; item--)
+    {
+        dc->free_pairs[dc->num_free++] = item;
+    }
+    for (slot = 0; slot < dc->capacity; slot++)
+    {
+        dc->slot_lo[slot] = -1;
+    }
+
+    for (node_id = 0; node_id < size; node_id++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            if (graph_dyncon_root(dc, node_id) !=
+                graph_dyncon_root(dc, adj_node->id))
+            {
+                graph_dyncon_link(dc, node_id, adj_node->id);
+            }
+        }
+    }
+}
+
+/*
+ * Determine if two nodes are connected.
+ *
+ * @return: Bool. 1 if there is a path between the nodes, 0 if not.
+ */
+static int graph_dyncon_connected(const DynCon *dc, int left_id, int right_id)
+{
+    return graph_dyncon_root(dc, left_id) == graph_dyncon_root(dc, right_id);
+}
+
+/*
+ * Get the number of nodes connected to a node, counting itself.
+ */
+static int graph_dyncon_component_size(const DynCon *dc, int node_id)
+{
+    return dc->nodes[graph_dyncon_root(dc, node_id)];
+}
+
+/*
+ * Add an undirected edge to a graph, stored in both directions.
+ *
+ * @left_id: The id of one end. Assumed to be valid.
+ * @right_id: The id of the other end. Assumed to be valid.
+ * @return: 0 if the edge was added, 1 if there wasn't enough space for both
+ *   directions. The graph is unchanged unless 0 is returned.
+ */
+static int graph_dyncon_add_edge(Graph *graph, DynCon *dc, int left_id,
+                                 int right_id)
+{
+    if (graph_add_edge(graph, left_id, right_id) != 0)
+    {
+        return 1;
+    }
+    if (left_id != right_id &&
+        graph_add_edge(graph, right_id, left_id) != 0)
+    {
+        graph_del_edge(graph, left_id, right_id);
+        return 1;
+    }
+
+    if (!graph_dyncon_connected(dc, left_id, right_id))
+    {
+        graph_dyncon_link(dc, left_id, right_id);
+    }
+    return 0;
+}
+
+/*
+ * Delete an undirected edge from a graph, in both directions. If the edge was
+ * in the spanning forest, search for another edge to take its place.
+ *
+ * @left_id: The id of one end. Assumed to be valid.
+ * @right_id: The id of the other end. Assumed to be valid.
+ * @return: 0 if the nodes are still connected, 1 if deleting the edge split
+ *   their component, 2 if there was no such edge.
+ */
+static int graph_dyncon_del_edge(Graph *graph, DynCon *dc, int left_id,
+                                 int right_id)
+{
+    int slot;
+    int pair;
+
+    if (graph_has_edge(graph, left_id, right_id) != 0)
+    {
+        return 2;
+    }
+    graph_del_edge(graph, left_id, right_id);
+    if (left_id == right_id)
+    {
+        return 0;
+    }
+    graph_del_edge(graph, right_id, left_id);
+
+    /*  a parallel copy of the edge keeps its place in the forest  */
+    slot = graph_dyncon_slot(dc, left_id, right_id);
+    if (dc->slot_lo[slot] < 0 || graph_has_edge(graph, left_id, right_id) == 0)
+    {
+        return 0;
+    }
+
+    pair = dc->slot_pair[slot];
+    graph_dyncon_unmap(dc, slot);
+    graph_dyncon_cut(dc, pair);
+    return graph_dyncon_replace(graph, dc, left_id, right_id);
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Get the number of slots of the tree edge table: the smallest power of two
+ * at least twice the largest number of tree edges.
+ */
+static int graph_dyncon_capacity(int size)
+{
+    int capacity;
+
+    capacity = 1;
+    while (capacity < 2 * size)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/*
+ * Join the trees of two nodes that aren't connected with a tree edge between
+ * them: their tours, rotated to start at the nodes, are concatenated around
+ * the two directions of the edge.
+ */
+static void graph_dyncon_link(DynCon *dc, int left_id, int right_id)
+{
+    int pair;
+    int forward;
+    int slot;
+    int tour;
+
+    pair = dc->free_pairs[--dc->num_free];
+    forward = dc->size + 2 * pair;
+    slot = graph_dyncon_slot(dc, left_id, right_id);
+    dc->slot_lo[slot] = (left_id < right_id ? left_id : right_id);
+    dc->slot_hi[slot] = (left_id < right_id ? right_id : left_id);
+    dc->slot_pair[slot] = pair;
+
+    tour = graph_dyncon_merge(dc, graph_dyncon_reroot(dc, left_id), forward);
+    tour = graph_dyncon_merge(dc, tour, graph_dyncon_reroot(dc, right_id));
+    graph_dyncon_merge(dc, tour, forward + 1);
+    dc->num_components--;
+}
+
+/*
+ * Cut a tree at a tree edge. The tour reads A e B f C, with e and f the two
+ * directions of the edge; B is the tour of one side and A C of the other.
+ *
+ * @pair: Pair of the tree edge.
+ */
+static void graph_dyncon_cut(DynCon *dc, int pair)
+{
+    int first;
+    int second;
+    int first_pos;
+    int second_pos;
+    int before;
+    int middle;
+    int after;
+    int edge;
+
+    first = dc->size + 2 * pair;
+    second = first + 1;
+    first_pos = graph_dyncon_position(dc, first);
+    second_pos = graph_dyncon_position(dc, second);
+    if (first_pos > second_pos)
+    {
+        first_pos = second_pos;
+        second_pos = graph_dyncon_position(dc, first);
+    }
+
+    graph_dyncon_split(dc, graph_dyncon_root(dc, first), second_pos, &before,
+                       &after);
+    graph_dyncon_split(dc, after, 1, &edge, &after);
+    graph_dyncon_split(dc, before, first_pos, &before, &middle);
+    graph_dyncon_split(dc, middle, 1, &edge, &middle);
+    graph_dyncon_merge(dc, before, after);
+
+    dc->free_pairs[dc->num_free++] = pair;
+    dc->num_components++;
+}
+
+/*
+ * Search the smaller of two freshly cut trees for an edge leading to the
+ * other, and link the trees with it.
+ *
+ * @left_id: A node of one tree.
+ * @right_id: A node of the other tree.
+ * @return: 0 if an edge was found, 1 if the trees stay apart.
+ */
+static int graph_dyncon_replace(Graph *graph, DynCon *dc, int left_id,
+                                int right_id)
+{
+    int root;
+    int item;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    root = graph_dyncon_root(dc, left_id);
+    item = graph_dyncon_root(dc, right_id);
+    if (dc->nodes[item] < dc->nodes[root])
+    {
+        root = item;
+    }
+
+    /*  walk the smaller tour in order without a stack  */
+    item = root;
+    while (dc->left[item] >= 0)
+    {
+        item = dc->left[item];
+    }
+    while (item >= 0)
+    {
+        if (item < dc->size)
+        {
+            GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[item], cursor, bits,
+                                    adj_node)
+            {
+                dc->scanned++;
+                if (graph_dyncon_root(dc, adj_node->id) != root)
+                {
+                    graph_dyncon_link(dc, item, adj_node->id);
+                    return 0;
+                }
+            }
+        }
+
+        if (dc->right[item] >= 0)
+        {
+            item = dc->right[item];
+            while (dc->left[item] >= 0)
+            {
+                item = dc->left[item];
+            }
+        }
+        else
+        {
+            while (dc->parent[item] >= 0 &&
+                   dc->right[dc->parent[item]] == item)
+            {
+                item = dc->parent[item];
+            }
+            item = dc->parent[item];
+        }
+    }
+
+    return 1;
+}
+
+/*
+ * Rotate the tour of a node's tree to start at the node.
+ *
+ * @return: The treap root of the rotated tour.
+ */
+static int graph_dyncon_reroot(DynCon *dc, int node_id)
+{
+    int before;
+    int after;
+
+    graph_dyncon_split(dc, graph_dyncon_root(dc, node_id),
+                       graph_dyncon_position(dc, node_id), &before, &after);
+    return graph_dyncon_merge(dc, after, before);
+}
+
+/*
+ * Find the treap root above an item.
+ */
+static int graph_dyncon_root(const DynCon *dc, int item)
+{
+    while (dc->parent[item] >= 0)
+    {
+        item = dc->parent[item];
+    }
+    return item;
+}
+
+/*
+ * Find the position of an item in its tour.
+ */
+static int graph_dyncon_position(const DynCon *dc, int item)
+{
+    int pos;
+    int above;
+
+    pos = (dc->left[item] < 0 ? 0 : dc->items[dc->left[item]]);
+    for (above = dc->parent[item]; above >= 0;
+         item = above, above = dc->parent[item])
+    {
+        if (dc->right[above] == item)
+        {
+            pos += 1 + (dc->left[above] < 0 ? 0 : dc->items[dc->left[above]]);
+        }
+    }
+    return pos;
+}
+
+/*
+ * Concatenate two tours.
+ *
+ * @left: Treap root of the first tour, -1 for an empty one.
+ * @right: Treap root of the second tour, -1 for an empty one.
+ * @return: Treap root of the result.
+ */
+static int graph_dyncon_merge(DynCon *dc, int left, int right)
+{
+    int root;
+
+    if (left < 0 || right < 0)
+    {
+        root = (left < 0 ? right : left);
+    }
+    else if (dc->prio[left] > dc->prio[right])
+    {
+        root = left;
+        dc->right[left] = graph_dyncon_merge(dc, dc->right[left], right);
+        dc->parent[dc->right[left]] = left;
+        graph_dyncon_update(dc, left);
+    }
+    else
+    {
+        root = right;
+        dc->left[right] = graph_dyncon_merge(dc, left, dc->left[right]);
+        dc->parent[dc->left[right]] = right;
+        graph_dyncon_update(dc, right);
+    }
+
+    if (root >= 0)
+    {
+        dc->parent[root] = -1;
+    }
+    return root;
+}
+
+/*
+ * Split a tour after a number of items.
+ *
+ * @item: Treap root of the tour, -1 for an empty one.
+ * @count: Number of items to keep in the first part.
+ * @left: Receives the treap root of the first part.
+ * @right: Receives the treap root of the rest.
+ */
+static void graph_dyncon_split(DynCon *dc, int item, int count, int *left,
+                               int *right)
+{
+    int below;
+
+    if (item < 0)
+    {
+        *left = -1;
+        *right = -1;
+        return;
+    }
+
+    below = (dc->left[item] < 0 ? 0 : dc->items[dc->left[item]]);
+    if (below < count)
+    {
+        graph_dyncon_split(dc, dc->right[item], count - below - 1,
+                           &dc->right[item], right);
+        if (dc->right[item] >= 0)
+        {
+            dc->parent[dc->right[item]] = item;
+        }
+        *left = item;
+    }
+    else
+    {
+        graph_dyncon_split(dc, dc->left[item], count, left, &dc->left[item]);
+        if (dc->left[item] >= 0)
+        {
+            dc->parent[dc->left[item]] = item;
+        }
+        *right = item;
+    }
+
+    graph_dyncon_update(dc, item);
+    dc->parent[item] = -1;
+    if (*left >= 0)
+    {
+        dc->parent[*left] = -1;
+    }
+    if (*right >= 0)
+    {
+        dc->parent[*right] = -1;
+    }
+}
+
+/*
+ * Recount the items and nodes under an item from its children.
+ */
+static void graph_dyncon_update(DynCon *dc, int item)
+{
+    int child;
+
+    dc->items[item] = 1;
+    dc->nodes[item] = (item < dc->size ? 1 : 0);
+    child = dc->left[item];
+    if (child >= 0)
+    {
+        dc->items[item] += dc->items[child];
+        dc->nodes[item] += dc->nodes[child];
+    }
+    child = dc->right[item];
+    if (child >= 0)
+    {
+        dc->items[item] += dc->items[child];
+        dc->nodes[item] += dc->nodes[child];
+    }
+}
+
+/*
+ * Find the slot of the tree edge table holding an edge, or the empty slot
+ * where it would go. Probes are linear.
+ */
+static int graph_dyncon_slot(const DynCon *dc, int left_id, int right_id)
+{
+    int low;
+    int high;
+    int slot;
+
+    low = (left_id < right_id ? left_id : right_id);
+    high = (left_id < right_id ? right_id : left_id);
+    slot = (int)(graph_rng_hash((unsigned long)low, (unsigned long)high) &
+                 (unsigned long)(dc->capacity - 1));
+    while (dc->slot_lo[slot] >= 0 &&
+           (dc->slot_lo[slot] != low || dc->slot_hi[slot] != high))
+    {
+        slot = (slot + 1) & (dc->capacity - 1);
+    }
+    return slot;
+}
+
+/*
+ * Empty a slot of the tree edge table, shifting back later entries of its
+ * probe run so that lookups never stop early.
+ */
+static void graph_dyncon_unmap(DynCon *dc, int slot)
+{
+    int next;
+    int home;
+
+    next = slot;
+    while (1)
+    {
+        dc->slot_lo[slot] = -1;
+        do
+        {
+            next = (next + 1) & (dc->capacity - 1);
+            if (dc->slot_lo[next] < 0)
+            {
+                return;
+            }
+            home = (int)(graph_rng_hash((unsigned long)dc->slot_lo[next],
+                                        (unsigned long)dc->slot_hi[next]) &
+                         (unsigned long)(dc->capacity - 1));
+        } while (((next - home) & (dc->capacity - 1)) <
+                 ((next - slot) & (dc->capacity - 1)));
+
+        /*  the entry at @next may move back into the hole  */
+        dc->slot_lo[slot] = dc->slot_lo[next];
+        dc->slot_hi[slot] = dc->slot_hi[next];
+        dc->slot_pair[slot] = dc->slot_pair[next];
+        slot = next;
+    }
+}
+
+
+#endif
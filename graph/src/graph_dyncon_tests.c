@@ -0,0 +1,246 @@
+/*
+ * Unit tests for the dynamic connectivity header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_dyncon.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+#define RANDOM_SIZE 40
+#define NUM_OPS 3000
+
+static void init_graph(Graph *graph, Node *node_arr, int size, int buckets);
+static int last_neighbor(Graph *graph, int node_id);
+static void naive_components(Graph *graph, int *comp, int *queue);
+
+
+void test_cycle_survives_one_deletion()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    DynCon dc;
+    int *int_buf;
+    int idx;
+
+    init_graph(&graph, node_arr, INIT_SIZE, 1);
+    int_buf = malloc(graph_dyncon_int_words(INIT_SIZE) * sizeof(int));
+    graph_dyncon_init(&graph, &dc, int_buf);
+    TEST_ASSERT_EQUAL(INIT_SIZE, dc.num_components);
+
+    /* A ring 0 - 1 - 2 - 3 - 4 - 0. */
+    for (idx = 0; idx < 5; idx++)
+    {
+        TEST_ASSERT_EQUAL(0, graph_dyncon_add_edge(&graph, &dc, idx,
+                                                   (idx + 1) % 5));
+    }
+    TEST_ASSERT_EQUAL(INIT_SIZE - 4, dc.num_components);
+    TEST_ASSERT_EQUAL(1, graph_dyncon_connected(&dc, 0, 3));
+    TEST_ASSERT_EQUAL(0, graph_dyncon_connected(&dc, 0, 7));
+    TEST_ASSERT_EQUAL(5, graph_dyncon_component_size(&dc, 2));
+
+    /* Any edge of a ring can go, the rest of the ring replaces it. */
+    TEST_ASSERT_EQUAL(0, graph_dyncon_del_edge(&graph, &dc, 1, 2));
+    TEST_ASSERT_EQUAL(1, graph_dyncon_connected(&dc, 1, 2));
+    TEST_ASSERT_EQUAL(5, graph_dyncon_component_size(&dc, 1));
+
+    /* The ring is a path now, cutting it splits it. */
+    TEST_ASSERT_EQUAL(1, graph_dyncon_del_edge(&graph, &dc, 4, 3));
+    TEST_ASSERT_EQUAL(0, graph_dyncon_connected(&dc, 2, 4));
+    TEST_ASSERT_EQUAL(2, graph_dyncon_component_size(&dc, 2));
+    TEST_ASSERT_EQUAL(3, graph_dyncon_component_size(&dc, 1));
+    TEST_ASSERT_EQUAL(INIT_SIZE - 3, dc.num_components);
+
+    TEST_ASSERT_EQUAL(2, graph_dyncon_del_edge(&graph, &dc, 4, 3));
+    free(int_buf);
+}
+
+void test_parallel_edges_and_existing_edges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    DynCon dc;
+    int *int_buf;
+
+    /* Edges already in the graph, stored both ways. */
+    init_graph(&graph, node_arr, INIT_SIZE, 1);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 1, 0);
+    graph_add_edge(&graph, 1, 2);
+    graph_add_edge(&graph, 2, 1);
+    int_buf = malloc(graph_dyncon_int_words(INIT_SIZE) * sizeof(int));
+    graph_dyncon_init(&graph, &dc, int_buf);
+    TEST_ASSERT_EQUAL(1, graph_dyncon_connected(&dc, 0, 2));
+    TEST_ASSERT_EQUAL(INIT_SIZE - 2, dc.num_components);
+
+    /* A second copy of 1 - 2 keeps them connected when one goes. */
+    graph_dyncon_add_edge(&graph, &dc, 2, 1);
+    TEST_ASSERT_EQUAL(0, graph_dyncon_del_edge(&graph, &dc, 1, 2));
+    TEST_ASSERT_EQUAL(1, graph_dyncon_connected(&dc, 0, 2));
+    TEST_ASSERT_EQUAL(1, graph_dyncon_del_edge(&graph, &dc, 1, 2));
+    TEST_ASSERT_EQUAL(0, graph_dyncon_connected(&dc, 0, 2));
+
+    /* Self loops don't connect anything. */
+    graph_dyncon_add_edge(&graph, &dc, 5, 5);
+    TEST_ASSERT_EQUAL(1, graph_dyncon_component_size(&dc, 5));
+    TEST_ASSERT_EQUAL(0, graph_dyncon_del_edge(&graph, &dc, 5, 5));
+    free(int_buf);
+}
+
+void test_random_updates_match_naive()
+{
+    Graph graph;
+    Node node_arr[RANDOM_SIZE];
+    DynCon dc;
+    GraphRng rng;
+    int *int_buf;
+    int comp[RANDOM_SIZE];
+    int queue[RANDOM_SIZE];
+    int op;
+    int left_id;
+    int right_id;
+    int node_id;
+    int num_comps;
+
+    init_graph(&graph, node_arr, RANDOM_SIZE, 3);
+    int_buf = malloc(graph_dyncon_int_words(RANDOM_SIZE) * sizeof(int));
+    graph_dyncon_init(&graph, &dc, int_buf);
+    graph_rng_seed(&rng, 3, 0);
+
+    for (op = 0; op < NUM_OPS; op++)
+    {
+        left_id = graph_rng_below(&rng, RANDOM_SIZE);
+        right_id = graph_rng_below(&rng, RANDOM_SIZE);
+
+        /*  hover around one edge per node, near the connectivity threshold,
+         *  deleting an edge picked at random and one known to exist  */
+        if (graph.num_edges < 2 * RANDOM_SIZE)
+        {
+            graph_dyncon_add_edge(&graph, &dc, left_id, right_id);
+        }
+        else
+        {
+            graph_dyncon_del_edge(&graph, &dc, left_id, right_id);
+            while (graph.nodes[left_id].degree == 0)
+            {
+                left_id = (left_id + 1) % RANDOM_SIZE;
+            }
+            graph_dyncon_del_edge(&graph, &dc, left_id,
+                                  last_neighbor(&graph, left_id));
+        }
+
+        if (op % 10 == 0)
+        {
+            naive_components(&graph, comp, queue);
+            num_comps = 0;
+            for (node_id = 0; node_id < RANDOM_SIZE; node_id++)
+            {
+                num_comps += (comp[node_id] == node_id);
+                TEST_ASSERT_EQUAL(comp[node_id] == comp[0],
+                                  graph_dyncon_connected(&dc, node_id, 0));
+                TEST_ASSERT_EQUAL(comp[node_id] == comp[node_id / 2],
+                                  graph_dyncon_connected(&dc, node_id,
+                                                         node_id / 2));
+            }
+            TEST_ASSERT_EQUAL(num_comps, dc.num_components);
+        }
+    }
+    TEST_ASSERT_TRUE(dc.scanned > 0);
+    free(int_buf);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  delete edges from a ring, verify it holds once and then splits  */
+    RUN_TEST(test_cycle_survives_one_deletion);
+    /*  start from existing edges, delete parallel edges and self loops  */
+    RUN_TEST(test_parallel_edges_and_existing_edges);
+    /*  add and delete random edges, compare against a search each time  */
+    RUN_TEST(test_random_updates_match_naive);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize a graph with some buckets per node.
+ */
+static void init_graph(Graph *graph, Node *node_arr, int size, int buckets)
+{
+    int idx;
+    int count;
+
+    graph_init(graph, node_arr, size);
+    for (idx = 0; idx < size; idx++)
+    {
+        for (count = 0; count < buckets; count++)
+        {
+            graph_add_bucket(graph, idx, malloc(sizeof(Bucket)));
+        }
+    }
+}
+
+/*
+ * Find the last neighbor of a node, -1 if it has none.
+ */
+static int last_neighbor(Graph *graph, int node_id)
+{
+    int found;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    found = -1;
+    GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+    {
+        found = adj_node->id;
+    }
+    return found;
+}
+
+/*
+ * Label each node with the smallest id of its component, searching breadth
+ * first from every unlabeled node.
+ */
+static void naive_components(Graph *graph, int *comp, int *queue)
+{
+    int node_id;
+    int head;
+    int tail;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        comp[node_id] = -1;
+    }
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        if (comp[node_id] >= 0)
+        {
+            continue;
+        }
+        comp[node_id] = node_id;
+        queue[0] = node_id;
+        tail = 1;
+        for (head = 0; head < tail; head++)
+        {
+            GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[queue[head]], cursor, bits,
+                                    adj_node)
+            {
+                if (comp[adj_node->id] < 0)
+                {
+                    comp[adj_node->id] = node_id;
+                    queue[tail++] = adj_node->id;
+                }
+            }
+        }
+    }
+}
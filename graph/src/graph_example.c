@@ -59,17 +59,24 @@ void graph_double(Graph *graph)
     int idx;
     int new_size;
     int old_size;
+    int num_edges;
+    int num_buckets;
 
     old_size = graph->size;
     new_size = 2 * graph->size;
     new_graph_nodes = malloc(new_size * sizeof(Node));
 
     old_graph_nodes = graph->nodes; /* Save old nodes to copy over. */
+    num_edges = graph->num_edges; /* Save counts, init resets them. */
+    num_buckets = graph->num_buckets;
     /* Reinitialize graph for new node array. */
     graph_init(graph, new_graph_nodes, new_size);
     for (idx = 0; idx < old_size; idx++)
     {
         /* Point new nodes to old nodes buckets to copy the edges. */
         new_graph_nodes[idx].edges_out = old_graph_nodes[idx].edges_out;
+        new_graph_nodes[idx].degree = old_graph_nodes[idx].degree;
     }
+    graph->num_edges = num_edges;
+    graph->num_buckets = num_buckets;
 }
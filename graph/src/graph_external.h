@@ -0,0 +1,368 @@
+/*
+ * Semi-external graph algorithms: node state in memory, edges on disk.
+ *
+ * A graph whose edges don't fit in memory can still be processed on one
+ * machine if its per-node state does, since nodes are usually far fewer than
+ * edges. This header keeps the edges in a binary file and the algorithms
+ * stream through it front to back in large blocks, the access pattern disks
+ * and operating system read-ahead are best at. Every algorithm is built from
+ * whole passes over the file:
+ *   - Breadth-first search: pass k finds the nodes at distance k + 1 from the
+ *     edges leaving nodes at distance k. One pass per level.
+ *   - Connected components: union-find over the node ids. One pass.
+ *   - PageRank: one pass to count out-degrees, then one per power iteration.
+ *
+ * The edge file is a sequence of (from, to) pairs of native ints, as written
+ * by 'graph_external_write', grouped by the node they start at. The file is
+ * only ever read sequentially, so it may live on any seekable stream.
+ *
+ * === How to Use ===
+ * This header does no memory management. Open the edge file, allocate a block
+ * of 2 * block_edges ints to read it through, and call 'graph_external_open'.
+ * Larger blocks mean fewer, larger reads; a few megabytes is plenty. Each
+ * algorithm takes its own per-node arrays. I/O errors are reported by
+ * returning -1.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_EXTERNAL_H
+#define GRAPH_EXTERNAL_H
+
+#include <stdio.h>
+#include "graph.h"
+
+typedef struct ExternalGraphTag ExternalGraph;
+
+static int graph_external_find(int *parent, int node_id);
+
+/*
+ * An edge file being streamed.
+ *
+ * @file: The edge file.
+ * @num_nodes: Number of nodes. Every id in the file is below this.
+ * @block: Buffer of @block_edges (from, to) pairs.
+ * @block_edges: The most edges read at once.
+ * @passes: Number of passes started over the file, for tuning.
+ */
+struct ExternalGraphTag
+{
+    FILE *file;
+    int num_nodes;
+    int *block;
+    int block_edges;
+    long passes;
+};
+
+/*
+ * Write the edges of a graph to an edge file, grouped by the node they start
+ * at.
+ *
+ * @file: Stream open for binary writing.
+ * @return: The number of edges written, or -1 on a write error.
+ */
+static long graph_external_write(Graph *graph, FILE *file)
+{
+    int pair[2];
+    int node_id;
+    long count;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    count = 0;
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            pair[0] = node_id;
+            pair[1] = adj_node->id;
+            if (fwrite(pair, sizeof(int), 2, file) != 2)
+            {
+                return -1;
+            }
+            count++;
+        }
+    }
+
+    return (fflush(file) == 0 ? count : -1);
+}
+
+/*
+ * Prepare to stream an edge file.
+ *
+ * @file: Stream open for binary reading, holding the edges.
+ * @num_nodes: Number of nodes.
+ * @block: Array of 2 * @block_edges ints.
+ * @block_edges: The most edges to read at once.
+ */
+static void graph_external_open(ExternalGraph *ext, FILE *file, int num_nodes,
+                                int *block, int block_edges)
+{
+    ext->file = file;
+    ext->num_nodes = num_nodes;
+    ext->block = block;
+    ext->block_edges = block_edges;
+    ext->passes = 0;
+}
+
+/*
+ * Go back to the start of the edge file.
+ *
+ * @return: 0 on success, -1 on an I/O error.
+ */
+static int graph_external_rewind(ExternalGraph *ext)
+{
+    ext->passes++;
+    return (fseek(ext->file, 0L, SEEK_SET) == 0 ? 0 : -1);
+}
+
+/*
+ * Read the next block of edges. Edge i of the block goes from block[2 * i]
+ * to block[2 * i + 1].
+ *
+ * @return: The number of edges read, 0 at the end of the file, or -1 on an
+ *   I/O error.
+ */
+static int graph_external_read(ExternalGraph *ext)
+{
+    size_t ints;
+
+    ints = fread(ext->block, sizeof(int), 2 * (size_t)ext->block_edges,
+                 ext->file);
+    if (ints < 2 * (size_t)ext->block_edges && ferror(ext->file))
+    {
+        return -1;
+    }
+    return (int)(ints / 2);
+}
+
+/*
+ * Find the distance of every node from a source node, following edges out.
+ *
+ * @source: Id of the node to search from.
+ * @dist: Array of num_nodes ints. Receives each node's distance, -1 if it
+ *   can't be reached.
+ * @return: The largest distance found, or -1 on an I/O error.
+ */
+static int graph_external_bfs(ExternalGraph *ext, int source, int *dist)
+{
+    int node_id;
+    int level;
+    int count;
+    int idx;
+    int grew;
+    const int *block;
+
+    for (node_id = 0; node_id < ext->num_nodes; node_id++)
+    {
+        dist[node_id] = -1;
+    }
+    dist[source] = 0;
+
+    block = ext->block;
+    for (level = 0; ; level++)
+    {
+        if (graph_external_rewind(ext) != 0)
+        {
+            return -1;
+        }
+        grew = 0;
+        while ((count = graph_external_read(ext)) > 0)
+        {
+            for (idx = 0; idx < count; idx++)
+            {
+                if (dist[block[2 * idx]] == level &&
+                    dist[block[2 * idx + 1]] == -1)
+                {
+                    dist[block[2 * idx + 1]] = level + 1;
+                    grew = 1;
+                }
+            }
+        }
+        if (count < 0)
+        {
+            return -1;
+        }
+        if (!grew)
+        {
+            return level;
+        }
+    }
+}
+
+/*
+ * Label the connected components of the graph, ignoring edge direction.
+ *
+ * @component: Array of num_nodes ints. Receives each node's component,
+ *   named by its smallest node id.
+ * @return: The number of components, or -1 on an I/O error.
+ */
+static int graph_external_components(ExternalGraph *ext, int *component)
+{
+    int node_id;
+    int count;
+    int idx;
+    int root_from;
+    int root_to;
+    int num_components;
+    const int *block;
+
+    for (node_id = 0; node_id < ext->num_nodes; node_id++)
+    {
+        component[node_id] = node_id;
+    }
+
+    /*  union-find, linking the larger root under the smaller one  */
+    block = ext->block;
+    if (graph_external_rewind(ext) != 0)
+    {
+        return -1;
+    }
+    while ((count = graph_external_read(ext)) > 0)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            root_from = graph_external_find(component, block[2 * idx]);
+            root_to = graph_external_find(component, block[2 * idx + 1]);
+            if (root_from < root_to)
+            {
+                component[root_to] = root_from;
+            }
+            else if (root_to < root_from)
+            {
+                component[root_from] = root_to;
+            }
+        }
+    }
+    if (count < 0)
+    {
+        return -1;
+    }
+
+    /*  roots are the smallest ids, so one sweep up flattens every tree  */
+    num_components = 0;
+    for (node_id = 0; node_id < ext->num_nodes; node_id++)
+    {
+        component[node_id] = component[component[node_id]];
+        num_components += (component[node_id] == node_id);
+    }
+    return num_components;
+}
+
+/*
+ * Compute PageRank by power iteration. Rank held by nodes without edges out
+ * is spread evenly over all nodes.
+ *
+ * @rank: Array of num_nodes doubles. Receives each node's rank, summing to 1.
+ * @next: Scratch array of num_nodes doubles.
+ * @degree: Scratch array of num_nodes ints. Receives each node's out-degree.
+ * @damping: Probability of following an edge rather than jumping, eg 0.85.
+ * @tolerance: Stop once the ranks change by less than this in total.
+ * @max_iters: The most iterations to run.
+ * @return: The number of iterations run, or -1 on an I/O error.
+ */
+static int graph_external_pagerank(ExternalGraph *ext, double *rank,
+                                   double *next, int *degree, double damping,
+                                   double tolerance, int max_iters)
+{
+    int node_id;
+    int count;
+    int idx;
+    int iter;
+    double dangling;
+    double base;
+    double change;
+    const int *block;
+
+    block = ext->block;
+    for (node_id = 0; node_id < ext->num_nodes; node_id++)
+    {
+        degree[node_id] = 0;
+        rank[node_id] = 1.0 / ext->num_nodes;
+    }
+    if (graph_external_rewind(ext) != 0)
+    {
+        return -1;
+    }
+    while ((count = graph_external_read(ext)) > 0)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            degree[block[2 * idx]]++;
+        }
+    }
+    if (count < 0)
+    {
+        return -1;
+    }
+
+    for (iter = 0; iter < max_iters; iter++)
+    {
+        dangling = 0.0;
+        for (node_id = 0; node_id < ext->num_nodes; node_id++)
+        {
+            next[node_id] = 0.0;
+            if (degree[node_id] == 0)
+            {
+                dangling += rank[node_id];
+            }
+        }
+
+        if (graph_external_rewind(ext) != 0)
+        {
+            return -1;
+        }
+        while ((count = graph_external_read(ext)) > 0)
+        {
+            for (idx = 0; idx < count; idx++)
+            {
+                next[block[2 * idx + 1]] += rank[block[2 * idx]] /
+                                            degree[block[2 * idx]];
+            }
+        }
+        if (count < 0)
+        {
+            return -1;
+        }
+
+        base = (1.0 - damping + damping * dangling) / ext->num_nodes;
+        change = 0.0;
+        for (node_id = 0; node_id < ext->num_nodes; node_id++)
+        {
+            next[node_id] = base + damping * next[node_id];
+            change += (next[node_id] > rank[node_id] ?
+                       next[node_id] - rank[node_id] :
+                       rank[node_id] - next[node_id]);
+            rank[node_id] = next[node_id];
+        }
+        if (change < tolerance)
+        {
+            return iter + 1;
+        }
+    }
+
+    return max_iters;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the root of a node's union-find tree, halving the path on the way.
+ *
+ * @parent: Parent of each node, roots are their own parents.
+ */
+static int graph_external_find(int *parent, int node_id)
+{
+    while (parent[node_id] != node_id)
+    {
+        parent[node_id] = parent[parent[node_id]];
+        node_id = parent[node_id];
+    }
+    return node_id;
+}
+
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * Unit tests for the semi-external graph header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_external.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 12
+#define BLOCK_EDGES 3
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static ExternalGraph ext;
+static int block[2 * BLOCK_EDGES];
+static FILE *edge_file;
+
+static void init_graph(void);
+static void spill_graph(void);
+
+
+void test_write_and_read_back()
+{
+    int count;
+    int total;
+    int last_from;
+    int idx;
+
+    init_graph();
+    graph_add_edge(&graph, 4, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 4, 3);
+    graph_add_edge(&graph, 9, 9);
+    graph_add_edge(&graph, 2, 8);
+    spill_graph();
+
+    /* Blocks hold 3 edges, so 5 edges take two reads. */
+    graph_external_rewind(&ext);
+    total = 0;
+    last_from = 0;
+    while ((count = graph_external_read(&ext)) > 0)
+    {
+        for (idx = 0; idx < count; idx++)
+        {
+            TEST_ASSERT_TRUE(block[2 * idx] >= last_from);
+            TEST_ASSERT_EQUAL(0, graph_has_edge(&graph, block[2 * idx],
+                                                block[2 * idx + 1]));
+            last_from = block[2 * idx];
+        }
+        total += count;
+    }
+    TEST_ASSERT_EQUAL(0, count);
+    TEST_ASSERT_EQUAL(5, total);
+}
+
+void test_bfs_levels()
+{
+    int dist[INIT_SIZE];
+
+    init_graph();
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 2, 3);
+    graph_add_edge(&graph, 1, 3);
+    graph_add_edge(&graph, 3, 4);
+    graph_add_edge(&graph, 5, 0);
+    spill_graph();
+
+    TEST_ASSERT_EQUAL(3, graph_external_bfs(&ext, 0, dist));
+    TEST_ASSERT_EQUAL(0, dist[0]);
+    TEST_ASSERT_EQUAL(1, dist[1]);
+    TEST_ASSERT_EQUAL(1, dist[2]);
+    TEST_ASSERT_EQUAL(2, dist[3]);
+    TEST_ASSERT_EQUAL(3, dist[4]);
+    /* Edges are followed out only. */
+    TEST_ASSERT_EQUAL(-1, dist[5]);
+    TEST_ASSERT_EQUAL(-1, dist[11]);
+}
+
+void test_components()
+{
+    int component[INIT_SIZE];
+
+    init_graph();
+    graph_add_edge(&graph, 7, 3);
+    graph_add_edge(&graph, 3, 9);
+    graph_add_edge(&graph, 11, 9);
+    graph_add_edge(&graph, 2, 5);
+    graph_add_edge(&graph, 6, 5);
+    spill_graph();
+
+    /* {3, 7, 9, 11}, {2, 5, 6} and five isolated nodes. */
+    TEST_ASSERT_EQUAL(7, graph_external_components(&ext, component));
+    TEST_ASSERT_EQUAL(3, component[7]);
+    TEST_ASSERT_EQUAL(3, component[9]);
+    TEST_ASSERT_EQUAL(3, component[11]);
+    TEST_ASSERT_EQUAL(2, component[5]);
+    TEST_ASSERT_EQUAL(2, component[6]);
+    TEST_ASSERT_EQUAL(4, component[4]);
+}
+
+void test_pagerank_matches_dense()
+{
+    double rank[INIT_SIZE];
+    double next[INIT_SIZE];
+    double expected[INIT_SIZE];
+    double dense_next[INIT_SIZE];
+    int degree[INIT_SIZE];
+    double dangling;
+    double sum;
+    int from_id;
+    int iter;
+    int idx;
+    Bucket *cursor;
+
+    init_graph();
+    srand(5);
+    for (idx = 0; idx < 3 * INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, rand() % (INIT_SIZE - 2), rand() % INIT_SIZE);
+    }
+    spill_graph();
+
+    TEST_ASSERT_TRUE(graph_external_pagerank(&ext, rank, next, degree, 0.85,
+                                             1e-12, 500) < 500);
+
+    /* Plain power iteration over the bucket graph. */
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        expected[idx] = 1.0 / INIT_SIZE;
+    }
+    for (iter = 0; iter < 500; iter++)
+    {
+        dangling = 0.0;
+        for (from_id = 0; from_id < INIT_SIZE; from_id++)
+        {
+            dense_next[from_id] = 0.0;
+            dangling += (degree[from_id] == 0 ? expected[from_id] : 0.0);
+        }
+        for (from_id = 0; from_id < INIT_SIZE; from_id++)
+        {
+            for (cursor = node_arr[from_id].edges_out; cursor != 0;
+                 cursor = cursor->next)
+            {
+                for (idx = 0; idx < BUCKET_SIZE; idx++)
+                {
+                    if (cursor->adj_nodes[idx] != 0)
+                    {
+                        dense_next[cursor->adj_nodes[idx]->id] +=
+                            expected[from_id] / degree[from_id];
+                    }
+                }
+            }
+        }
+        for (idx = 0; idx < INIT_SIZE; idx++)
+        {
+            expected[idx] = (0.15 + 0.85 * dangling) / INIT_SIZE +
+                            0.85 * dense_next[idx];
+        }
+    }
+
+    sum = 0.0;
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-9, expected[idx], rank[idx]);
+        sum += rank[idx];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0, sum);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  spill a graph to a file, verify the edges read back  */
+    RUN_TEST(test_write_and_read_back);
+    /*  search from the file, verify the levels  */
+    RUN_TEST(test_bfs_levels);
+    /*  label components from the file  */
+    RUN_TEST(test_components);
+    /*  rank from the file, verify against dense power iteration  */
+    RUN_TEST(test_pagerank_matches_dense);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize the graph with enough buckets for any test.
+ */
+static void init_graph(void)
+{
+    int idx;
+    int cnt;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        for (cnt = 0; cnt < 2; cnt++)
+        {
+            graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+        }
+    }
+}
+
+/*
+ * Write the graph to a fresh temporary file and open it for streaming.
+ */
+static void spill_graph(void)
+{
+    if (edge_file != 0)
+    {
+        fclose(edge_file);
+    }
+    edge_file = tmpfile();
+    TEST_ASSERT_NOT_NULL(edge_file);
+    TEST_ASSERT_TRUE(graph_external_write(&graph, edge_file) >= 0);
+    graph_external_open(&ext, edge_file, INIT_SIZE, block, BLOCK_EDGES);
+}
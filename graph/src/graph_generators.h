@@ -0,0 +1,290 @@
+/*
+ * Seedable synthetic graph generators for tests and benchmarks.
+ * See Chakrabarti, Zhan and Faloutsos, "R-MAT: A Recursive Model for Graph
+ * Mining" (2004) and Sanders and Schulz, "Scalable Generation of Scale-free
+ * Graphs" (2016) for the theory.
+ *
+ * Performance numbers are only as meaningful as the graphs behind them. This
+ * header generates the usual benchmark families:
+ *   - R-MAT: skewed, community-like graphs of 2^scale nodes. Each edge picks
+ *     a quadrant of the adjacency matrix with probabilities a, b, c and d,
+ *     then a quadrant within it, once per bit of the node ids.
+ *   - G(n, m): m edges between uniformly random pairs of distinct nodes.
+ *   - Grids: rows x cols nodes, each linked to its right and lower neighbors,
+ *     the usual stand-in for road networks' low degree and large diameter.
+ *   - Barabasi-Albert: nodes arrive one at a time and attach k edges to
+ *     earlier nodes with probability proportional to their degree, giving a
+ *     power-law degree distribution.
+ *
+ * Every generator computes edge i from the seed and i alone, never from the
+ * edges before it, so any range of edges can be generated by any worker in any
+ * order and the result is always the same. For Barabasi-Albert this uses the
+ * trick of Sanders and Schulz: picking an endpoint of a uniformly random
+ * earlier edge is picking with probability proportional to degree, and when
+ * that endpoint is itself a random choice, it is found by replaying the
+ * earlier edge's choice instead of looking it up.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. Allocate two
+ * int arrays with one entry per edge, then call a generator for the range
+ * [lo, hi) of edges; pass [0, count) to generate them all, or split the range
+ * between workers. The 'graph_gen_*_edges' functions give the edge counts of
+ * the fixed-size families. Edge i is written to from[i] and to[i].
+ *
+ * To load the edges into a Graph, call 'graph_gen_fill' with a pool of
+ * buckets to draw from as nodes fill up.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include "graph.h"
+#include "graph_rng.h"
+
+static int graph_gen_ba_target(unsigned long seed, int k, long edge);
+
+/*
+ * Generate a range of R-MAT edges over 2^@scale nodes.
+ * a = 0.57, b = 0.19, c = 0.19 gives the Graph 500 benchmark's graphs.
+ *
+ * @scale: Log2 of the number of nodes, at most 30.
+ * @a: Probability of the top-left quadrant (low from, low to).
+ * @b: Probability of the top-right quadrant (low from, high to).
+ * @c: Probability of the bottom-left quadrant (high from, low to). The
+ *   bottom-right quadrant gets the rest.
+ * @seed: Seed of the graph.
+ * @from: Receives each edge's start node.
+ * @to: Receives each edge's end node.
+ * @lo: First edge to generate.
+ * @hi: One past the last edge to generate.
+ */
+static void graph_gen_rmat(int scale, double a, double b, double c,
+                           unsigned long seed, int *from, int *to, long lo,
+                           long hi)
+{
+    long edge;
+    int bit;
+    int from_id;
+    int to_id;
+    double draw;
+    GraphRng rng;
+
+    for (edge = lo; edge < hi; edge++)
+    {
+        graph_rng_seed(&rng, seed, (unsigned long)edge);
+        from_id = 0;
+        to_id = 0;
+        for (bit = 0; bit < scale; bit++)
+        {
+            draw = graph_rng_double(&rng);
+            if (draw >= a + b + c)
+            {
+                from_id |= 1 << bit;
+                to_id |= 1 << bit;
+            }
+            else if (draw >= a + b)
+            {
+                from_id |= 1 << bit;
+            }
+            else if (draw >= a)
+            {
+                to_id |= 1 << bit;
+            }
+        }
+        from[edge] = from_id;
+        to[edge] = to_id;
+    }
+}
+
+/*
+ * Generate a range of G(n, m) edges: uniformly random pairs of distinct
+ * nodes. Pairs may repeat, which is rare while m is well below n^2.
+ *
+ * @num_nodes: Number of nodes, at least 2.
+ * @seed: Seed of the graph.
+ * @from: Receives each edge's start node.
+ * @to: Receives each edge's end node.
+ * @lo: First edge to generate.
+ * @hi: One past the last edge to generate.
+ */
+static void graph_gen_gnm(int num_nodes, unsigned long seed, int *from,
+                          int *to, long lo, long hi)
+{
+    long edge;
+    GraphRng rng;
+
+    for (edge = lo; edge < hi; edge++)
+    {
+        graph_rng_seed(&rng, seed, (unsigned long)edge);
+        from[edge] = graph_rng_below(&rng, num_nodes);
+        do
+        {
+            to[edge] = graph_rng_below(&rng, num_nodes);
+        } while (to[edge] == from[edge]);
+    }
+}
+
+/*
+ * Get the number of edges of a grid.
+ */
+static long graph_gen_grid_edges(int rows, int cols)
+{
+    return (long)rows * (cols - 1) + (long)(rows - 1) * cols;
+}
+
+/*
+ * Generate a range of the edges of a grid. Node (r, c) has id r * @cols + c
+ * and links to (r, c + 1) and (r + 1, c). The horizontal edges come first,
+ * row by row, then the vertical ones.
+ *
+ * @rows: Number of rows.
+ * @cols: Number of columns.
+ * @from: Receives each edge's start node.
+ * @to: Receives each edge's end node.
+ * @lo: First edge to generate.
+ * @hi: One past the last edge to generate, at most 'graph_gen_grid_edges'.
+ */
+static void graph_gen_grid(int rows, int cols, int *from, int *to, long lo,
+                           long hi)
+{
+    long edge;
+    long across;
+    int row;
+    int col;
+
+    across = (long)rows * (cols - 1);
+    for (edge = lo; edge < hi; edge++)
+    {
+        if (edge < across)
+        {
+            row = (int)(edge / (cols - 1));
+            col = (int)(edge % (cols - 1));
+            from[edge] = row * cols + col;
+            to[edge] = from[edge] + 1;
+        }
+        else
+        {
+            from[edge] = (int)(edge - across);
+            to[edge] = from[edge] + cols;
+        }
+    }
+}
+
+/*
+ * Get the number of edges of a Barabasi-Albert graph.
+ */
+static long graph_gen_ba_edges(int num_nodes, int k)
+{
+    return (long)(num_nodes - 1) * k;
+}
+
+/*
+ * Generate a range of the edges of a Barabasi-Albert graph. Node 0 starts
+ * alone, and node u > 0 arrives with edges k * (u - 1) .. k * u - 1, each
+ * from u to an earlier node. Node 1 can only link to node 0, so its edges
+ * are parallel, and later nodes may pick a node twice.
+ *
+ * @k: Number of edges each arriving node brings.
+ * @seed: Seed of the graph.
+ * @from: Receives each edge's start node.
+ * @to: Receives each edge's end node.
+ * @lo: First edge to generate.
+ * @hi: One past the last edge to generate, at most 'graph_gen_ba_edges'.
+ */
+static void graph_gen_ba(int k, unsigned long seed, int *from, int *to,
+                         long lo, long hi)
+{
+    long edge;
+
+    for (edge = lo; edge < hi; edge++)
+    {
+        from[edge] = (int)(edge / k) + 1;
+        to[edge] = graph_gen_ba_target(seed, k, edge);
+    }
+}
+
+/*
+ * Add generated edges to a graph, taking buckets from a pool when a node is
+ * full.
+ *
+ * @from: Start node of each edge.
+ * @to: End node of each edge.
+ * @count: Number of edges.
+ * @pool: Array of unused buckets.
+ * @pool_size: Number of buckets in @pool.
+ * @return: The number of buckets taken from @pool. If it equals @pool_size,
+ *   the pool may have run out before every edge was added.
+ */
+static int graph_gen_fill(Graph *graph, const int *from, const int *to,
+                          long count, Bucket *pool, int pool_size)
+{
+    long edge;
+    int used;
+
+    used = 0;
+    for (edge = 0; edge < count; edge++)
+    {
+        while (graph_add_edge(graph, from[edge], to[edge]) != 0)
+        {
+            if (used == pool_size)
+            {
+                return used;
+            }
+            graph_add_bucket(graph, from[edge], &pool[used++]);
+        }
+    }
+
+    return used;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the end node of a Barabasi-Albert edge.
+ * Edge e's end is a uniformly random endpoint of the edges before its node
+ * arrived: endpoint 2f is the start of edge f, a known node, and endpoint
+ * 2f + 1 is the end of edge f, found by replaying edge f's choice.
+ *
+ * @k: Number of edges each arriving node brings.
+ * @edge: Index of the edge.
+ */
+static int graph_gen_ba_target(unsigned long seed, int k, long edge)
+{
+    long earlier;
+    long endpoint;
+    GraphRng rng;
+
+    while (1)
+    {
+        earlier = edge - edge % k;
+        if (earlier == 0)
+        {
+            /*  the first node to arrive can only link to node 0  */
+            return 0;
+        }
+
+        graph_rng_seed(&rng, seed, (unsigned long)edge);
+        if (earlier <= 0x3FFFFFFFL)
+        {
+            endpoint = graph_rng_below(&rng, (int)(2 * earlier));
+        }
+        else
+        {
+            /*  too many endpoints for an int bound  */
+            endpoint = (long)(graph_rng_double(&rng) * 2.0 * (double)earlier);
+        }
+
+        if (endpoint % 2 == 0)
+        {
+            return (int)(endpoint / 2 / k) + 1;
+        }
+        edge = endpoint / 2;
+    }
+}
+
+
+#endif
@@ -0,0 +1,213 @@
+/*
+ * Unit tests for the graph generators header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_generators.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define SCALE 8
+#define INIT_SIZE (1 << SCALE)
+#define MAX_EDGES 4096
+#define POOL_SIZE 1024
+
+static int from[MAX_EDGES];
+static int to[MAX_EDGES];
+static int split_from[MAX_EDGES];
+static int split_to[MAX_EDGES];
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static Bucket pool[POOL_SIZE];
+
+static void count_out_degrees(int *degree, long count);
+
+
+void test_rmat_split_matches_whole()
+{
+    long idx;
+
+    graph_gen_rmat(SCALE, 0.57, 0.19, 0.19, 11, from, to, 0, MAX_EDGES);
+    /* Generate the second half first, as a different worker might. */
+    graph_gen_rmat(SCALE, 0.57, 0.19, 0.19, 11, split_from, split_to,
+                   MAX_EDGES / 3, MAX_EDGES);
+    graph_gen_rmat(SCALE, 0.57, 0.19, 0.19, 11, split_from, split_to, 0,
+                   MAX_EDGES / 3);
+
+    TEST_ASSERT_EQUAL_INT_ARRAY(from, split_from, MAX_EDGES);
+    TEST_ASSERT_EQUAL_INT_ARRAY(to, split_to, MAX_EDGES);
+    for (idx = 0; idx < MAX_EDGES; idx++)
+    {
+        TEST_ASSERT_TRUE(from[idx] >= 0 && from[idx] < INIT_SIZE);
+        TEST_ASSERT_TRUE(to[idx] >= 0 && to[idx] < INIT_SIZE);
+    }
+}
+
+void test_rmat_is_skewed()
+{
+    int degree[INIT_SIZE];
+    int idx;
+    int max_degree;
+
+    graph_gen_rmat(SCALE, 0.57, 0.19, 0.19, 3, from, to, 0, MAX_EDGES);
+    count_out_degrees(degree, MAX_EDGES);
+
+    /* Node 0 expects 4096 * 0.76^8 = 455 edges, the average is 16. */
+    max_degree = 0;
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        max_degree = (degree[idx] > max_degree ? degree[idx] : max_degree);
+    }
+    TEST_ASSERT_EQUAL(max_degree, degree[0]);
+    TEST_ASSERT_TRUE(degree[0] > 300);
+    TEST_ASSERT_TRUE(degree[INIT_SIZE - 1] < 16);
+}
+
+void test_gnm_pairs()
+{
+    long idx;
+    int differ;
+
+    graph_gen_gnm(INIT_SIZE, 5, from, to, 0, MAX_EDGES);
+    graph_gen_gnm(INIT_SIZE, 6, split_from, split_to, 0, MAX_EDGES);
+
+    differ = 0;
+    for (idx = 0; idx < MAX_EDGES; idx++)
+    {
+        TEST_ASSERT_TRUE(from[idx] >= 0 && from[idx] < INIT_SIZE);
+        TEST_ASSERT_TRUE(to[idx] >= 0 && to[idx] < INIT_SIZE);
+        TEST_ASSERT_TRUE(from[idx] != to[idx]);
+        differ += (from[idx] != split_from[idx]);
+    }
+    TEST_ASSERT_TRUE(differ > MAX_EDGES / 2);
+}
+
+void test_grid_edges()
+{
+    int degree[INIT_SIZE];
+    long count;
+    long idx;
+
+    count = graph_gen_grid_edges(4, 5);
+    TEST_ASSERT_EQUAL(31, count);
+    graph_gen_grid(4, 5, from, to, 0, count);
+
+    TEST_ASSERT_EQUAL(0, from[0]);
+    TEST_ASSERT_EQUAL(1, to[0]);
+    TEST_ASSERT_EQUAL(5, from[4]);
+    TEST_ASSERT_EQUAL(0, from[16]);
+    TEST_ASSERT_EQUAL(5, to[16]);
+    TEST_ASSERT_EQUAL(14, from[30]);
+    TEST_ASSERT_EQUAL(19, to[30]);
+
+    /* Interior nodes have two edges out, the far corner none. */
+    count_out_degrees(degree, count);
+    TEST_ASSERT_EQUAL(2, degree[6]);
+    TEST_ASSERT_EQUAL(1, degree[4]);
+    TEST_ASSERT_EQUAL(1, degree[15]);
+    TEST_ASSERT_EQUAL(0, degree[19]);
+    for (idx = 0; idx < count; idx++)
+    {
+        TEST_ASSERT_TRUE(to[idx] - from[idx] == 1 || to[idx] - from[idx] == 5);
+    }
+}
+
+void test_ba_attaches_to_earlier_nodes()
+{
+    int in_degree[INIT_SIZE];
+    long count;
+    long idx;
+    int node_id;
+    int late_max;
+
+    count = graph_gen_ba_edges(INIT_SIZE, 4);
+    graph_gen_ba(4, 9, from, to, 0, count);
+    graph_gen_ba(4, 9, split_from, split_to, count / 2, count);
+    graph_gen_ba(4, 9, split_from, split_to, 0, count / 2);
+    TEST_ASSERT_EQUAL_INT_ARRAY(to, split_to, count);
+
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        in_degree[node_id] = 0;
+    }
+    for (idx = 0; idx < count; idx++)
+    {
+        TEST_ASSERT_EQUAL(idx / 4 + 1, from[idx]);
+        TEST_ASSERT_TRUE(to[idx] < from[idx]);
+        in_degree[to[idx]]++;
+    }
+    TEST_ASSERT_EQUAL(0, to[0]);
+    TEST_ASSERT_EQUAL(0, to[3]);
+
+    /* Rich get richer: the first nodes out-attract all of the late ones. */
+    late_max = 0;
+    for (node_id = INIT_SIZE / 2; node_id < INIT_SIZE; node_id++)
+    {
+        late_max = (in_degree[node_id] > late_max ? in_degree[node_id] :
+                    late_max);
+    }
+    TEST_ASSERT_TRUE(in_degree[0] + in_degree[1] > 4 * late_max);
+}
+
+void test_fill_graph()
+{
+    long count;
+    long idx;
+    int used;
+
+    count = graph_gen_ba_edges(INIT_SIZE, 4);
+    graph_gen_ba(4, 9, from, to, 0, count);
+    graph_init(&graph, node_arr, INIT_SIZE);
+
+    used = graph_gen_fill(&graph, from, to, count, pool, POOL_SIZE);
+    TEST_ASSERT_EQUAL(INIT_SIZE - 1, used);
+    for (idx = 0; idx < count; idx++)
+    {
+        TEST_ASSERT_EQUAL(0, graph_has_edge(&graph, from[idx], to[idx]));
+    }
+
+    /* A pool too small for every edge is used up. */
+    graph_init(&graph, node_arr, INIT_SIZE);
+    TEST_ASSERT_EQUAL(10, graph_gen_fill(&graph, from, to, count, pool, 10));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  generate R-MAT edges in pieces, verify the same graph  */
+    RUN_TEST(test_rmat_split_matches_whole);
+    /*  generate R-MAT edges, verify the skewed degrees  */
+    RUN_TEST(test_rmat_is_skewed);
+    /*  generate G(n, m) edges, verify distinct pairs and seeds  */
+    RUN_TEST(test_gnm_pairs);
+    /*  generate a grid, verify its edges  */
+    RUN_TEST(test_grid_edges);
+    /*  generate a Barabasi-Albert graph, verify attachment  */
+    RUN_TEST(test_ba_attaches_to_earlier_nodes);
+    /*  load generated edges into a graph  */
+    RUN_TEST(test_fill_graph);
+
+
+    UNITY_END();
+}
+
+/*
+ * Count the edges out of each node among the first @count edges.
+ */
+static void count_out_degrees(int *degree, long count)
+{
+    long idx;
+
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        degree[idx] = 0;
+    }
+    for (idx = 0; idx < count; idx++)
+    {
+        degree[from[idx]]++;
+    }
+}
@@ -0,0 +1,503 @@
+/*
+ * Graphs generated per configuration: slot type, bucket size and weights.
+ *
+ * graph.h fixes one bucket layout for every graph in a program: BUCKET_SIZE
+ * pointers to nodes. That suits neither end of the degree range. Graphs of
+ * low-degree nodes waste most of each bucket, and hubs chase a next pointer
+ * every ten edges, and a ten-pointer bucket straddles cache lines on every
+ * platform. This header uses parameterized macros the same way
+ * dynamic_array.h does, so a program can define as many graph types as it
+ * needs, each with its own:
+ *   - Slot type. Edges store the end node's id in an integer type of the
+ *     user's choice, eg unsigned short for graphs of up to 65536 nodes, which
+ *     fits four times as many edges in a cache line as a pointer does.
+ *   - Bucket size. 'GRAPH_LINE_SLOTS' gives the number of slots that make a
+ *     bucket exactly one cache line in size. A bucket only sits in a single
+ *     line if it also starts at a line boundary: allocate buckets aligned to
+ *     the line size, eg with posix_memalign or from an aligned pool. malloc
+ *     doesn't guarantee it.
+ *   - Weight type, for weighted graphs.
+ * Each type gets its own operations, so every find, add and delete loop is
+ * compiled for its exact slot type and bucket size.
+ *
+ * Buckets keep an occupancy mask like graph.h's: bit i is set if and only if
+ * slot i holds an edge. Slot values of empty slots are meaningless, which is
+ * what lets id 0 be a valid end node.
+ *
+ * Most algorithm headers run on a 'CsrGraph' snapshot from graph_csr.h
+ * rather than on a 'Graph', and every type defined here can build one
+ * directly with 'graph_Name_csr_build'. The headers that walk graph.h's
+ * buckets themselves, such as graph_traverse.h and graph_topo.h, take a
+ * 'Graph' only and can't run on these types.
+ *
+ * === How to Use ===
+ * Put 'DEFINE_GRAPH(Name, SLOT_T, SLOTS)' at the top of your file to define
+ * an unweighted graph type, or 'DEFINE_WEIGHTED_GRAPH(Name, SLOT_T, SLOTS, W)'
+ * for one with a weight of type W on every edge. This defines the structs
+ * 'Graph_Name', 'GraphNode_Name' and 'GraphBucket_Name' and operations named
+ * 'graph_Name_<operation name>'. For example:
+ *   DEFINE_GRAPH(small, unsigned short, GRAPH_LINE_SLOTS(64, 2))
+ *   DEFINE_WEIGHTED_GRAPH(hub, int, 31, float)
+ * defines 'Graph_small', with 64-byte buckets of 2-byte ids, and 'Graph_hub',
+ * with 31 weighted edges per bucket. SLOTS must be between 1 and 32, and
+ * SLOT_T must be able to hold every node id.
+ *
+ * The operations mirror graph.h: 'init', 'add_bucket', 'add_edge', 'del_edge'
+ * and 'has_edge', plus 'get_weight' on weighted graphs, and 'csr_build' for a
+ * snapshot. Like graph.h, this header does no memory management; the client
+ * provides the node array and the buckets, and the snapshot's arrays. To
+ * visit the edges out of a node, use GRAPH_GENERIC_FOR_EACH_OUT_EDGE, which
+ * yields the index of each live slot.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_GENERIC_H
+#define GRAPH_GENERIC_H
+
+#include "graph_csr.h"
+
+/*  index of the lowest set bit of a non-zero unsigned long  */
+#ifndef GRAPH_CTZL
+#ifdef __GNUC__
+#define GRAPH_CTZL(bits) __builtin_ctzl(bits)
+#else
+#define GRAPH_CTZL(bits) graph_generic_ctzl(bits)
+#endif
+#endif
+
+/*
+ * Number of slots of @slot_bytes bytes each that fill a bucket to @line_bytes
+ * bytes, after its next pointer, occupancy mask and count. For weighted
+ * graphs, pass the size of a slot plus the size of a weight.
+ */
+#define GRAPH_LINE_SLOTS(line_bytes, slot_bytes) \
+    (((line_bytes) - sizeof(void *) - sizeof(unsigned long) - sizeof(int)) / \
+     (slot_bytes))
+
+/*
+ * Iterate over the edges out of a node, visiting only live slots.
+ * CAUTION: this is two nested loops. 'break' only leaves the current bucket;
+ *   use goto to stop early.
+ *
+ * @node: Pointer to the node whose edges to visit.
+ * @cursor: A bucket pointer variable of the graph's type, the bucket being
+ *   visited.
+ * @bits: An unsigned long variable, the slots of @cursor left to visit.
+ * @slot: An int variable. Receives the index of each edge in @cursor, so its
+ *   end node is cursor->adj[slot].
+ */
+#define GRAPH_GENERIC_FOR_EACH_OUT_EDGE(node, cursor, bits, slot) \
+    for ((cursor) = (node)->edges_out; (cursor) != 0; \
+         (cursor) = (cursor)->next) \
+        for ((bits) = (cursor)->used; \
+             (bits) != 0 && ((slot) = GRAPH_CTZL(bits), 1); \
+             (bits) &= (bits) - 1)
+
+/*  weight of the edge in a slot, as a snapshot stores it  */
+#define GRAPH_GENERIC_UNIT_WEIGHT(cursor, slot) 1.0
+#define GRAPH_GENERIC_SLOT_WEIGHT(cursor, slot) \
+    ((double)(cursor)->weights[(slot)])
+
+static int graph_generic_ctzl(unsigned long bits);
+
+/*
+ * Macro to define an unweighted graph type and its operations.
+ *
+ * @Name: Name of the type. Must be alphanumerical.
+ * @SLOT_T: Integer type of the node ids kept in the buckets.
+ * @SLOTS: Number of edges per bucket, between 1 and 32.
+ */
+#define DEFINE_GRAPH(Name, SLOT_T, SLOTS) \
+    DEFINE_GRAPH_STRUCTS(Name, SLOT_T, SLOTS) \
+    DEFINE_GRAPH_COMMON(Name, SLOT_T, SLOTS) \
+    DEFINE_GRAPH_ADD_EDGE(Name) \
+    DEFINE_GRAPH_CSR_BUILD(Name, GRAPH_GENERIC_UNIT_WEIGHT)
+
+/*
+ * Macro to define a weighted graph type and its operations.
+ *
+ * @Name: Name of the type. Must be alphanumerical.
+ * @SLOT_T: Integer type of the node ids kept in the buckets.
+ * @SLOTS: Number of edges per bucket, between 1 and 32.
+ * @W: Type of the weights.
+ */
+#define DEFINE_WEIGHTED_GRAPH(Name, SLOT_T, SLOTS, W) \
+    DEFINE_WEIGHTED_GRAPH_STRUCTS(Name, SLOT_T, SLOTS, W) \
+    DEFINE_GRAPH_COMMON(Name, SLOT_T, SLOTS) \
+    DEFINE_WEIGHTED_GRAPH_ADD_EDGE(Name, W) \
+    DEFINE_WEIGHTED_GRAPH_GET_WEIGHT(Name, W) \
+    DEFINE_GRAPH_CSR_BUILD(Name, GRAPH_GENERIC_SLOT_WEIGHT)
+
+/*
+ * The operations shared by weighted and unweighted graphs.
+ */
+#define DEFINE_GRAPH_COMMON(Name, SLOT_T, SLOTS) \
+    DEFINE_GRAPH_INIT(Name) \
+    DEFINE_GRAPH_ADD_BUCKET(Name) \
+    DEFINE_GRAPH_FIND(Name, SLOT_T) \
+    DEFINE_GRAPH_CLAIM(Name, SLOT_T, SLOTS) \
+    DEFINE_GRAPH_DEL_EDGE(Name) \
+    DEFINE_GRAPH_HAS_EDGE(Name)
+
+/*
+ * A bucket of edges out of a node, a node and a graph.
+ * The fields match graph.h's, except that buckets hold node ids in @adj
+ * rather than pointers, the mask is an unsigned long, and nodes have no id
+ * field; a node's id is its index.
+ *
+ * @adj: End node of each edge. Only slots set in @used are meaningful.
+ * @weights: Weight of each edge, in weighted graphs.
+ * @used: Occupancy mask. Bit i is set if and only if slot i holds an edge.
+ * @count: Number of edges in the bucket.
+ * @next: The next bucket. Null if this is the last bucket.
+ */
+#define DEFINE_GRAPH_STRUCTS(Name, SLOT_T, SLOTS) \
+    typedef char graph_##Name##_slots_check[((SLOTS) >= 1 && \
+                                             (SLOTS) <= 32) ? 1 : -1]; \
+    typedef struct GraphBucketTag_##Name \
+    { \
+        struct GraphBucketTag_##Name *next; \
+        unsigned long used; \
+        int count; \
+        SLOT_T adj[SLOTS]; \
+    } GraphBucket_##Name; \
+    DEFINE_GRAPH_NODE_STRUCTS(Name)
+
+#define DEFINE_WEIGHTED_GRAPH_STRUCTS(Name, SLOT_T, SLOTS, W) \
+    typedef char graph_##Name##_slots_check[((SLOTS) >= 1 && \
+                                             (SLOTS) <= 32) ? 1 : -1]; \
+    typedef struct GraphBucketTag_##Name \
+    { \
+        struct GraphBucketTag_##Name *next; \
+        unsigned long used; \
+        int count; \
+        SLOT_T adj[SLOTS]; \
+        W weights[SLOTS]; \
+    } GraphBucket_##Name; \
+    DEFINE_GRAPH_NODE_STRUCTS(Name)
+
+#define DEFINE_GRAPH_NODE_STRUCTS(Name) \
+    typedef struct GraphNodeTag_##Name \
+    { \
+        int degree; \
+        GraphBucket_##Name *edges_out; \
+    } GraphNode_##Name; \
+    \
+    typedef struct GraphTag_##Name \
+    { \
+        int size; \
+        int num_nodes; \
+        int num_edges; \
+        int num_buckets; \
+        GraphNode_##Name *nodes; \
+    } Graph_##Name;
+
+/*
+ * Initialize a graph, as 'graph_init' does.
+ *
+ * @node_arr: An array for the graph to keep its nodes in.
+ * @node_arr_size: The size of @node_arr.
+ */
+#define DEFINE_GRAPH_INIT(Name) \
+    static void graph_##Name##_init(Graph_##Name *graph, \
+                                    GraphNode_##Name *node_arr, \
+                                    int node_arr_size) \
+    { \
+        int idx; \
+        \
+        graph->size = node_arr_size; \
+        graph->num_nodes = 0; \
+        graph->num_edges = 0; \
+        graph->num_buckets = 0; \
+        graph->nodes = node_arr; \
+        for (idx = 0; idx < node_arr_size; idx++) \
+        { \
+            node_arr[idx].degree = 0; \
+            node_arr[idx].edges_out = 0; \
+        } \
+    }
+
+/*
+ * Initialize and add a bucket to the end of a node's edge list.
+ *
+ * @node_id: Id of the node to add @bucket to.
+ * @bucket: Bucket to add. Assumed to be just allocated.
+ */
+#define DEFINE_GRAPH_ADD_BUCKET(Name) \
+    static void graph_##Name##_add_bucket(Graph_##Name *graph, int node_id, \
+                                          GraphBucket_##Name *bucket) \
+    { \
+        GraphBucket_##Name **link; \
+        \
+        bucket->next = 0; \
+        bucket->used = 0; \
+        bucket->count = 0; \
+        \
+        link = &graph->nodes[node_id].edges_out; \
+        while ((*link) != 0) \
+        { \
+            link = &(*link)->next; \
+        } \
+        (*link) = bucket; \
+        graph->num_buckets++; \
+    }
+
+/*
+ * Find the first edge between two nodes.
+ *
+ * @bucket: Receives the bucket holding the edge.
+ * @return: The edge's slot in @bucket, or -1 if there is no such edge.
+ */
+#define DEFINE_GRAPH_FIND(Name, SLOT_T) \
+    static int graph_##Name##_find(Graph_##Name *graph, int from_id, \
+                                   int to_id, GraphBucket_##Name **bucket) \
+    { \
+        int slot; \
+        unsigned long bits; \
+        GraphBucket_##Name *cursor; \
+        \
+        GRAPH_GENERIC_FOR_EACH_OUT_EDGE(&graph->nodes[from_id], cursor, \
+                                        bits, slot) \
+        { \
+            if (cursor->adj[slot] == (SLOT_T)to_id) \
+            { \
+                (*bucket) = cursor; \
+                return slot; \
+            } \
+        } \
+        return -1; \
+    }
+
+/*
+ * Claim the first empty slot of a node for an edge to another node.
+ *
+ * @bucket: Receives the bucket holding the slot.
+ * @return: The slot, or -1 if the node's buckets are full.
+ */
+#define DEFINE_GRAPH_CLAIM(Name, SLOT_T, SLOTS) \
+    static int graph_##Name##_claim(Graph_##Name *graph, int from_id, \
+                                    int to_id, GraphBucket_##Name **bucket) \
+    { \
+        int slot; \
+        unsigned long free_bits; \
+        GraphBucket_##Name *cursor; \
+        \
+        for (cursor = graph->nodes[from_id].edges_out; cursor != 0; \
+             cursor = cursor->next) \
+        { \
+            free_bits = ~cursor->used & ((2UL << ((SLOTS) - 1)) - 1); \
+            if (free_bits != 0) \
+            { \
+                slot = GRAPH_CTZL(free_bits); \
+                cursor->adj[slot] = (SLOT_T)to_id; \
+                cursor->used |= 1UL << slot; \
+                cursor->count++; \
+                graph->nodes[from_id].degree++; \
+                graph->num_edges++; \
+                (*bucket) = cursor; \
+                return slot; \
+            } \
+        } \
+        return -1; \
+    }
+
+/*
+ * Add an edge to a graph.
+ *
+ * @return: 0 if the edge was added, 1 if there wasn't enough space for it.
+ */
+#define DEFINE_GRAPH_ADD_EDGE(Name) \
+    static int graph_##Name##_add_edge(Graph_##Name *graph, int from_id, \
+                                       int to_id) \
+    { \
+        GraphBucket_##Name *bucket; \
+        \
+        return (graph_##Name##_claim(graph, from_id, to_id, &bucket) < 0); \
+    }
+
+/*
+ * Add a weighted edge to a graph.
+ *
+ * @weight: Weight of the edge.
+ * @return: 0 if the edge was added, 1 if there wasn't enough space for it.
+ */
+#define DEFINE_WEIGHTED_GRAPH_ADD_EDGE(Name, W) \
+    static int graph_##Name##_add_edge(Graph_##Name *graph, int from_id, \
+                                       int to_id, W weight) \
+    { \
+        int slot; \
+        GraphBucket_##Name *bucket; \
+        \
+        slot = graph_##Name##_claim(graph, from_id, to_id, &bucket); \
+        if (slot < 0) \
+        { \
+            return 1; \
+        } \
+        bucket->weights[slot] = weight; \
+        return 0; \
+    }
+
+/*
+ * Get the weight of the first edge between two nodes.
+ *
+ * @weight: Receives the weight, if the edge exists.
+ * @return: 0 if the graph has the edge. 1 if it doesnt.
+ */
+#define DEFINE_WEIGHTED_GRAPH_GET_WEIGHT(Name, W) \
+    static int graph_##Name##_get_weight(Graph_##Name *graph, int from_id, \
+                                         int to_id, W *weight) \
+    { \
+        int slot; \
+        GraphBucket_##Name *bucket; \
+        \
+        slot = graph_##Name##_find(graph, from_id, to_id, &bucket); \
+        if (slot < 0) \
+        { \
+            return 1; \
+        } \
+        (*weight) = bucket->weights[slot]; \
+        return 0; \
+    }
+
+/*
+ * Remove the first edge between two nodes. Removing an edge that doesn't
+ * exist does nothing.
+ */
+#define DEFINE_GRAPH_DEL_EDGE(Name) \
+    static void graph_##Name##_del_edge(Graph_##Name *graph, int from_id, \
+                                        int to_id) \
+    { \
+        int slot; \
+        GraphBucket_##Name *bucket; \
+        \
+        slot = graph_##Name##_find(graph, from_id, to_id, &bucket); \
+        if (slot < 0) \
+        { \
+            return; \
+        } \
+        bucket->used &= ~(1UL << slot); \
+        bucket->count--; \
+        graph->nodes[from_id].degree--; \
+        graph->num_edges--; \
+    }
+
+/*
+ * Determine if there is an edge in a graph.
+ *
+ * @return: 0 if the graph has the edge. 1 if it doesnt.
+ */
+#define DEFINE_GRAPH_HAS_EDGE(Name) \
+    static int graph_##Name##_has_edge(Graph_##Name *graph, int from_id, \
+                                       int to_id) \
+    { \
+        GraphBucket_##Name *bucket; \
+        \
+        return (graph_##Name##_find(graph, from_id, to_id, &bucket) < 0); \
+    }
+
+/*
+ * Build a snapshot of a graph, as 'graph_csr_build' does with edges stored
+ * as they are. Rows are sorted and parallel edges merge into one entry, with
+ * the sum of their weights. For an undirected snapshot, add every edge to
+ * the graph in both directions.
+ *
+ * @csr: The snapshot to build.
+ * @offsets: Array for the row offsets. Must hold graph->size + 1 ints.
+ * @adj: Array for the neighbor ids. Must hold graph->num_edges ints.
+ * @weights: Array of graph->num_edges doubles. Receives the weight of each
+ *   entry, converted from the graph's weight type, or 1 on unweighted types.
+ *   May be null, for an unweighted snapshot.
+ */
+#define DEFINE_GRAPH_CSR_BUILD(Name, WEIGHT_OF) \
+    static void graph_##Name##_csr_build(const Graph_##Name *graph, \
+                                         CsrGraph *csr, int *offsets, \
+                                         int *adj, double *weights) \
+    { \
+        int node_id; \
+        int slot; \
+        int read; \
+        int write; \
+        int row_start; \
+        int row_end; \
+        unsigned long bits; \
+        GraphBucket_##Name *cursor; \
+        \
+        csr->num_nodes = graph->size; \
+        csr->offsets = offsets; \
+        csr->adj = adj; \
+        csr->weights = weights; \
+        \
+        /*  copy each row in slot order, offsets[u + 1] is its fill cursor  */ \
+        offsets[0] = 0; \
+        for (node_id = 0; node_id < graph->size; node_id++) \
+        { \
+            offsets[node_id + 1] = offsets[node_id]; \
+            GRAPH_GENERIC_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, \
+                                            bits, slot) \
+            { \
+                adj[offsets[node_id + 1]] = (int)cursor->adj[slot]; \
+                if (weights != 0) \
+                { \
+                    weights[offsets[node_id + 1]] = WEIGHT_OF(cursor, slot); \
+                } \
+                offsets[node_id + 1]++; \
+            } \
+        } \
+        \
+        /*  sort each row and merge parallel edges  */ \
+        write = 0; \
+        row_start = 0; \
+        for (node_id = 0; node_id < graph->size; node_id++) \
+        { \
+            row_end = offsets[node_id + 1]; \
+            graph_csr_sort_row(adj + row_start, \
+                               weights == 0 ? 0 : weights + row_start, \
+                               row_end - row_start); \
+            offsets[node_id] = write; \
+            for (read = row_start; read < row_end; read++) \
+            { \
+                if (write > offsets[node_id] && adj[read] == adj[write - 1]) \
+                { \
+                    if (weights != 0) \
+                    { \
+                        weights[write - 1] += weights[read]; \
+                    } \
+                    continue; \
+                } \
+                adj[write] = adj[read]; \
+                if (weights != 0) \
+                { \
+                    weights[write] = weights[read]; \
+                } \
+                write++; \
+            } \
+            row_start = row_end; \
+        } \
+        offsets[graph->size] = write; \
+        csr->num_entries = write; \
+    }
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the lowest set bit of a mask, for compilers without a builtin.
+ *
+ * @bits: The mask. Assumed to be non-zero.
+ * @return: The index of the lowest set bit.
+ */
+static int graph_generic_ctzl(unsigned long bits)
+{
+    int idx;
+
+    for (idx = 0; !(bits & 1UL); idx++)
+    {
+        bits >>= 1;
+    }
+    return idx;
+}
+
+
+#endif
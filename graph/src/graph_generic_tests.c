@@ -0,0 +1,229 @@
+/*
+ * Unit tests for the generated graph header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_generic.h"
+#include "graph_community.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 40
+#define ACC_SIZE 16
+
+#define SMALL_SLOTS GRAPH_LINE_SLOTS(64, sizeof(unsigned short))
+
+DEFINE_GRAPH(small, unsigned short, SMALL_SLOTS)
+DEFINE_WEIGHTED_GRAPH(hub, int, 3, float)
+
+
+void test_bucket_fills_cache_line()
+{
+    TEST_ASSERT_EQUAL(64, sizeof(GraphBucket_small));
+    TEST_ASSERT_EQUAL(SMALL_SLOTS, sizeof(((GraphBucket_small *)0)->adj) /
+                                   sizeof(unsigned short));
+}
+
+void test_add_and_del_edges()
+{
+    Graph_small graph;
+    GraphNode_small node_arr[INIT_SIZE];
+    GraphBucket_small *first;
+    GraphBucket_small *second;
+    int idx;
+
+    graph_small_init(&graph, node_arr, INIT_SIZE);
+    TEST_ASSERT_EQUAL(1, graph_small_add_edge(&graph, 0, 1));
+
+    first = malloc(sizeof(GraphBucket_small));
+    second = malloc(sizeof(GraphBucket_small));
+    graph_small_add_bucket(&graph, 0, first);
+    graph_small_add_bucket(&graph, 0, second);
+    for (idx = 0; idx < (int)SMALL_SLOTS + 1; idx++)
+    {
+        TEST_ASSERT_EQUAL(0, graph_small_add_edge(&graph, 0, idx));
+    }
+    TEST_ASSERT_EQUAL(SMALL_SLOTS + 1, node_arr[0].degree);
+    TEST_ASSERT_EQUAL(SMALL_SLOTS + 1, graph.num_edges);
+    TEST_ASSERT_EQUAL(2, graph.num_buckets);
+    TEST_ASSERT_EQUAL(SMALL_SLOTS, first->count);
+    TEST_ASSERT_EQUAL(1, second->count);
+
+    /* Node 0 is a valid end node even though empty slots may hold 0. */
+    TEST_ASSERT_EQUAL(0, graph_small_has_edge(&graph, 0, 0));
+    graph_small_del_edge(&graph, 0, 0);
+    TEST_ASSERT_EQUAL(1, graph_small_has_edge(&graph, 0, 0));
+    TEST_ASSERT_EQUAL(0, first->used & 1UL);
+
+    /* The hole is filled before the second bucket. */
+    graph_small_add_edge(&graph, 0, 7);
+    TEST_ASSERT_EQUAL(7, first->adj[0]);
+    TEST_ASSERT_EQUAL(SMALL_SLOTS + 1, node_arr[0].degree);
+
+    graph_small_del_edge(&graph, 0, SMALL_SLOTS);
+    TEST_ASSERT_EQUAL(0, second->used);
+    graph_small_del_edge(&graph, 0, SMALL_SLOTS);
+    TEST_ASSERT_EQUAL(SMALL_SLOTS, graph.num_edges);
+}
+
+void test_weighted_edges()
+{
+    Graph_hub graph;
+    GraphNode_hub node_arr[INIT_SIZE];
+    float weight;
+
+    graph_hub_init(&graph, node_arr, INIT_SIZE);
+    graph_hub_add_bucket(&graph, 2, malloc(sizeof(GraphBucket_hub)));
+    graph_hub_add_bucket(&graph, 2, malloc(sizeof(GraphBucket_hub)));
+    graph_hub_add_edge(&graph, 2, 5, 0.5f);
+    graph_hub_add_edge(&graph, 2, 6, 1.5f);
+    graph_hub_add_edge(&graph, 2, 7, 2.5f);
+    graph_hub_add_edge(&graph, 2, 8, 3.5f);
+    TEST_ASSERT_EQUAL(1, graph_hub_add_edge(&graph, 3, 8, 1.0f));
+
+    TEST_ASSERT_EQUAL(0, graph_hub_get_weight(&graph, 2, 6, &weight));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.5f, weight);
+    TEST_ASSERT_EQUAL(0, graph_hub_get_weight(&graph, 2, 8, &weight));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 3.5f, weight);
+    TEST_ASSERT_EQUAL(1, graph_hub_get_weight(&graph, 2, 9, &weight));
+
+    graph_hub_del_edge(&graph, 2, 6);
+    TEST_ASSERT_EQUAL(1, graph_hub_get_weight(&graph, 2, 6, &weight));
+    graph_hub_add_edge(&graph, 2, 9, 4.5f);
+    TEST_ASSERT_EQUAL(0, graph_hub_get_weight(&graph, 2, 9, &weight));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 4.5f, weight);
+    TEST_ASSERT_EQUAL(4, node_arr[2].degree);
+}
+
+void test_for_each_out_edge()
+{
+    Graph_hub graph;
+    GraphNode_hub node_arr[INIT_SIZE];
+    GraphBucket_hub *cursor;
+    unsigned long bits;
+    int slot;
+    int visits;
+    float total;
+    int idx;
+
+    graph_hub_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < 4; idx++)
+    {
+        graph_hub_add_bucket(&graph, 1, malloc(sizeof(GraphBucket_hub)));
+    }
+    for (idx = 0; idx < 12; idx++)
+    {
+        graph_hub_add_edge(&graph, 1, idx, (float)idx);
+    }
+    /* Empty the second bucket and punch a hole in the third. */
+    graph_hub_del_edge(&graph, 1, 3);
+    graph_hub_del_edge(&graph, 1, 4);
+    graph_hub_del_edge(&graph, 1, 5);
+    graph_hub_del_edge(&graph, 1, 7);
+
+    visits = 0;
+    total = 0.0f;
+    GRAPH_GENERIC_FOR_EACH_OUT_EDGE(&node_arr[1], cursor, bits, slot)
+    {
+        visits++;
+        total += cursor->weights[slot];
+        TEST_ASSERT_EQUAL((float)cursor->adj[slot], cursor->weights[slot]);
+    }
+    TEST_ASSERT_EQUAL(8, visits);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 66.0f - 3 - 4 - 5 - 7, total);
+}
+
+void test_csr_snapshot()
+{
+    Graph_hub graph;
+    GraphNode_hub node_arr[INIT_SIZE];
+    Graph_small small;
+    GraphNode_small small_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrAccum acc;
+    int offsets[INIT_SIZE + 1];
+    int adj[32];
+    double weights[32];
+    int labels[INIT_SIZE];
+    int queue[INIT_SIZE];
+    char queued[INIT_SIZE];
+    int keys[ACC_SIZE], used[ACC_SIZE];
+    double vals[ACC_SIZE];
+    int from[7] = {0, 0, 1, 3, 3, 4, 2};
+    int to[7] = {1, 2, 2, 4, 5, 5, 3};
+    float w[7] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.25f};
+    int idx;
+
+    /* Two triangles and a light bridge, every edge both ways. 0 -> 1 is
+     * split into two parallel edges of half the weight. */
+    graph_hub_init(&graph, node_arr, 6);
+    for (idx = 0; idx < 6; idx++)
+    {
+        graph_hub_add_bucket(&graph, idx, malloc(sizeof(GraphBucket_hub)));
+        graph_hub_add_bucket(&graph, idx, malloc(sizeof(GraphBucket_hub)));
+    }
+    for (idx = 1; idx < 7; idx++)
+    {
+        graph_hub_add_edge(&graph, from[idx], to[idx], w[idx]);
+        graph_hub_add_edge(&graph, to[idx], from[idx], w[idx]);
+    }
+    graph_hub_add_edge(&graph, 0, 1, 0.5f);
+    graph_hub_add_edge(&graph, 1, 0, 1.0f);
+    graph_hub_add_edge(&graph, 0, 1, 0.5f);
+
+    graph_hub_csr_build(&graph, &csr, offsets, adj, weights);
+    TEST_ASSERT_EQUAL(6, csr.num_nodes);
+    TEST_ASSERT_EQUAL(14, csr.num_entries);
+    TEST_ASSERT_EQUAL_FLOAT(1.0, weights[graph_csr_find(&csr, 0, 1)]);
+    TEST_ASSERT_EQUAL_FLOAT(0.25, weights[graph_csr_find(&csr, 3, 2)]);
+    for (idx = 0; idx < csr.num_entries; idx++)
+    {
+        TEST_ASSERT_TRUE(idx == 0 || idx == csr.offsets[1] ||
+                         idx == csr.offsets[2] || idx == csr.offsets[3] ||
+                         idx == csr.offsets[4] || idx == csr.offsets[5] ||
+                         adj[idx - 1] < adj[idx]);
+    }
+
+    /* A CSR algorithm runs on the snapshot as on one of a Graph. */
+    graph_csr_accum_init(&acc, keys, vals, used, ACC_SIZE);
+    TEST_ASSERT_TRUE(graph_label_propagation(&csr, labels, 0, queue, queued,
+                                             &acc, 100) < 100);
+    TEST_ASSERT_EQUAL(labels[0], labels[1]);
+    TEST_ASSERT_EQUAL(labels[0], labels[2]);
+    TEST_ASSERT_EQUAL(labels[3], labels[4]);
+    TEST_ASSERT_EQUAL(labels[3], labels[5]);
+    TEST_ASSERT_TRUE(labels[0] != labels[3]);
+
+    /* An unweighted type, without a weight array. */
+    graph_small_init(&small, small_arr, INIT_SIZE);
+    graph_small_add_bucket(&small, 7, malloc(sizeof(GraphBucket_small)));
+    graph_small_add_edge(&small, 7, 30);
+    graph_small_add_edge(&small, 7, 0);
+    graph_small_csr_build(&small, &csr, offsets, adj, 0);
+    TEST_ASSERT_EQUAL(INIT_SIZE, csr.num_nodes);
+    TEST_ASSERT_EQUAL(2, graph_csr_degree(&csr, 7));
+    TEST_ASSERT_EQUAL(0, adj[csr.offsets[7]]);
+    TEST_ASSERT_TRUE(csr.weights == 0);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  size buckets to a cache line, verify the layout  */
+    RUN_TEST(test_bucket_fills_cache_line);
+    /*  add and delete edges across two buckets, verify masks and counts  */
+    RUN_TEST(test_add_and_del_edges);
+    /*  add, look up and delete weighted edges  */
+    RUN_TEST(test_weighted_edges);
+    /*  iterate over edges around holes and an empty bucket  */
+    RUN_TEST(test_for_each_out_edge);
+    /*  snapshot a weighted graph, run label propagation on it  */
+    RUN_TEST(test_csr_snapshot);
+
+
+    UNITY_END();
+}
@@ -0,0 +1,475 @@
+/*
+ * Subgraph pattern matching for small query graphs.
+ * See Ngo, Porat, Re and Rudra, "Worst-Case Optimal Join Algorithms" (2012)
+ * and Mhedhbi and Salihoglu, "Optimizing Subgraph Queries by Combining Binary
+ * and Worst-Case Optimal Joins" (2019) for the theory.
+ *
+ * A query is a small graph, a path, a star, a triangle, whose nodes may carry
+ * labels. An embedding maps every query node to a distinct node of the data
+ * graph with the same label so that every query edge lands on a data edge.
+ * Instead of nested loops testing edges one at a time, the matcher fixes an
+ * order of the query nodes and extends partial embeddings one node at a time:
+ * the candidates for the next query node are the intersection of the rows of
+ * every data node already matched to one of its query neighbors. Rows of a
+ * snapshot are sorted, so intersections cost no more than the shortest row,
+ * which is what makes this join worst-case optimal. A triangle query is the
+ * familiar triangle listing, a 4-clique needs no extra code.
+ *
+ * The order starts at the query node with the most neighbors, then repeatedly
+ * takes the node with the most neighbors already placed, so candidate sets are
+ * cut down by as many intersections as early as possible.
+ *
+ * Query edges are undirected and match the undirected snapshot from
+ * graph_csr.h. Each embedding is found once per automorphism of the query: a
+ * triangle is found 6 times, once per way of mapping its corners.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. Describe the
+ * query as a Graph and call 'graph_match_query_init'. Then call
+ * 'graph_match_run' with a range [lo, hi) of data node ids for the first query
+ * node: every embedding is found from exactly one root, so ranges can be
+ * handed to separate workers and their counts added. Work per root grows with
+ * its degree; 'graph_match_split' cuts ranges of equal total degree. Each
+ * worker needs its own candidate array of MATCH_INT_WORDS ints.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_MATCH_H
+#define GRAPH_MATCH_H
+
+#include "graph_csr.h"
+
+typedef struct MatchQueryTag MatchQuery;
+
+/*  most nodes a query may have  */
+#define MATCH_MAX_NODES 16
+
+/*  label of a query node that matches data nodes of any label  */
+#define MATCH_ANY -1
+
+/*  ints of candidate space a run needs, given the number of query nodes and
+ *  the largest degree of the snapshot  */
+#define MATCH_INT_WORDS(num_nodes, max_degree) \
+    ((long)((num_nodes) - 1) * (max_degree) + 1)
+
+static int graph_match_fits(const MatchQuery *query, const CsrGraph *csr,
+                            const int *labels, int query_id, int node_id);
+static int graph_match_candidates(const MatchQuery *query,
+                                  const CsrGraph *csr, const int *labels,
+                                  const int *map, int pos, int *cand);
+static int graph_match_intersect(int *cand, int len, const int *row,
+                                 int row_len);
+static void graph_match_store(const MatchQuery *query, const int *map,
+                              int *out, long max_out, long index);
+static int graph_match_bits(unsigned int bits);
+
+/*
+ * A query graph and the order its nodes are matched in.
+ *
+ * @num_nodes: Number of query nodes.
+ * @labels: Label of each query node, MATCH_ANY to match any data node.
+ * @adj: Bit v of adj[u] is set if query nodes u and v are adjacent.
+ * @degree: Number of neighbors of each query node.
+ * @order: Query node matched at each position.
+ * @back: Bit v of back[i] is set if query node v is a neighbor of order[i]
+ *   placed before position i.
+ */
+struct MatchQueryTag
+{
+    int num_nodes;
+    int labels[MATCH_MAX_NODES];
+    unsigned int adj[MATCH_MAX_NODES];
+    int degree[MATCH_MAX_NODES];
+    int order[MATCH_MAX_NODES];
+    unsigned int back[MATCH_MAX_NODES];
+};
+
+
+/*
+ * Read a query from a graph and choose its matching order.
+ * The edges of @pattern are taken as undirected, and self loops are ignored.
+ *
+ * @pattern: The query graph, with one node per query node.
+ * @labels: Label of each node of @pattern, MATCH_ANY for any. May be null, for
+ *   every node matching any label.
+ * @return: 0 on success, 1 if @pattern has more than MATCH_MAX_NODES nodes or
+ *   none, 2 if it isn't connected.
+ */
+static int graph_match_query_init(MatchQuery *query, Graph *pattern,
+                                  const int *labels)
+{
+    int node_id;
+    int pos;
+    int best;
+    int score;
+    int best_score;
+    unsigned int placed;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    if (pattern->size < 1 || pattern->size > MATCH_MAX_NODES)
+    {
+        return 1;
+    }
+
+    query->num_nodes = pattern->size;
+    for (node_id = 0; node_id < pattern->size; node_id++)
+    {
+        query->labels[node_id] = (labels == 0 ? MATCH_ANY : labels[node_id]);
+        query->adj[node_id] = 0;
+    }
+    for (node_id = 0; node_id < pattern->size; node_id++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&pattern->nodes[node_id], cursor, bits,
+                                adj_node)
+        {
+            if (adj_node->id != node_id)
+            {
+                query->adj[node_id] |= 1U << adj_node->id;
+                query->adj[adj_node->id] |= 1U << node_id;
+            }
+        }
+    }
+    for (node_id = 0; node_id < pattern->size; node_id++)
+    {
+        query->degree[node_id] = graph_match_bits(query->adj[node_id]);
+    }
+
+    /*  most placed neighbors first, then most neighbors, then lowest id  */
+    placed = 0;
+    for (pos = 0; pos < query->num_nodes; pos++)
+    {
+        best = -1;
+        best_score = -1;
+        for (node_id = 0; node_id < query->num_nodes; node_id++)
+        {
+            if (placed & (1U << node_id))
+            {
+                continue;
+            }
+            score = graph_match_bits(query->adj[node_id] & placed) *
+                    (MATCH_MAX_NODES + 1) + query->degree[node_id];
+            if (score > best_score)
+            {
+                best = node_id;
+                best_score = score;
+            }
+        }
+
+        query->order[pos] = best;
+        query->back[pos] = query->adj[best] & placed;
+        if (pos > 0 && query->back[pos] == 0)
+        {
+            return 2;
+        }
+        placed |= 1U << best;
+    }
+
+    return 0;
+}
+
+/*
+ * Find the embeddings of a query whose first matched node is in a range of
+ * data nodes.
+ *
+ * @csr: Undirected snapshot of the data graph.
+ * @labels: Label of each data node. May be null, for queries without labels.
+ * @lo: First data node id to try as the root.
+ * @hi: One past the last data node id to try as the root.
+ * @cand: Array of MATCH_INT_WORDS(query->num_nodes, largest degree) ints.
+ * @out: Receives the first @max_out embeddings, query->num_nodes ints each,
+ *   the data node of each query node by query node id. May be null.
+ * @max_out: Most embeddings to write to @out.
+ * @return: The number of embeddings found, including those not written.
+ */
+static long graph_match_run(const MatchQuery *query, const CsrGraph *csr,
+                            const int *labels, int lo, int hi, int *cand,
+                            int *out, long max_out)
+{
+    int map[MATCH_MAX_NODES];
+    int base[MATCH_MAX_NODES];
+    int next[MATCH_MAX_NODES];
+    int len[MATCH_MAX_NODES];
+    int last;
+    int pos;
+    int idx;
+    int root_id;
+    int node_id;
+    long count;
+
+    count = 0;
+    last = query->num_nodes - 1;
+    for (root_id = lo; root_id < hi; root_id++)
+    {
+        if (!graph_match_fits(query, csr, labels, query->order[0], root_id))
+        {
+            continue;
+        }
+        map[query->order[0]] = root_id;
+        if (last == 0)
+        {
+            graph_match_store(query, map, out, max_out, count++);
+            continue;
+        }
+
+        /*  extend depth first, the candidates of each position are stacked
+         *  in @cand after those of the one before  */
+        pos = 1;
+        base[1] = 0;
+        len[1] = graph_match_candidates(query, csr, labels, map, 1, cand);
+        next[1] = 0;
+        while (pos >= 1)
+        {
+            if (next[pos] == len[pos])
+            {
+                pos--;
+                continue;
+            }
+            node_id = cand[base[pos] + next[pos]++];
+
+            /*  embeddings are injective  */
+            for (idx = 0; idx < pos; idx++)
+            {
+                if (map[query->order[idx]] == node_id)
+                {
+                    break;
+                }
+            }
+            if (idx < pos)
+            {
+                continue;
+            }
+
+            map[query->order[pos]] = node_id;
+            if (pos == last)
+            {
+                graph_match_store(query, map, out, max_out, count++);
+                continue;
+            }
+            base[pos + 1] = base[pos] + len[pos];
+            pos++;
+            len[pos] = graph_match_candidates(query, csr, labels, map, pos,
+                                              cand + base[pos]);
+            next[pos] = 0;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Cut the data nodes into ranges of roughly equal work for 'graph_match_run',
+ * counting the work of a root as its degree plus one.
+ *
+ * @num_ranges: Number of ranges.
+ * @bounds: Array of @num_ranges + 1 ints. Range r is [bounds[r],
+ *   bounds[r + 1]).
+ */
+static void graph_match_split(const CsrGraph *csr, int num_ranges, int *bounds)
+{
+    long total;
+    long sum;
+    int range;
+    int node_id;
+
+    total = (long)csr->num_entries + csr->num_nodes;
+    bounds[0] = 0;
+    node_id = 0;
+    sum = 0;
+    for (range = 1; range < num_ranges; range++)
+    {
+        while (node_id < csr->num_nodes &&
+               sum * num_ranges < total * range)
+        {
+            sum += graph_csr_degree(csr, node_id) + 1;
+            node_id++;
+        }
+        bounds[range] = node_id;
+    }
+    bounds[num_ranges] = csr->num_nodes;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Determine if a data node may match a query node on its own: the labels agree
+ * and it has at least as many neighbors.
+ *
+ * @return: Bool. 1 if it may match, 0 if not.
+ */
+static int graph_match_fits(const MatchQuery *query, const CsrGraph *csr,
+                            const int *labels, int query_id, int node_id)
+{
+    if (query->labels[query_id] != MATCH_ANY &&
+        (labels == 0 || labels[node_id] != query->labels[query_id]))
+    {
+        return 0;
+    }
+    return graph_csr_degree(csr, node_id) >= query->degree[query_id];
+}
+
+/*
+ * Find the candidates for the query node at a position of the order: the data
+ * nodes adjacent to the matches of all of its placed neighbors that fit it.
+ *
+ * @map: Data node of each query node placed so far.
+ * @pos: Position of the query node in the order.
+ * @cand: Receives the candidates, in increasing order.
+ * @return: The number of candidates.
+ */
+static int graph_match_candidates(const MatchQuery *query,
+                                  const CsrGraph *csr, const int *labels,
+                                  const int *map, int pos, int *cand)
+{
+    int query_id;
+    int start_id;
+    int other_id;
+    int node_id;
+    int entry;
+    int len;
+    unsigned int bits;
+
+    /*  start from the shortest row, it bounds the result  */
+    start_id = -1;
+    for (bits = query->back[pos]; bits != 0; bits &= bits - 1)
+    {
+        other_id = map[GRAPH_CTZ(bits)];
+        if (start_id < 0 ||
+            graph_csr_degree(csr, other_id) < graph_csr_degree(csr, start_id))
+        {
+            start_id = other_id;
+        }
+    }
+
+    query_id = query->order[pos];
+    len = 0;
+    for (entry = csr->offsets[start_id];
+         entry < csr->offsets[start_id + 1]; entry++)
+    {
+        node_id = csr->adj[entry];
+        if (graph_match_fits(query, csr, labels, query_id, node_id))
+        {
+            cand[len++] = node_id;
+        }
+    }
+
+    for (bits = query->back[pos]; bits != 0 && len > 0; bits &= bits - 1)
+    {
+        other_id = map[GRAPH_CTZ(bits)];
+        if (other_id != start_id)
+        {
+            len = graph_match_intersect(cand, len,
+                                        csr->adj + csr->offsets[other_id],
+                                        graph_csr_degree(csr, other_id));
+        }
+    }
+
+    return len;
+}
+
+/*
+ * Intersect a sorted list with a sorted row in place. A row much longer than
+ * the list is binary searched instead of merged.
+ *
+ * @cand: The list. Receives the intersection.
+ * @len: Length of @cand.
+ * @row: The row.
+ * @row_len: Length of @row.
+ * @return: Length of the intersection.
+ */
+static int graph_match_intersect(int *cand, int len, const int *row,
+                                 int row_len)
+{
+    int read;
+    int write;
+    int low;
+    int high;
+    int mid;
+
+    write = 0;
+    low = 0;
+    if (row_len > 8 * len)
+    {
+        for (read = 0; read < len; read++)
+        {
+            high = row_len;
+            while (low < high)
+            {
+                mid = low + (high - low) / 2;
+                if (row[mid] < cand[read])
+                {
+                    low = mid + 1;
+                }
+                else
+                {
+                    high = mid;
+                }
+            }
+            if (low < row_len && row[low] == cand[read])
+            {
+                cand[write++] = cand[read];
+            }
+        }
+        return write;
+    }
+
+    for (read = 0; read < len && low < row_len; )
+    {
+        if (cand[read] < row[low])
+        {
+            read++;
+        }
+        else if (row[low] < cand[read])
+        {
+            low++;
+        }
+        else
+        {
+            cand[write++] = cand[read];
+            read++;
+            low++;
+        }
+    }
+    return write;
+}
+
+/*
+ * Write an embedding to the output array if it has room.
+ *
+ * @index: Number of embeddings found before this one.
+ */
+static void graph_match_store(const MatchQuery *query, const int *map,
+                              int *out, long max_out, long index)
+{
+    int idx;
+
+    if (out == 0 || index >= max_out)
+    {
+        return;
+    }
+    for (idx = 0; idx < query->num_nodes; idx++)
+    {
+        out[index * query->num_nodes + idx] = map[idx];
+    }
+}
+
+/*
+ * Count the set bits of a word.
+ */
+static int graph_match_bits(unsigned int bits)
+{
+    int count;
+
+    for (count = 0; bits != 0; bits &= bits - 1)
+    {
+        count++;
+    }
+    return count;
+}
+
+
+#endif
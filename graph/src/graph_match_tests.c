@@ -0,0 +1,282 @@
+/*
+ * Unit tests for the subgraph pattern matching header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_match.h"
+#include "graph_generators.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 8
+#define DATA_SIZE 60
+#define DATA_EDGES 400
+#define NUM_RANGES 5
+
+static void init_pattern(Graph *pattern, Node *node_arr, int size);
+static void init_data(Graph *graph, Node *node_arr, CsrGraph *csr,
+                      int *offsets, int *adj);
+static int max_degree(const CsrGraph *csr);
+static long naive_triangles(const CsrGraph *csr);
+
+
+void test_query_order()
+{
+    Graph pattern;
+    Node node_arr[INIT_SIZE];
+    MatchQuery query;
+
+    /* A star around node 2 with a tail 3 - 4. */
+    init_pattern(&pattern, node_arr, 5);
+    graph_add_edge(&pattern, 2, 0);
+    graph_add_edge(&pattern, 1, 2);
+    graph_add_edge(&pattern, 2, 3);
+    graph_add_edge(&pattern, 3, 4);
+
+    TEST_ASSERT_EQUAL(0, graph_match_query_init(&query, &pattern, 0));
+    TEST_ASSERT_EQUAL(2, query.order[0]);
+    TEST_ASSERT_EQUAL(3, query.order[1]);
+    TEST_ASSERT_EQUAL(1U << 2, query.back[1]);
+    TEST_ASSERT_EQUAL(3, query.degree[2]);
+
+    /* Node 4 loses its only edge. */
+    init_pattern(&pattern, node_arr, 5);
+    graph_add_edge(&pattern, 2, 0);
+    graph_add_edge(&pattern, 1, 2);
+    graph_add_edge(&pattern, 2, 3);
+    TEST_ASSERT_EQUAL(2, graph_match_query_init(&query, &pattern, 0));
+}
+
+void test_cliques_in_clique()
+{
+    Graph pattern;
+    Node pattern_arr[INIT_SIZE];
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    MatchQuery query;
+    int offsets[INIT_SIZE + 1];
+    int adj[INIT_SIZE * INIT_SIZE];
+    int cand[MATCH_INT_WORDS(4, INIT_SIZE)];
+    int from;
+    int to;
+
+    /* K6 holds 6 * 5 * 4 * 3 ordered 4-cliques. */
+    init_pattern(&graph, node_arr, 6);
+    for (from = 0; from < 6; from++)
+    {
+        for (to = from + 1; to < 6; to++)
+        {
+            graph_add_edge(&graph, from, to);
+        }
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    init_pattern(&pattern, pattern_arr, 4);
+    for (from = 0; from < 4; from++)
+    {
+        for (to = from + 1; to < 4; to++)
+        {
+            graph_add_edge(&pattern, from, to);
+        }
+    }
+    graph_match_query_init(&query, &pattern, 0);
+    TEST_ASSERT_EQUAL(360, graph_match_run(&query, &csr, 0, 0, 6, cand, 0, 0));
+
+    /* A single node matches every node. */
+    init_pattern(&pattern, pattern_arr, 1);
+    graph_match_query_init(&query, &pattern, 0);
+    TEST_ASSERT_EQUAL(6, graph_match_run(&query, &csr, 0, 0, 6, cand, 0, 0));
+}
+
+void test_triangles_match_naive()
+{
+    Graph pattern;
+    Node pattern_arr[INIT_SIZE];
+    Graph graph;
+    Node node_arr[DATA_SIZE];
+    CsrGraph csr;
+    MatchQuery query;
+    int offsets[DATA_SIZE + 1];
+    int *adj;
+    int *cand;
+    int bounds[NUM_RANGES + 1];
+    long whole;
+    long split;
+    int range;
+
+    adj = malloc(2 * DATA_EDGES * sizeof(int));
+    init_data(&graph, node_arr, &csr, offsets, adj);
+    cand = malloc(MATCH_INT_WORDS(3, max_degree(&csr)) * sizeof(int));
+
+    init_pattern(&pattern, pattern_arr, 3);
+    graph_add_edge(&pattern, 0, 1);
+    graph_add_edge(&pattern, 1, 2);
+    graph_add_edge(&pattern, 2, 0);
+    graph_match_query_init(&query, &pattern, 0);
+
+    whole = graph_match_run(&query, &csr, 0, 0, DATA_SIZE, cand, 0, 0);
+    TEST_ASSERT_TRUE(whole > 0);
+    TEST_ASSERT_EQUAL(6 * naive_triangles(&csr), whole);
+
+    /* Root ranges partition the embeddings. */
+    graph_match_split(&csr, NUM_RANGES, bounds);
+    TEST_ASSERT_EQUAL(0, bounds[0]);
+    TEST_ASSERT_EQUAL(DATA_SIZE, bounds[NUM_RANGES]);
+    split = 0;
+    for (range = 0; range < NUM_RANGES; range++)
+    {
+        TEST_ASSERT_TRUE(bounds[range] <= bounds[range + 1]);
+        split += graph_match_run(&query, &csr, 0, bounds[range],
+                                 bounds[range + 1], cand, 0, 0);
+    }
+    TEST_ASSERT_EQUAL(whole, split);
+    free(cand);
+    free(adj);
+}
+
+void test_labeled_path()
+{
+    Graph pattern;
+    Node pattern_arr[INIT_SIZE];
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    MatchQuery query;
+    int offsets[INIT_SIZE + 1];
+    int adj[INIT_SIZE * INIT_SIZE];
+    int cand[MATCH_INT_WORDS(3, INIT_SIZE)];
+    int out[3 * 4];
+    int data_labels[INIT_SIZE] = {0, 1, 0, 1, 2, 0, 0, 0};
+    int query_labels[3] = {1, 2, MATCH_ANY};
+    long found;
+    int idx;
+
+    /* 0 - 1 - 4 - 3 - 2, and 4 - 5. */
+    init_pattern(&graph, node_arr, INIT_SIZE);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 1, 4);
+    graph_add_edge(&graph, 4, 3);
+    graph_add_edge(&graph, 3, 2);
+    graph_add_edge(&graph, 4, 5);
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    /* A node labeled 1, then one labeled 2, then any other node. */
+    init_pattern(&pattern, pattern_arr, 3);
+    graph_add_edge(&pattern, 0, 1);
+    graph_add_edge(&pattern, 1, 2);
+    graph_match_query_init(&query, &pattern, query_labels);
+
+    found = graph_match_run(&query, &csr, data_labels, 0, INIT_SIZE, cand,
+                            out, 4);
+    TEST_ASSERT_EQUAL(4, found);
+    for (idx = 0; idx < found; idx++)
+    {
+        TEST_ASSERT_EQUAL(1, data_labels[out[3 * idx]]);
+        TEST_ASSERT_EQUAL(4, out[3 * idx + 1]);
+        TEST_ASSERT_TRUE(out[3 * idx + 2] != out[3 * idx]);
+        TEST_ASSERT_TRUE(graph_csr_find(&csr, 4, out[3 * idx + 2]) >= 0);
+    }
+
+    /* The count doesn't stop at the output's size. */
+    TEST_ASSERT_EQUAL(4, graph_match_run(&query, &csr, data_labels, 0,
+                                         INIT_SIZE, cand, out, 1));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  order a star with a tail, reject a disconnected query  */
+    RUN_TEST(test_query_order);
+    /*  match 4-cliques and single nodes in a 6-clique  */
+    RUN_TEST(test_cliques_in_clique);
+    /*  count triangles of a random graph, whole and split by roots  */
+    RUN_TEST(test_triangles_match_naive);
+    /*  match a labeled path, verify the embeddings written out  */
+    RUN_TEST(test_labeled_path);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize a graph with one bucket per node.
+ */
+static void init_pattern(Graph *pattern, Node *node_arr, int size)
+{
+    int idx;
+
+    graph_init(pattern, node_arr, size);
+    for (idx = 0; idx < size; idx++)
+    {
+        graph_add_bucket(pattern, idx, malloc(sizeof(Bucket)));
+    }
+}
+
+/*
+ * Build a random graph and take an undirected snapshot of it.
+ */
+static void init_data(Graph *graph, Node *node_arr, CsrGraph *csr,
+                      int *offsets, int *adj)
+{
+    int from[DATA_EDGES];
+    int to[DATA_EDGES];
+
+    graph_gen_gnm(DATA_SIZE, 5, from, to, 0, DATA_EDGES);
+    graph_init(graph, node_arr, DATA_SIZE);
+    graph_gen_fill(graph, from, to, DATA_EDGES,
+                   malloc(DATA_EDGES * sizeof(Bucket)), DATA_EDGES);
+    graph_csr_build(graph, csr, offsets, adj, 1);
+}
+
+/*
+ * Find the largest degree of a snapshot.
+ */
+static int max_degree(const CsrGraph *csr)
+{
+    int node_id;
+    int best;
+
+    best = 0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        if (graph_csr_degree(csr, node_id) > best)
+        {
+            best = graph_csr_degree(csr, node_id);
+        }
+    }
+    return best;
+}
+
+/*
+ * Count triangles by testing every triple.
+ */
+static long naive_triangles(const CsrGraph *csr)
+{
+    long count;
+    int first;
+    int second;
+    int third;
+
+    count = 0;
+    for (first = 0; first < csr->num_nodes; first++)
+    {
+        for (second = first + 1; second < csr->num_nodes; second++)
+        {
+            for (third = second + 1; third < csr->num_nodes; third++)
+            {
+                if (graph_csr_find(csr, first, second) >= 0 &&
+                    graph_csr_find(csr, second, third) >= 0 &&
+                    graph_csr_find(csr, first, third) >= 0)
+                {
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
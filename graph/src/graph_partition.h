@@ -0,0 +1,1017 @@
+/*
+ * Balanced graph partitioning and relabeling for locality.
+ * See Stanton and Kliot, "Streaming Graph Partitioning for Large Distributed
+ * Graphs" (2012), Tsourakakis et al, "FENNEL: Streaming Graph Partitioning for
+ * Massive Scale Graphs" (2014) and Karypis and Kumar, "A Fast and High Quality
+ * Multilevel Scheme for Partitioning Irregular Graphs" (1998) for the theory.
+ *
+ * Splitting the nodes of a graph between workers by id range puts every
+ * neighbor anywhere, so most edges cross between workers. A partition into k
+ * parts of about equal size with few edges between them keeps most of each
+ * worker's reads in its own part. This header offers three partitioners:
+ *   - Linear deterministic greedy (LDG): nodes arrive one at a time and join
+ *     the part holding most of their neighbors, discounted by how full it is.
+ *     One pass over the edges.
+ *   - Fennel: the same stream, but each part's score is its neighbors minus
+ *     a cost that grows with its size. Usually cuts fewer edges than LDG.
+ *   - Multilevel: the graph is coarsened by repeatedly merging each node with
+ *     the neighbor it shares the heaviest edge with, the small coarsest graph
+ *     is partitioned by growing regions breadth-first, and the partition is
+ *     projected back through the levels, moving boundary nodes to the part
+ *     they are most connected to at every level. Slower, and much better
+ *     cuts.
+ * Parts are held to at most slack * n / k nodes, eg a slack of 1.03 allows
+ * 3% imbalance.
+ *
+ * 'graph_partition_relabel' then gives each part a contiguous range of new
+ * ids, keeping the old order within each part, and 'graph_partition_permute'
+ * rebuilds a snapshot under the new ids. Workers given the ranges of the
+ * relabeled snapshot as their [lo, hi) ranges mostly touch their own nodes.
+ *
+ * All partitioners operate on an undirected snapshot built by graph_csr.h.
+ * Weights are used if present.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. The streaming
+ * partitioners take an int array of part sizes and a double array of
+ * connection weights, each with one entry per part.
+ *
+ * The multilevel partitioner keeps its coarse graphs in a 'Partition'
+ * workspace. Allocate PARTITION_INT_WORDS(n, m, k) ints and
+ * PARTITION_DOUBLE_WORDS(m, k) doubles, where n and m are the node and entry
+ * counts of the snapshot and k the number of parts, and hand them to
+ * 'graph_partition_init'. Smaller buffers work too; coarsening just stops at
+ * the last level that fits. Needs to be linked with the math library (-lm).
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_PARTITION_H
+#define GRAPH_PARTITION_H
+
+#include <math.h>
+#include "graph_csr.h"
+#include "graph_rng.h"
+
+typedef struct PartitionTag Partition;
+
+/*  scoring rules of the streaming partitioners  */
+#define PARTITION_LDG 0
+#define PARTITION_FENNEL 1
+
+/*  the most levels the multilevel partitioner builds  */
+#define PARTITION_MAX_LEVELS 32
+
+/*  coarsening stops at about this many nodes per part  */
+#define PARTITION_COARSE_NODES 16
+
+/*  number of partitions of the coarsest level tried, the best is kept  */
+#define PARTITION_TRIALS 8
+
+/*  workspace sizes for a snapshot with n nodes, m entries and k parts  */
+#define PARTITION_INT_WORDS(n, m, k) (2 * (k) + 11 * (n) + 2 * (m))
+#define PARTITION_DOUBLE_WORDS(m, k) ((k) + 2 * (m))
+
+static int graph_partition_capacity(int total_weight, int k, double slack);
+static void graph_partition_stream(const CsrGraph *csr, int *parts,
+                                   int *sizes, double *conn, int k,
+                                   int capacity, int method, double alpha,
+                                   double gamma, const int *order);
+static int graph_partition_match(Partition *pt, int level, unsigned long seed,
+                                 int max_weight);
+static int graph_partition_coarsen(Partition *pt, int level, int count);
+static void graph_partition_grow(Partition *pt, int level, int *parts,
+                                 GraphRng *rng);
+static void graph_partition_refine(Partition *pt, int level, int *parts,
+                                   int capacity, int passes);
+
+/*
+ * A multilevel partitioning workspace.
+ *
+ * @k: Number of parts.
+ * @slack: The most a part may weigh, relative to an even split.
+ * @num_nodes: The most nodes a partitioned snapshot will have.
+ * @sizes: Weight of each part.
+ * @touched: Parts a node is connected to, during refinement.
+ * @conn: Weight of the entries from a node to each part.
+ * @order: Visiting order during matching, then the first member of each
+ *   coarse node, then a buffer for the parts of every other level.
+ * @match: The node each node is merged with, itself if none.
+ * @mark: Last coarse node each coarse node was seen from, while coarsening.
+ * @pos: Entry of each coarse node in the row being built.
+ * @pool: Storage for the levels.
+ * @pool_size: Number of ints in @pool.
+ * @pool_used: Number of ints of @pool in use.
+ * @weight_pool: Storage for the coarse levels' weights.
+ * @weight_pool_size: Number of doubles in @weight_pool.
+ * @weight_pool_used: Number of doubles of @weight_pool in use.
+ * @levels: The snapshot and its coarsened versions, finest first.
+ * @node_weight: Number of original nodes in each node of each level.
+ * @coarse_of: The node of the next level each node of a level merged into.
+ * @num_levels: Number of levels built by the last run.
+ */
+struct PartitionTag
+{
+    int k;
+    double slack;
+    int num_nodes;
+    int *sizes;
+    int *touched;
+    double *conn;
+    int *order;
+    int *match;
+    int *mark;
+    int *pos;
+    int *pool;
+    long pool_size;
+    long pool_used;
+    double *weight_pool;
+    long weight_pool_size;
+    long weight_pool_used;
+    CsrGraph levels[PARTITION_MAX_LEVELS];
+    int *node_weight[PARTITION_MAX_LEVELS];
+    int *coarse_of[PARTITION_MAX_LEVELS];
+    int num_levels;
+};
+
+/*
+ * Partition a graph in one streaming pass with linear deterministic greedy.
+ * Each node joins the part maximizing its neighbors there times
+ * (1 - size / capacity), ties going to the smaller part.
+ *
+ * @csr: Undirected snapshot.
+ * @parts: Array of csr->num_nodes ints. Receives each node's part.
+ * @sizes: Array of @k ints. Receives the number of nodes in each part.
+ * @conn: Scratch array of @k doubles.
+ * @k: Number of parts.
+ * @slack: The most a part may hold relative to an even split, at least 1.
+ * @order: Order to stream the nodes in. May be null for id order.
+ */
+static void graph_partition_ldg(const CsrGraph *csr, int *parts, int *sizes,
+                                double *conn, int k, double slack,
+                                const int *order)
+{
+    int idx;
+
+    for (idx = 0; idx < csr->num_nodes; idx++)
+    {
+        parts[idx] = -1;
+    }
+    for (idx = 0; idx < k; idx++)
+    {
+        sizes[idx] = 0;
+        conn[idx] = 0.0;
+    }
+    graph_partition_stream(csr, parts, sizes, conn, k,
+                           graph_partition_capacity(csr->num_nodes, k, slack),
+                           PARTITION_LDG, 0.0, 0.0, order);
+}
+
+/*
+ * Partition a graph in one streaming pass with Fennel.
+ * Each node joins the part maximizing its neighbors there minus
+ * alpha * gamma * size^(gamma - 1), with alpha = m * k^(gamma - 1) / n^gamma
+ * for m edges, and no part grows past its capacity.
+ *
+ * @csr: Undirected snapshot.
+ * @parts: Array of csr->num_nodes ints. Receives each node's part.
+ * @sizes: Array of @k ints. Receives the number of nodes in each part.
+ * @conn: Scratch array of @k doubles.
+ * @k: Number of parts.
+ * @slack: The most a part may hold relative to an even split, at least 1.
+ * @gamma: Exponent of the size cost, usually 1.5.
+ * @order: Order to stream the nodes in. May be null for id order.
+ */
+static void graph_partition_fennel(const CsrGraph *csr, int *parts,
+                                   int *sizes, double *conn, int k,
+                                   double slack, double gamma,
+                                   const int *order)
+{
+    int idx;
+    double edges;
+    double alpha;
+
+    for (idx = 0; idx < csr->num_nodes; idx++)
+    {
+        parts[idx] = -1;
+    }
+    for (idx = 0; idx < k; idx++)
+    {
+        sizes[idx] = 0;
+        conn[idx] = 0.0;
+    }
+
+    edges = 0.0;
+    for (idx = 0; idx < csr->num_entries; idx++)
+    {
+        edges += graph_csr_weight(csr, idx);
+    }
+    edges /= 2.0;
+    alpha = (csr->num_nodes > 0 ?
+             edges * pow((double)k, gamma - 1.0) /
+             pow((double)csr->num_nodes, gamma) : 0.0);
+
+    graph_partition_stream(csr, parts, sizes, conn, k,
+                           graph_partition_capacity(csr->num_nodes, k, slack),
+                           PARTITION_FENNEL, alpha, gamma, order);
+}
+
+/*
+ * Get the weight of the edges between different parts.
+ *
+ * @csr: Undirected snapshot.
+ * @parts: Part of each node.
+ */
+static double graph_partition_cut(const CsrGraph *csr, const int *parts)
+{
+    int node_id;
+    int entry;
+    double cut;
+
+    cut = 0.0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (parts[csr->adj[entry]] != parts[node_id])
+            {
+                cut += graph_csr_weight(csr, entry);
+            }
+        }
+    }
+
+    /*  every undirected edge was seen from both ends  */
+    return cut / 2.0;
+}
+
+/*
+ * Initialize a multilevel partitioning workspace.
+ *
+ * @k: Number of parts.
+ * @slack: The most a part may hold relative to an even split, at least 1.
+ * @num_nodes: The most nodes a partitioned snapshot will have.
+ * @int_buf: Array of @int_words ints, ideally
+ *   PARTITION_INT_WORDS(@num_nodes, m, @k) for snapshots of m entries. Must
+ *   hold at least 2 * @k + 5 * @num_nodes.
+ * @int_words: Number of ints in @int_buf.
+ * @double_buf: Array of @double_words doubles, ideally
+ *   PARTITION_DOUBLE_WORDS(m, @k). Must hold at least @k.
+ * @double_words: Number of doubles in @double_buf.
+ */
+static void graph_partition_init(Partition *pt, int k, double slack,
+                                 int num_nodes, int *int_buf, long int_words,
+                                 double *double_buf, long double_words)
+{
+    pt->k = k;
+    pt->slack = slack;
+    pt->num_nodes = num_nodes;
+    pt->sizes = int_buf;
+    pt->touched = int_buf + k;
+    pt->order = int_buf + 2 * k;
+    pt->match = pt->order + num_nodes;
+    pt->mark = pt->match + num_nodes;
+    pt->pos = pt->mark + num_nodes;
+    pt->pool = pt->pos + num_nodes;
+    pt->pool_size = int_words - 2 * k - 4 * (long)num_nodes;
+    pt->pool_used = 0;
+    pt->conn = double_buf;
+    pt->weight_pool = double_buf + k;
+    pt->weight_pool_size = double_words - k;
+    pt->weight_pool_used = 0;
+    pt->num_levels = 0;
+}
+
+/*
+ * Partition a graph with the multilevel scheme.
+ *
+ * @pt: Workspace initialized for at least the size of @csr.
+ * @csr: Undirected snapshot.
+ * @parts: Array of csr->num_nodes ints. Receives each node's part.
+ * @seed: Seed of the order nodes are matched in.
+ * @passes: The most refinement passes over each level.
+ * @return: The weight of the edges cut by @parts.
+ */
+static double graph_partition_multilevel(Partition *pt, const CsrGraph *csr,
+                                         int *parts, unsigned long seed,
+                                         int passes)
+{
+    int level;
+    int node_id;
+    int count;
+    int part;
+    int trial;
+    int capacity;
+    int max_weight;
+    int *coarse_parts;
+    int *fine_parts;
+    int *trial_parts;
+    const int *coarse_of;
+    double cut;
+    double best_cut;
+    GraphRng rng;
+
+    pt->pool_used = 0;
+    pt->weight_pool_used = 0;
+    pt->levels[0] = *csr;
+    pt->node_weight[0] = pt->pool;
+    pt->pool_used = csr->num_nodes;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        pt->node_weight[0][node_id] = 1;
+    }
+
+    /*  merged nodes stay light enough for the coarsest level to balance  */
+    capacity = graph_partition_capacity(csr->num_nodes, pt->k, pt->slack);
+    max_weight = csr->num_nodes / (pt->k * PARTITION_COARSE_NODES);
+    if (max_weight < 1)
+    {
+        max_weight = 1;
+    }
+
+    level = 0;
+    while (level + 1 < PARTITION_MAX_LEVELS &&
+           pt->levels[level].num_nodes > pt->k * PARTITION_COARSE_NODES)
+    {
+        count = graph_partition_match(pt, level, seed, max_weight);
+        if (count < 0 ||
+            (long)count * 20 > (long)pt->levels[level].num_nodes * 19)
+        {
+            /*  out of space, or too little left to merge  */
+            break;
+        }
+        if (!graph_partition_coarsen(pt, level, count))
+        {
+            break;
+        }
+        level++;
+    }
+    pt->num_levels = level + 1;
+
+    /*  the parts of level j live in @parts for even j, @order for odd j  */
+    coarse_parts = (level % 2 == 0 ? parts : pt->order);
+    /*  try several partitions of the coarsest level, in the other buffer  */
+    trial_parts = (level % 2 == 0 ? pt->order : parts);
+    for (part = 0; part < pt->k; part++)
+    {
+        pt->conn[part] = 0.0;
+    }
+    graph_rng_seed(&rng, seed, (unsigned long)PARTITION_MAX_LEVELS);
+    best_cut = -1.0;
+    for (trial = 0; trial < PARTITION_TRIALS; trial++)
+    {
+        graph_partition_grow(pt, level, trial_parts, &rng);
+        graph_partition_refine(pt, level, trial_parts, capacity, passes);
+        cut = graph_partition_cut(&pt->levels[level], trial_parts);
+        if (best_cut < 0.0 || cut < best_cut)
+        {
+            best_cut = cut;
+            for (node_id = 0; node_id < pt->levels[level].num_nodes;
+                 node_id++)
+            {
+                coarse_parts[node_id] = trial_parts[node_id];
+            }
+        }
+    }
+
+    /*  project each level's parts onto the next finer level and refine  */
+    while (level > 0)
+    {
+        level--;
+        fine_parts = (level % 2 == 0 ? parts : pt->order);
+        coarse_of = pt->coarse_of[level];
+        for (node_id = 0; node_id < pt->levels[level].num_nodes; node_id++)
+        {
+            fine_parts[node_id] = coarse_parts[coarse_of[node_id]];
+        }
+        graph_partition_refine(pt, level, fine_parts, capacity, passes);
+        coarse_parts = fine_parts;
+    }
+
+    return graph_partition_cut(csr, parts);
+}
+
+/*
+ * Number the nodes so that each part gets a contiguous range of ids.
+ * Nodes keep their relative order within each part.
+ *
+ * @parts: Part of each node, in [0, @k).
+ * @num_nodes: Number of nodes.
+ * @k: Number of parts.
+ * @new_id: Array of @num_nodes ints. Receives each node's new id.
+ * @starts: Array of @k + 1 ints. Receives the first new id of each part;
+ *   part p holds new ids starts[p] .. starts[p + 1] - 1.
+ */
+static void graph_partition_relabel(const int *parts, int num_nodes, int k,
+                                    int *new_id, int *starts)
+{
+    int node_id;
+    int part;
+
+    for (part = 0; part <= k; part++)
+    {
+        starts[part] = 0;
+    }
+    for (node_id = 0; node_id < num_nodes; node_id++)
+    {
+        starts[parts[node_id] + 1]++;
+    }
+    for (part = 1; part <= k; part++)
+    {
+        starts[part] += starts[part - 1];
+    }
+
+    /*  starts[p] is the fill cursor of part p, then shifted back  */
+    for (node_id = 0; node_id < num_nodes; node_id++)
+    {
+        new_id[node_id] = starts[parts[node_id]]++;
+    }
+    for (part = k; part > 0; part--)
+    {
+        starts[part] = starts[part - 1];
+    }
+    starts[0] = 0;
+}
+
+/*
+ * Rebuild a snapshot with its nodes renumbered.
+ *
+ * @csr: The snapshot to renumber.
+ * @new_id: New id of each node, a permutation of [0, csr->num_nodes).
+ * @out: Receives the renumbered snapshot.
+ * @offsets: Array of csr->num_nodes + 1 ints for @out's row offsets.
+ * @adj: Array of csr->num_entries ints for @out's neighbor ids.
+ * @weights: Array of csr->num_entries doubles for @out's weights. Ignored
+ *   if @csr is unweighted, and may then be null.
+ */
+static void graph_partition_permute(const CsrGraph *csr, const int *new_id,
+                                    CsrGraph *out, int *offsets, int *adj,
+                                    double *weights)
+{
+    int node_id;
+    int entry;
+    int write;
+
+    out->num_nodes = csr->num_nodes;
+    out->num_entries = csr->num_entries;
+    out->offsets = offsets;
+    out->adj = adj;
+    out->weights = (csr->weights == 0 ? 0 : weights);
+
+    for (node_id = 0; node_id <= csr->num_nodes; node_id++)
+    {
+        offsets[node_id] = 0;
+    }
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        offsets[new_id[node_id] + 1] = csr->offsets[node_id + 1] -
+                                       csr->offsets[node_id];
+    }
+    for (node_id = 1; node_id <= csr->num_nodes; node_id++)
+    {
+        offsets[node_id] += offsets[node_id - 1];
+    }
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        write = offsets[new_id[node_id]];
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            adj[write] = new_id[csr->adj[entry]];
+            if (out->weights != 0)
+            {
+                out->weights[write] = csr->weights[entry];
+            }
+            write++;
+        }
+        graph_csr_sort_row(adj + offsets[new_id[node_id]],
+                           (out->weights == 0 ? 0 :
+                            out->weights + offsets[new_id[node_id]]),
+                           write - offsets[new_id[node_id]]);
+    }
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Get the most a part may weigh: @slack times an even split, rounded up.
+ */
+static int graph_partition_capacity(int total_weight, int k, double slack)
+{
+    double even;
+    int capacity;
+
+    even = slack * (double)total_weight / k;
+    capacity = (int)even;
+    if ((double)capacity < even)
+    {
+        capacity++;
+    }
+    return (capacity < 1 ? 1 : capacity);
+}
+
+/*
+ * Assign every node without a part to one, streaming through them once.
+ *
+ * @parts: Part of each node, -1 for nodes still to be assigned.
+ * @sizes: Number of nodes in each part. Updated as nodes are assigned.
+ * @conn: Array of @k doubles, all 0. Left all 0.
+ * @capacity: The most nodes a part may hold, unless every part is full.
+ * @method: PARTITION_LDG or PARTITION_FENNEL.
+ * @alpha: Scale of Fennel's size cost.
+ * @gamma: Exponent of Fennel's size cost.
+ * @order: Order to stream the nodes in. May be null for id order.
+ */
+static void graph_partition_stream(const CsrGraph *csr, int *parts,
+                                   int *sizes, double *conn, int k,
+                                   int capacity, int method, double alpha,
+                                   double gamma, const int *order)
+{
+    int idx;
+    int node_id;
+    int entry;
+    int part;
+    int best;
+    double score;
+    double best_score;
+
+    for (idx = 0; idx < csr->num_nodes; idx++)
+    {
+        node_id = (order == 0 ? idx : order[idx]);
+        if (parts[node_id] >= 0)
+        {
+            continue;
+        }
+
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (parts[csr->adj[entry]] >= 0)
+            {
+                conn[parts[csr->adj[entry]]] += graph_csr_weight(csr, entry);
+            }
+        }
+
+        best = -1;
+        best_score = 0.0;
+        for (part = 0; part < k; part++)
+        {
+            if (sizes[part] >= capacity)
+            {
+                continue;
+            }
+            if (method == PARTITION_LDG)
+            {
+                score = conn[part] * (1.0 - (double)sizes[part] / capacity);
+            }
+            else
+            {
+                score = conn[part] - alpha * gamma *
+                                     pow((double)sizes[part], gamma - 1.0);
+            }
+            if (best < 0 || score > best_score ||
+                (score == best_score && sizes[part] < sizes[best]))
+            {
+                best = part;
+                best_score = score;
+            }
+        }
+        if (best < 0)
+        {
+            /*  every part is full, overfill the lightest  */
+            best = 0;
+            for (part = 1; part < k; part++)
+            {
+                if (sizes[part] < sizes[best])
+                {
+                    best = part;
+                }
+            }
+        }
+        parts[node_id] = best;
+        sizes[best]++;
+
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            if (parts[csr->adj[entry]] >= 0)
+            {
+                conn[parts[csr->adj[entry]]] = 0.0;
+            }
+        }
+    }
+}
+
+/*
+ * Match the nodes of a level with heavy-edge matching: in a random order,
+ * each unmatched node is merged with the unmatched neighbor it shares the
+ * heaviest edge with, as long as they weigh at most @max_weight together.
+ * Fills @pt->match, @pt->coarse_of[@level] and, for each coarse node, its
+ * first member in @pt->order.
+ *
+ * @level: The level to match.
+ * @seed: Seed of the visiting order.
+ * @max_weight: The most a merged node may weigh.
+ * @return: The number of nodes of the next level, or -1 if the pool is full.
+ */
+static int graph_partition_match(Partition *pt, int level, unsigned long seed,
+                                 int max_weight)
+{
+    const CsrGraph *csr;
+    const int *node_weight;
+    int *coarse_of;
+    int *order;
+    int *match;
+    int idx;
+    int swap;
+    int tmp;
+    int node_id;
+    int other;
+    int best;
+    int entry;
+    int count;
+    double best_weight;
+    GraphRng rng;
+
+    csr = &pt->levels[level];
+    node_weight = pt->node_weight[level];
+    if (pt->pool_used + csr->num_nodes > pt->pool_size)
+    {
+        return -1;
+    }
+    coarse_of = pt->pool + pt->pool_used;
+    pt->pool_used += csr->num_nodes;
+    pt->coarse_of[level] = coarse_of;
+    order = pt->order;
+    match = pt->match;
+
+    /*  shuffle the visiting order  */
+    graph_rng_seed(&rng, seed, (unsigned long)level);
+    for (idx = 0; idx < csr->num_nodes; idx++)
+    {
+        order[idx] = idx;
+        match[idx] = -1;
+    }
+    for (idx = csr->num_nodes - 1; idx > 0; idx--)
+    {
+        swap = graph_rng_below(&rng, idx + 1);
+        tmp = order[idx];
+        order[idx] = order[swap];
+        order[swap] = tmp;
+    }
+
+    /*  the coarse nodes' first members overwrite the visited order  */
+    count = 0;
+    for (idx = 0; idx < csr->num_nodes; idx++)
+    {
+        node_id = order[idx];
+        if (match[node_id] >= 0)
+        {
+            continue;
+        }
+
+        best = node_id;
+        best_weight = 0.0;
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            other = csr->adj[entry];
+            if (other == node_id || match[other] >= 0 ||
+                node_weight[node_id] + node_weight[other] > max_weight)
+            {
+                continue;
+            }
+            if (best == node_id || graph_csr_weight(csr, entry) > best_weight)
+            {
+                best = other;
+                best_weight = graph_csr_weight(csr, entry);
+            }
+        }
+
+        match[node_id] = best;
+        match[best] = node_id;
+        coarse_of[node_id] = count;
+        coarse_of[best] = count;
+        order[count++] = node_id;
+    }
+
+    return count;
+}
+
+/*
+ * Build the next level from a matching of a level. Each coarse node weighs
+ * what its members do, and the weight between two coarse nodes is the summed
+ * weight of the entries between their members. Entries within a coarse node
+ * are dropped.
+ *
+ * @level: The matched level.
+ * @count: Number of nodes of the next level.
+ * @return: 1 if the level was built, 0 if the pools are too small for it.
+ */
+static int graph_partition_coarsen(Partition *pt, int level, int count)
+{
+    const CsrGraph *fine;
+    const int *coarse_of;
+    CsrGraph *coarse;
+    int *node_weight;
+    int coarse_id;
+    int member;
+    int node_id;
+    int entry;
+    int target;
+    int write;
+    double weight;
+
+    fine = &pt->levels[level];
+    coarse_of = pt->coarse_of[level];
+    if (pt->pool_used + 2 * (long)count + 1 + fine->num_entries >
+            pt->pool_size ||
+        pt->weight_pool_used + fine->num_entries > pt->weight_pool_size)
+    {
+        return 0;
+    }
+
+    coarse = &pt->levels[level + 1];
+    node_weight = pt->pool + pt->pool_used;
+    coarse->offsets = node_weight + count;
+    coarse->adj = coarse->offsets + count + 1;
+    coarse->weights = pt->weight_pool + pt->weight_pool_used;
+    coarse->num_nodes = count;
+    pt->node_weight[level + 1] = node_weight;
+
+    for (coarse_id = 0; coarse_id < count; coarse_id++)
+    {
+        pt->mark[coarse_id] = -1;
+    }
+    write = 0;
+    for (coarse_id = 0; coarse_id < count; coarse_id++)
+    {
+        coarse->offsets[coarse_id] = write;
+        node_id = pt->order[coarse_id];
+        node_weight[coarse_id] = pt->node_weight[level][node_id];
+        if (pt->match[node_id] != node_id)
+        {
+            node_weight[coarse_id] +=
+                pt->node_weight[level][pt->match[node_id]];
+        }
+
+        /*  merge the rows of both members  */
+        for (member = 0; member < 2; member++)
+        {
+            if (member == 1)
+            {
+                if (pt->match[node_id] == node_id)
+                {
+                    break;
+                }
+                node_id = pt->match[node_id];
+            }
+            for (entry = fine->offsets[node_id];
+                 entry < fine->offsets[node_id + 1]; entry++)
+            {
+                target = coarse_of[fine->adj[entry]];
+                if (target == coarse_id)
+                {
+                    continue;
+                }
+                weight = graph_csr_weight(fine, entry);
+                if (pt->mark[target] == coarse_id)
+                {
+                    coarse->weights[pt->pos[target]] += weight;
+                }
+                else
+                {
+                    pt->mark[target] = coarse_id;
+                    pt->pos[target] = write;
+                    coarse->adj[write] = target;
+                    coarse->weights[write] = weight;
+                    write++;
+                }
+            }
+        }
+        graph_csr_sort_row(coarse->adj + coarse->offsets[coarse_id],
+                           coarse->weights + coarse->offsets[coarse_id],
+                           write - coarse->offsets[coarse_id]);
+    }
+    coarse->offsets[count] = write;
+    coarse->num_entries = write;
+
+    pt->pool_used += 2 * (long)count + 1 + write;
+    pt->weight_pool_used += write;
+    return 1;
+}
+
+/*
+ * Partition a level by growing each part breadth-first from a random seed
+ * node until it holds its share of the weight left. Regions grown this way
+ * are compact, which gives refinement a good start. When a region runs out of
+ * neighbors, the next unassigned node seeds it again.
+ *
+ * @level: The level to partition, usually the coarsest.
+ * @parts: Receives the part of each node of the level.
+ * @rng: Source of the seed nodes.
+ */
+static void graph_partition_grow(Partition *pt, int level, int *parts,
+                                 GraphRng *rng)
+{
+    const CsrGraph *csr;
+    const int *node_weight;
+    int *queue;
+    int node_id;
+    int other;
+    int entry;
+    int part;
+    int head;
+    int tail;
+    int next_seed;
+    int seen;
+    long left;
+    long target;
+    long weight;
+
+    csr = &pt->levels[level];
+    node_weight = pt->node_weight[level];
+    queue = pt->match;
+    left = 0;
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        parts[node_id] = -1;
+        left += node_weight[node_id];
+    }
+
+    for (part = 0; part < pt->k && csr->num_nodes > 0; part++)
+    {
+        target = (left + (pt->k - part) - 1) / (pt->k - part);
+        weight = 0;
+        head = 0;
+        tail = 0;
+        next_seed = graph_rng_below(rng, csr->num_nodes);
+        while (weight < target)
+        {
+            if (head == tail)
+            {
+                /*  the next unassigned node, wrapping around  */
+                for (seen = 0; seen < csr->num_nodes && parts[next_seed] >= 0;
+                     seen++)
+                {
+                    next_seed = (next_seed + 1 == csr->num_nodes ?
+                                 0 : next_seed + 1);
+                }
+                if (seen == csr->num_nodes)
+                {
+                    break;
+                }
+                parts[next_seed] = part;
+                weight += node_weight[next_seed];
+                queue[tail++] = next_seed;
+                continue;
+            }
+
+            node_id = queue[head++];
+            for (entry = csr->offsets[node_id];
+                 entry < csr->offsets[node_id + 1] && weight < target; entry++)
+            {
+                other = csr->adj[entry];
+                if (parts[other] < 0)
+                {
+                    parts[other] = part;
+                    weight += node_weight[other];
+                    queue[tail++] = other;
+                }
+            }
+        }
+        left -= weight;
+    }
+}
+
+/*
+ * Improve the partition of a level by moving nodes between parts.
+ * Each pass visits every node and moves it to the part it has the most
+ * weight to, if that is at least its own part and the part has room. Moves
+ * that gain nothing let boundaries drift until a cut-reducing move shows up,
+ * and a node of an overfull part moves to the best part with room no matter
+ * the cost.
+ *
+ * @level: The level to refine.
+ * @parts: Part of each node of the level.
+ * @capacity: The most a part may weigh.
+ * @passes: The most passes to make. Stops early once a pass moves nothing.
+ */
+static void graph_partition_refine(Partition *pt, int level, int *parts,
+                                   int capacity, int passes)
+{
+    const CsrGraph *csr;
+    const int *node_weight;
+    int pass;
+    int moved;
+    int node_id;
+    int entry;
+    int own;
+    int part;
+    int best;
+    int idx;
+    int num_touched;
+    int weight;
+    int overfull;
+    double gain;
+    double best_gain;
+
+    csr = &pt->levels[level];
+    node_weight = pt->node_weight[level];
+    for (part = 0; part < pt->k; part++)
+    {
+        pt->sizes[part] = 0;
+    }
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        pt->sizes[parts[node_id]] += node_weight[node_id];
+    }
+
+    for (pass = 0; pass < passes; pass++)
+    {
+        moved = 0;
+        for (node_id = 0; node_id < csr->num_nodes; node_id++)
+        {
+            own = parts[node_id];
+            weight = node_weight[node_id];
+            overfull = (pt->sizes[own] > capacity);
+
+            /*  weight to each part the node is connected to  */
+            num_touched = 0;
+            for (entry = csr->offsets[node_id];
+                 entry < csr->offsets[node_id + 1]; entry++)
+            {
+                part = parts[csr->adj[entry]];
+                if (csr->adj[entry] == node_id ||
+                    graph_csr_weight(csr, entry) <= 0.0)
+                {
+                    continue;
+                }
+                if (pt->conn[part] == 0.0)
+                {
+                    pt->touched[num_touched++] = part;
+                }
+                pt->conn[part] += graph_csr_weight(csr, entry);
+            }
+
+            best = -1;
+            best_gain = 0.0;
+            for (idx = 0; idx < num_touched; idx++)
+            {
+                part = pt->touched[idx];
+                if (part == own || pt->sizes[part] + weight > capacity)
+                {
+                    continue;
+                }
+                gain = pt->conn[part] - pt->conn[own];
+                if (!overfull && gain < 0.0)
+                {
+                    continue;
+                }
+                if (best < 0 || gain > best_gain ||
+                    (gain == best_gain && pt->sizes[part] < pt->sizes[best]))
+                {
+                    best = part;
+                    best_gain = gain;
+                }
+            }
+            if (best < 0 && overfull)
+            {
+                /*  no neighbor part has room, take the lightest part  */
+                for (part = 0; part < pt->k; part++)
+                {
+                    if (part != own &&
+                        pt->sizes[part] + weight <= capacity &&
+                        (best < 0 || pt->sizes[part] < pt->sizes[best]))
+                    {
+                        best = part;
+                    }
+                }
+            }
+
+            for (idx = 0; idx < num_touched; idx++)
+            {
+                pt->conn[pt->touched[idx]] = 0.0;
+            }
+            pt->conn[own] = 0.0;
+
+            if (best >= 0)
+            {
+                parts[node_id] = best;
+                pt->sizes[own] -= weight;
+                pt->sizes[best] += weight;
+                moved++;
+            }
+        }
+        if (moved == 0)
+        {
+            break;
+        }
+    }
+}
+
+
+#endif
@@ -0,0 +1,290 @@
+/*
+ * Unit tests for the graph partitioning header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_partition.h"
+#include "graph_generators.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+#define MAX_ENTRIES 64
+#define SIDE 32
+#define GRID_NODES (SIDE * SIDE)
+#define GRID_ENTRIES (4 * SIDE * (SIDE - 1))
+#define NUM_PARTS 4
+
+static void init_two_cliques(Graph *graph, Node *node_arr, CsrGraph *csr,
+                             int *offsets, int *adj);
+static void init_grid(Graph *graph, Node *node_arr, CsrGraph *csr,
+                      int *offsets, int *adj);
+static void assert_balanced(const int *parts, int num_nodes, int k,
+                            int capacity);
+
+
+void test_ldg_two_cliques()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int parts[INIT_SIZE];
+    int sizes[2];
+    double conn[2];
+    int idx;
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    graph_partition_ldg(&csr, parts, sizes, conn, 2, 1.0, 0);
+
+    TEST_ASSERT_EQUAL(5, sizes[0]);
+    TEST_ASSERT_EQUAL(5, sizes[1]);
+    for (idx = 1; idx < 5; idx++)
+    {
+        TEST_ASSERT_EQUAL(parts[0], parts[idx]);
+        TEST_ASSERT_EQUAL(parts[5], parts[5 + idx]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0, graph_partition_cut(&csr, parts));
+}
+
+void test_streaming_beats_hashing()
+{
+    Graph graph;
+    Node *node_arr;
+    CsrGraph csr;
+    int *offsets;
+    int *adj;
+    int *parts;
+    int sizes[NUM_PARTS];
+    double conn[NUM_PARTS];
+    double hashed;
+    int idx;
+
+    node_arr = malloc(GRID_NODES * sizeof(Node));
+    offsets = malloc((GRID_NODES + 1) * sizeof(int));
+    adj = malloc(GRID_ENTRIES * sizeof(int));
+    parts = malloc(GRID_NODES * sizeof(int));
+    init_grid(&graph, node_arr, &csr, offsets, adj);
+
+    for (idx = 0; idx < GRID_NODES; idx++)
+    {
+        parts[idx] = idx % NUM_PARTS;
+    }
+    hashed = graph_partition_cut(&csr, parts);
+
+    graph_partition_ldg(&csr, parts, sizes, conn, NUM_PARTS, 1.05, 0);
+    assert_balanced(parts, GRID_NODES, NUM_PARTS,
+                    graph_partition_capacity(GRID_NODES, NUM_PARTS, 1.05));
+    TEST_ASSERT_TRUE(graph_partition_cut(&csr, parts) < hashed / 4);
+
+    graph_partition_fennel(&csr, parts, sizes, conn, NUM_PARTS, 1.05, 1.5, 0);
+    assert_balanced(parts, GRID_NODES, NUM_PARTS,
+                    graph_partition_capacity(GRID_NODES, NUM_PARTS, 1.05));
+    TEST_ASSERT_TRUE(graph_partition_cut(&csr, parts) < hashed / 3);
+}
+
+void test_multilevel_grid()
+{
+    Graph graph;
+    Node *node_arr;
+    CsrGraph csr;
+    Partition pt;
+    int *offsets;
+    int *adj;
+    int *parts;
+    int *int_buf;
+    double *double_buf;
+    double cut;
+
+    node_arr = malloc(GRID_NODES * sizeof(Node));
+    offsets = malloc((GRID_NODES + 1) * sizeof(int));
+    adj = malloc(GRID_ENTRIES * sizeof(int));
+    parts = malloc(GRID_NODES * sizeof(int));
+    int_buf = malloc(PARTITION_INT_WORDS(GRID_NODES, GRID_ENTRIES, NUM_PARTS) *
+                     sizeof(int));
+    double_buf = malloc(PARTITION_DOUBLE_WORDS(GRID_ENTRIES, NUM_PARTS) *
+                        sizeof(double));
+    init_grid(&graph, node_arr, &csr, offsets, adj);
+
+    graph_partition_init(&pt, NUM_PARTS, 1.03, GRID_NODES, int_buf,
+                         PARTITION_INT_WORDS(GRID_NODES, GRID_ENTRIES,
+                                             NUM_PARTS),
+                         double_buf,
+                         PARTITION_DOUBLE_WORDS(GRID_ENTRIES, NUM_PARTS));
+    cut = graph_partition_multilevel(&pt, &csr, parts, 7, 8);
+
+    /* Four strips cut 3 * SIDE edges, four quadrants 2 * SIDE. */
+    TEST_ASSERT_TRUE(pt.num_levels > 2);
+    assert_balanced(parts, GRID_NODES, NUM_PARTS,
+                    graph_partition_capacity(GRID_NODES, NUM_PARTS, 1.03));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, cut, graph_partition_cut(&csr, parts));
+    TEST_ASSERT_TRUE(cut < 3 * SIDE);
+}
+
+void test_multilevel_small_workspace()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    Partition pt;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int parts[INIT_SIZE];
+    int int_buf[2 * 2 + 5 * INIT_SIZE];
+    double double_buf[2];
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    graph_partition_init(&pt, 2, 1.0, INIT_SIZE, int_buf,
+                         2 * 2 + 5 * INIT_SIZE, double_buf, 2);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0,
+                             graph_partition_multilevel(&pt, &csr, parts, 1,
+                                                        4));
+    TEST_ASSERT_EQUAL(1, pt.num_levels);
+    assert_balanced(parts, INIT_SIZE, 2, 5);
+}
+
+void test_relabel_and_permute()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    CsrGraph relabeled;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int new_offsets[INIT_SIZE + 1];
+    int new_adj[MAX_ENTRIES];
+    int parts[INIT_SIZE] = {1, 0, 1, 0, 1, 0, 1, 0, 1, 0};
+    int new_parts[INIT_SIZE];
+    int new_id[INIT_SIZE];
+    int starts[3];
+    int node_id;
+    int entry;
+
+    init_two_cliques(&graph, node_arr, &csr, offsets, adj);
+    graph_partition_relabel(parts, INIT_SIZE, 2, new_id, starts);
+
+    /* Part 0 gets the odd nodes in order, then part 1 the even ones. */
+    TEST_ASSERT_EQUAL(0, starts[0]);
+    TEST_ASSERT_EQUAL(5, starts[1]);
+    TEST_ASSERT_EQUAL(10, starts[2]);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_EQUAL((node_id % 2 == 1 ? node_id / 2 : 5 + node_id / 2),
+                          new_id[node_id]);
+        new_parts[new_id[node_id]] = parts[node_id];
+    }
+
+    graph_partition_permute(&csr, new_id, &relabeled, new_offsets, new_adj, 0);
+    TEST_ASSERT_EQUAL(csr.num_entries, relabeled.num_entries);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        for (entry = csr.offsets[node_id];
+             entry < csr.offsets[node_id + 1]; entry++)
+        {
+            TEST_ASSERT_TRUE(graph_csr_find(&relabeled, new_id[node_id],
+                                            new_id[csr.adj[entry]]) >= 0);
+        }
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, graph_partition_cut(&csr, parts),
+                             graph_partition_cut(&relabeled, new_parts));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  stream two cliques into two parts, verify the cut is the bridge  */
+    RUN_TEST(test_ldg_two_cliques);
+    /*  stream a grid with LDG and Fennel, verify balance and a small cut  */
+    RUN_TEST(test_streaming_beats_hashing);
+    /*  partition a grid through several levels, verify balance and cut  */
+    RUN_TEST(test_multilevel_grid);
+    /*  give the multilevel partitioner no room to coarsen  */
+    RUN_TEST(test_multilevel_small_workspace);
+    /*  make parts contiguous, verify the renumbered snapshot  */
+    RUN_TEST(test_relabel_and_permute);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build two 5-cliques, {0..4} and {5..9}, joined by the edge 4-5, and take an
+ * undirected snapshot of them.
+ */
+static void init_two_cliques(Graph *graph, Node *node_arr, CsrGraph *csr,
+                             int *offsets, int *adj)
+{
+    int idx;
+    int from;
+    int to;
+
+    graph_init(graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (from = 0; from < 5; from++)
+    {
+        for (to = from + 1; to < 5; to++)
+        {
+            graph_add_edge(graph, from, to);
+            graph_add_edge(graph, from + 5, to + 5);
+        }
+    }
+    graph_add_edge(graph, 4, 5);
+
+    graph_csr_build(graph, csr, offsets, adj, 1);
+}
+
+/*
+ * Build a SIDE x SIDE grid and take an undirected snapshot of it.
+ */
+static void init_grid(Graph *graph, Node *node_arr, CsrGraph *csr,
+                      int *offsets, int *adj)
+{
+    int *from;
+    int *to;
+    long count;
+
+    count = graph_gen_grid_edges(SIDE, SIDE);
+    from = malloc(count * sizeof(int));
+    to = malloc(count * sizeof(int));
+    graph_gen_grid(SIDE, SIDE, from, to, 0, count);
+
+    graph_init(graph, node_arr, GRID_NODES);
+    graph_gen_fill(graph, from, to, count, malloc(GRID_NODES * sizeof(Bucket)),
+                   GRID_NODES);
+    graph_csr_build(graph, csr, offsets, adj, 1);
+    free(from);
+    free(to);
+}
+
+/*
+ * Check that every node has a part and no part is over capacity.
+ */
+static void assert_balanced(const int *parts, int num_nodes, int k,
+                            int capacity)
+{
+    int sizes[NUM_PARTS];
+    int idx;
+
+    for (idx = 0; idx < k; idx++)
+    {
+        sizes[idx] = 0;
+    }
+    for (idx = 0; idx < num_nodes; idx++)
+    {
+        TEST_ASSERT_TRUE(parts[idx] >= 0 && parts[idx] < k);
+        sizes[parts[idx]]++;
+    }
+    for (idx = 0; idx < k; idx++)
+    {
+        TEST_ASSERT_TRUE(sizes[idx] <= capacity);
+    }
+}
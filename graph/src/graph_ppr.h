@@ -0,0 +1,376 @@
+/*
+ * Approximate personalized PageRank by local forward push.
+ * See Andersen, Chung and Lang, "Local Graph Partitioning using PageRank
+ * Vectors" (2006) for the theory.
+ *
+ * Personalized PageRank (PPR) from a seed is the stationary distribution of a
+ * walk that, at every step, jumps back to the seed with probability alpha and
+ * otherwise follows a random edge out. Power iteration computes it for every
+ * node at the cost of many sweeps over the whole graph. Forward push instead
+ * keeps an estimate p and a residual r per node, starts with all the mass in
+ * r[seed] and repeatedly "pushes" a node: alpha of its residual becomes
+ * estimate and the rest is spread over its out-neighbors. Only nodes whose
+ * residual reaches epsilon times their out-degree are pushed, so the work is
+ * bounded by 1 / (alpha * epsilon) no matter how big the graph is, and every
+ * estimate is within epsilon * degree of the true value.
+ *
+ * Mass that reaches a node without edges out returns to the seed.
+ *
+ * === How to Use ===
+ * This header does no memory management. A 'PprWorkspace' holds the dense
+ * per-node arrays a push needs; allocate them once for the graph's size,
+ * initialize the workspace with 'graph_ppr_init' and reuse it for every query.
+ * Queries only touch the nodes they reach, and so does resetting the
+ * workspace afterwards, so a query costs the same on a graph of a thousand
+ * nodes as on one of a billion.
+ *
+ * Run a query with 'graph_ppr' and read the non-zero estimates out as a sparse
+ * list of (node id, score) pairs with 'graph_ppr_results'. 'graph_ppr_batch'
+ * does both for a list of seeds.
+ *
+ * The workspace remembers out-degrees. Call 'graph_ppr_refresh' after edges
+ * are added or removed.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_PPR_H
+#define GRAPH_PPR_H
+
+#include "graph.h"
+
+typedef struct PprWorkspaceTag PprWorkspace;
+
+/*  flags kept per node in a workspace  */
+#define PPR_QUEUED 1
+#define PPR_TOUCHED 2
+
+static void graph_ppr_touch(PprWorkspace *ws, int node_id);
+static void graph_ppr_enqueue(PprWorkspace *ws, int node_id);
+
+/*
+ * Reusable state for PPR queries on one graph.
+ * CAUTION: every array must have the graph's size.
+ *
+ * @size: Number of nodes of the graph.
+ * @estimate: PPR estimate of each node.
+ * @residual: Mass not yet pushed from each node.
+ * @degree: Out-degree of each node.
+ * @queue: Circular queue of nodes to push.
+ * @flags: PPR_QUEUED and PPR_TOUCHED flags of each node.
+ * @touched: Nodes with a non-zero estimate or residual.
+ * @num_touched: Number of entries of @touched.
+ * @queue_head: Position of the next node to push.
+ * @queue_count: Number of nodes in the queue.
+ * @pushes: Number of pushes made by the last query.
+ */
+struct PprWorkspaceTag
+{
+    int size;
+    double *estimate;
+    double *residual;
+    int *degree;
+    int *queue;
+    char *flags;
+    int *touched;
+    int num_touched;
+    int queue_head;
+    int queue_count;
+    long pushes;
+};
+
+/*
+ * Copy the out-degree of every node of a graph from its nodes' counts.
+ * Must be called after the graph's edges change.
+ */
+static void graph_ppr_refresh(PprWorkspace *ws, Graph *graph)
+{
+    int node_id;
+
+    for (node_id = 0; node_id < ws->size; node_id++)
+    {
+        ws->degree[node_id] = graph->nodes[node_id].degree;
+    }
+}
+
+/*
+ * Initialize a workspace for a graph.
+ *
+ * @estimate: Array of graph->size doubles.
+ * @residual: Array of graph->size doubles.
+ * @degree: Array of graph->size ints.
+ * @queue: Array of graph->size ints.
+ * @flags: Array of graph->size chars.
+ * @touched: Array of graph->size ints.
+ */
+static void graph_ppr_init(PprWorkspace *ws, Graph *graph, double *estimate,
+                           double *residual, int *degree, int *queue,
+                           char *flags, int *touched)
+{
+    int node_id;
+
+    ws->size = graph->size;
+    ws->estimate = estimate;
+    ws->residual = residual;
+    ws->degree = degree;
+    ws->queue = queue;
+    ws->flags = flags;
+    ws->touched = touched;
+    ws->num_touched = 0;
+    ws->queue_head = 0;
+    ws->queue_count = 0;
+    ws->pushes = 0;
+
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        estimate[node_id] = 0.0;
+        residual[node_id] = 0.0;
+        flags[node_id] = 0;
+    }
+    graph_ppr_refresh(ws, graph);
+}
+
+/*
+ * Reset the estimates and residuals left by the last query.
+ * O(number of nodes the query touched).
+ */
+static void graph_ppr_clear(PprWorkspace *ws)
+{
+    int idx;
+    int node_id;
+
+    for (idx = 0; idx < ws->num_touched; idx++)
+    {
+        node_id = ws->touched[idx];
+        ws->estimate[node_id] = 0.0;
+        ws->residual[node_id] = 0.0;
+        ws->flags[node_id] = 0;
+    }
+    ws->num_touched = 0;
+    ws->queue_head = 0;
+    ws->queue_count = 0;
+}
+
+/*
+ * Approximate the personalized PageRank of a seed node by forward push.
+ * Clears the workspace first.
+ *
+ * @ws: Workspace initialized for @graph.
+ * @seed_id: The node to personalize on. Assumed to be valid.
+ * @alpha: Probability of jumping back to the seed, in (0, 1). Typically 0.15.
+ * @epsilon: Push threshold. A node is pushed while its residual is at least
+ *   @epsilon times its out-degree. Smaller is more accurate and slower.
+ * @return: The number of nodes with a non-zero estimate or residual.
+ */
+static int graph_ppr(Graph *graph, PprWorkspace *ws, int seed_id,
+                     double alpha, double epsilon)
+{
+    int node_id;
+    int to_id;
+    int degree;
+    double mass;
+    double share;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    graph_ppr_clear(ws);
+    ws->pushes = 0;
+
+    graph_ppr_touch(ws, seed_id);
+    ws->residual[seed_id] = 1.0;
+    graph_ppr_enqueue(ws, seed_id);
+
+    while (ws->queue_count > 0)
+    {
+        node_id = ws->queue[ws->queue_head];
+        ws->queue_head = (ws->queue_head + 1 == ws->size ?
+                          0 : ws->queue_head + 1);
+        ws->queue_count--;
+        ws->flags[node_id] &= ~PPR_QUEUED;
+
+        degree = ws->degree[node_id];
+        mass = ws->residual[node_id];
+        if (mass < epsilon * (degree > 0 ? degree : 1))
+        {
+            continue;
+        }
+        ws->pushes++;
+
+        ws->estimate[node_id] += alpha * mass;
+        ws->residual[node_id] = 0.0;
+
+        if (degree == 0)
+        {
+            /*  dead end, the walk can only restart at the seed  */
+            ws->residual[seed_id] += (1.0 - alpha) * mass;
+            if (ws->residual[seed_id] >=
+                epsilon * (ws->degree[seed_id] > 0 ? ws->degree[seed_id] : 1))
+            {
+                graph_ppr_enqueue(ws, seed_id);
+            }
+            continue;
+        }
+
+        /*  spread the rest evenly over the edges out  */
+        share = (1.0 - alpha) * mass / degree;
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            to_id = adj_node->id;
+            graph_ppr_touch(ws, to_id);
+            ws->residual[to_id] += share;
+            if (ws->residual[to_id] >= epsilon *
+                (ws->degree[to_id] > 0 ? ws->degree[to_id] : 1))
+            {
+                graph_ppr_enqueue(ws, to_id);
+            }
+        }
+    }
+
+    return ws->num_touched;
+}
+
+/*
+ * Count the non-zero estimates of the last query.
+ */
+static int graph_ppr_num_results(const PprWorkspace *ws)
+{
+    int idx;
+    int count;
+
+    count = 0;
+    for (idx = 0; idx < ws->num_touched; idx++)
+    {
+        if (ws->estimate[ws->touched[idx]] > 0.0)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Read the non-zero estimates of the last query as a sparse list.
+ * Entries are listed in the order the query first reached their nodes.
+ *
+ * @ids: Receives node ids.
+ * @scores: Receives the estimates, parallel to @ids.
+ * @capacity: Size of @ids and @scores.
+ * @return: The number of entries written. Entries past @capacity are
+ *   dropped; see 'graph_ppr_num_results'.
+ */
+static int graph_ppr_results(const PprWorkspace *ws, int *ids, double *scores,
+                             int capacity)
+{
+    int idx;
+    int count;
+    int node_id;
+
+    count = 0;
+    for (idx = 0; idx < ws->num_touched && count < capacity; idx++)
+    {
+        node_id = ws->touched[idx];
+        if (ws->estimate[node_id] > 0.0)
+        {
+            ids[count] = node_id;
+            scores[count] = ws->estimate[node_id];
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Run PPR queries for several seeds and collect their sparse results.
+ * The results of seed i are ids[offsets[i]] .. ids[offsets[i + 1] - 1] and the
+ * matching entries of @scores.
+ *
+ * @ws: Workspace initialized for @graph.
+ * @seeds: Seed node of each query.
+ * @num_seeds: Number of queries.
+ * @alpha: Probability of jumping back to the seed.
+ * @epsilon: Push threshold.
+ * @offsets: Array of @num_seeds + 1 ints. Receives the result ranges.
+ * @ids: Receives the node ids of every result.
+ * @scores: Receives the estimates of every result.
+ * @capacity: Size of @ids and @scores.
+ * @return: 0 if every result fit, 1 if @capacity ran out. Results of seeds
+ *   that did not fit are empty ranges.
+ */
+static int graph_ppr_batch(Graph *graph, PprWorkspace *ws, const int *seeds,
+                           int num_seeds, double alpha, double epsilon,
+                           int *offsets, int *ids, double *scores,
+                           int capacity)
+{
+    int seed;
+    int used;
+    int count;
+    int full;
+
+    used = 0;
+    full = 0;
+    offsets[0] = 0;
+    for (seed = 0; seed < num_seeds; seed++)
+    {
+        if (!full)
+        {
+            graph_ppr(graph, ws, seeds[seed], alpha, epsilon);
+            count = graph_ppr_num_results(ws);
+            if (count > capacity - used)
+            {
+                full = 1;
+            }
+            else
+            {
+                used += graph_ppr_results(ws, ids + used, scores + used,
+                                          count);
+            }
+        }
+        offsets[seed + 1] = used;
+    }
+    graph_ppr_clear(ws);
+
+    return full;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Record that a query reached a node, so it gets cleared afterwards.
+ */
+static void graph_ppr_touch(PprWorkspace *ws, int node_id)
+{
+    if (!(ws->flags[node_id] & PPR_TOUCHED))
+    {
+        ws->flags[node_id] |= PPR_TOUCHED;
+        ws->touched[ws->num_touched++] = node_id;
+    }
+}
+
+/*
+ * Add a node to the push queue unless it is already in it.
+ */
+static void graph_ppr_enqueue(PprWorkspace *ws, int node_id)
+{
+    int tail;
+
+    if (ws->flags[node_id] & PPR_QUEUED)
+    {
+        return;
+    }
+    ws->flags[node_id] |= PPR_QUEUED;
+    tail = ws->queue_head + ws->queue_count;
+    if (tail >= ws->size)
+    {
+        tail -= ws->size;
+    }
+    ws->queue[tail] = node_id;
+    ws->queue_count++;
+}
+
+
+#endif
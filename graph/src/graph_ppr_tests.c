@@ -0,0 +1,211 @@
+/*
+ * Unit tests for the personalized PageRank header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_ppr.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+#define ALPHA 0.15
+#define EPSILON 1e-7
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static PprWorkspace ws;
+static double estimate[INIT_SIZE], residual[INIT_SIZE];
+static int degree[INIT_SIZE], queue[INIT_SIZE], touched[INIT_SIZE];
+static char flags[INIT_SIZE];
+
+static double pow_of(double base, int exp);
+static void init_ring(void);
+
+
+void test_ring_matches_closed_form()
+{
+    int node_id;
+    double expected;
+    double decay;
+
+    init_ring();
+    graph_ppr(&graph, &ws, 0, ALPHA, EPSILON);
+
+    /* On a ring, PPR decays geometrically with the distance from the seed. */
+    decay = 1.0;
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        expected = ALPHA * decay / (1.0 - pow_of(1.0 - ALPHA, INIT_SIZE));
+        TEST_ASSERT_FLOAT_WITHIN(1e-5, expected, ws.estimate[node_id]);
+        decay *= 1.0 - ALPHA;
+    }
+}
+
+void test_mass_is_conserved()
+{
+    int node_id;
+    double total;
+
+    init_ring();
+    graph_add_edge(&graph, 3, 7);
+    graph_add_edge(&graph, 5, 1);
+    graph_ppr_refresh(&ws, &graph);
+    graph_ppr(&graph, &ws, 2, ALPHA, 1e-3);
+
+    total = 0.0;
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        total += ws.estimate[node_id] + ws.residual[node_id];
+        /* Every residual left behind is below the push threshold. */
+        TEST_ASSERT_TRUE(ws.residual[node_id] < 1e-3 * degree[node_id]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0, total);
+}
+
+void test_dead_end_returns_to_seed()
+{
+    int ids[INIT_SIZE];
+    double scores[INIT_SIZE];
+
+    /* 0 -> 1 and nothing else, the walk bounces between them. */
+    graph_init(&graph, node_arr, INIT_SIZE);
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_edge(&graph, 0, 1);
+    graph_ppr_init(&ws, &graph, estimate, residual, degree, queue, flags,
+                   touched);
+
+    graph_ppr(&graph, &ws, 0, 0.5, EPSILON);
+
+    /* p0 = 0.5 + 0.25 p0 ... solves to p0 = 2/3, p1 = 1/3. */
+    TEST_ASSERT_EQUAL(2, graph_ppr_results(&ws, ids, scores, INIT_SIZE));
+    TEST_ASSERT_EQUAL(0, ids[0]);
+    TEST_ASSERT_EQUAL(1, ids[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 2.0 / 3.0, scores[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0 / 3.0, scores[1]);
+}
+
+void test_workspace_reuse()
+{
+    double first[INIT_SIZE];
+    int node_id;
+
+    init_ring();
+    graph_ppr(&graph, &ws, 4, ALPHA, 1e-4);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        first[node_id] = ws.estimate[node_id];
+    }
+
+    /* A query from elsewhere, then the first one again. */
+    graph_ppr(&graph, &ws, 8, ALPHA, 1e-4);
+    graph_ppr(&graph, &ws, 4, ALPHA, 1e-4);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(first[node_id], ws.estimate[node_id]);
+    }
+
+    graph_ppr_clear(&ws);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(0.0, ws.estimate[node_id]);
+        TEST_ASSERT_EQUAL(0, flags[node_id]);
+    }
+}
+
+void test_local_query_stays_local()
+{
+    int touched_count;
+
+    /* A coarse threshold stops the push long before it wraps the ring. */
+    init_ring();
+    touched_count = graph_ppr(&graph, &ws, 0, 0.5, 0.05);
+
+    TEST_ASSERT_TRUE(touched_count < INIT_SIZE);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, ws.estimate[INIT_SIZE - 1]);
+}
+
+void test_batch()
+{
+    int seeds[3] = { 0, 5, 9 };
+    int offsets[4];
+    int ids[3 * INIT_SIZE];
+    double scores[3 * INIT_SIZE];
+
+    init_ring();
+    TEST_ASSERT_EQUAL(0, graph_ppr_batch(&graph, &ws, seeds, 3, ALPHA, 1e-4,
+                                         offsets, ids, scores,
+                                         3 * INIT_SIZE));
+    TEST_ASSERT_EQUAL(0, offsets[0]);
+    TEST_ASSERT_EQUAL(INIT_SIZE, offsets[1]);
+    TEST_ASSERT_EQUAL(2 * INIT_SIZE, offsets[2]);
+    TEST_ASSERT_EQUAL(3 * INIT_SIZE, offsets[3]);
+    TEST_ASSERT_EQUAL(5, ids[offsets[1]]);
+    TEST_ASSERT_EQUAL(9, ids[offsets[2]]);
+
+    /* Room for one seed only, the rest come back empty. */
+    TEST_ASSERT_EQUAL(1, graph_ppr_batch(&graph, &ws, seeds, 3, ALPHA, 1e-4,
+                                         offsets, ids, scores,
+                                         INIT_SIZE + 3));
+    TEST_ASSERT_EQUAL(INIT_SIZE, offsets[1]);
+    TEST_ASSERT_EQUAL(INIT_SIZE, offsets[2]);
+    TEST_ASSERT_EQUAL(INIT_SIZE, offsets[3]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  query a directed ring, verify the closed-form answer  */
+    RUN_TEST(test_ring_matches_closed_form);
+    /*  verify estimates plus residuals always sum to 1  */
+    RUN_TEST(test_mass_is_conserved);
+    /*  query a graph with a dead end, verify mass returns to the seed  */
+    RUN_TEST(test_dead_end_returns_to_seed);
+    /*  run several queries in one workspace, verify nothing leaks  */
+    RUN_TEST(test_workspace_reuse);
+    /*  verify a coarse query only touches nodes near the seed  */
+    RUN_TEST(test_local_query_stays_local);
+    /*  run a batch of queries, verify result ranges and overflow  */
+    RUN_TEST(test_batch);
+
+
+    UNITY_END();
+}
+
+/*
+ * Raise a number to a non-negative integer power.
+ */
+static double pow_of(double base, int exp)
+{
+    double result;
+
+    result = 1.0;
+    while (exp-- > 0)
+    {
+        result *= base;
+    }
+    return result;
+}
+
+/*
+ * Build the directed ring 0 -> 1 -> ... -> 9 -> 0 and a workspace for it.
+ */
+static void init_ring(void)
+{
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+    }
+    graph_ppr_init(&ws, &graph, estimate, residual, degree, queue, flags,
+                   touched);
+}
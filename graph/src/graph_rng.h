@@ -0,0 +1,151 @@
+/*
+ * A small, seedable pseudo-random number generator for the graph headers.
+ * See https://prng.di.unimi.it/ for the theory behind xoshiro128**.
+ *
+ * The C library's rand() shares one hidden state across the whole program, has
+ * implementation-defined quality and can't be split between workers. The graph
+ * algorithms need reproducible streams that can be handed to independent
+ * workers, so this header provides xoshiro128** using only 32-bit arithmetic
+ * (C89 has no 64-bit integer type).
+ *
+ * === How to Use ===
+ * Seed a GraphRng with 'graph_rng_seed' and draw from it with the functions
+ * below. Two generators seeded with the same seed but different stream numbers
+ * produce unrelated sequences, so give every worker (or every walker, every
+ * round, ...) its own stream number and results won't depend on how work was
+ * split up.
+ *
+ * 'graph_rng_hash' is a stateless alternative: it maps a (seed, counter) pair
+ * straight to a random value, for code that wants the i-th random number
+ * without generating the first i - 1.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_RNG_H
+#define GRAPH_RNG_H
+
+typedef struct GraphRngTag GraphRng;
+
+/*  unsigned long is at least 32 bits, only the low 32 are used  */
+#define GRAPH_RNG_MASK 0xFFFFFFFFUL
+#define GRAPH_RNG_ROTL(x, k) \
+    ((((x) << (k)) | ((x) >> (32 - (k)))) & GRAPH_RNG_MASK)
+
+/*
+ * Generator state. Must not be all zero, which seeding guarantees.
+ *
+ * @state: The four 32-bit words of xoshiro128** state.
+ */
+struct GraphRngTag
+{
+    unsigned long state[4];
+};
+
+/*
+ * Mix a 32-bit value into a well distributed 32-bit value.
+ * The finalizer of MurmurHash3.
+ */
+static unsigned long graph_rng_mix(unsigned long x)
+{
+    x &= GRAPH_RNG_MASK;
+    x ^= x >> 16;
+    x = (x * 0x85EBCA6BUL) & GRAPH_RNG_MASK;
+    x ^= x >> 13;
+    x = (x * 0xC2B2AE35UL) & GRAPH_RNG_MASK;
+    x ^= x >> 16;
+    return x;
+}
+
+/*
+ * Map a seed and a counter to a random 32-bit value, without state.
+ *
+ * @seed: Selects the sequence.
+ * @counter: Position in the sequence.
+ */
+static unsigned long graph_rng_hash(unsigned long seed, unsigned long counter)
+{
+    return graph_rng_mix(graph_rng_mix(seed ^ 0x9E3779B9UL) +
+                         ((counter * 0x9E3779B9UL) & GRAPH_RNG_MASK) +
+                         0x7F4A7C15UL);
+}
+
+/*
+ * Seed a generator.
+ *
+ * @seed: The seed shared by a family of generators.
+ * @stream: Selects one generator of the family.
+ */
+static void graph_rng_seed(GraphRng *rng, unsigned long seed,
+                           unsigned long stream)
+{
+    int idx;
+
+    for (idx = 0; idx < 4; idx++)
+    {
+        rng->state[idx] = graph_rng_hash(seed ^ graph_rng_mix(stream + 1),
+                                         (unsigned long)idx);
+    }
+    if ((rng->state[0] | rng->state[1] | rng->state[2] | rng->state[3]) == 0)
+    {
+        rng->state[0] = 1;
+    }
+}
+
+/*
+ * Draw a uniformly distributed 32-bit value.
+ */
+static unsigned long graph_rng_next(GraphRng *rng)
+{
+    unsigned long *s;
+    unsigned long result;
+    unsigned long t;
+
+    s = rng->state;
+    result = GRAPH_RNG_ROTL((s[1] * 5) & GRAPH_RNG_MASK, 7);
+    result = (result * 9) & GRAPH_RNG_MASK;
+    t = (s[1] << 9) & GRAPH_RNG_MASK;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = GRAPH_RNG_ROTL(s[3], 11);
+
+    return result;
+}
+
+/*
+ * Draw a uniformly distributed int in [0, @bound).
+ * Rejects the few values that would bias a plain modulo.
+ *
+ * @bound: Exclusive upper bound. Must be positive.
+ */
+static int graph_rng_below(GraphRng *rng, int bound)
+{
+    unsigned long threshold;
+    unsigned long value;
+
+    /*  2^32 mod bound, the count of values that would be over-represented  */
+    threshold = ((GRAPH_RNG_MASK - (unsigned long)bound) + 1) %
+                (unsigned long)bound;
+    do
+    {
+        value = graph_rng_next(rng);
+    } while (value < threshold);
+
+    return (int)(value % (unsigned long)bound);
+}
+
+/*
+ * Draw a uniformly distributed double in [0, 1).
+ */
+static double graph_rng_double(GraphRng *rng)
+{
+    return (double)graph_rng_next(rng) * (1.0 / 4294967296.0);
+}
+
+
+#endif
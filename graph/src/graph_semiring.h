@@ -0,0 +1,256 @@
+/*
+ * Sparse matrix-vector products over a graph's adjacency, on any semiring.
+ * See Kepner and Gilbert, "Graph Algorithms in the Language of Linear Algebra"
+ * (2011) and the GraphBLAS C API for the theory.
+ *
+ * Many graph algorithms are one loop repeated: combine a value from each
+ * neighbor along the edge to it, then reduce the combined values per node.
+ * With the adjacency matrix A, that is a product of A with a vector where
+ * "times" does the combining and "plus" the reducing. Which pair of operations
+ * is used, the semiring, decides the algorithm:
+ *   - plus-times: ordinary arithmetic. PageRank, with edge weights of one over
+ *     the out-degree.
+ *   - min-plus: the shortest of each node's paths extended by one edge. One
+ *     round of Bellman-Ford for shortest paths.
+ *   - or-and: whether any neighbor is set. One level of breadth first search.
+ * Two kernels do the products over a CSR snapshot from graph_csr.h:
+ *   - Pull (SpMV): every node in a range reads its row. y[u] is the sum over
+ *     edges u -> v of w(u, v) times x[v]. Best when most of x is non-zero.
+ *   - Push (SpMSpV): every node in a sparse list of inputs writes into its
+ *     row. y[v] gets w(u, v) times x[u] added for each listed u with an edge
+ *     u -> v. Best when x is a small frontier.
+ * Pulling over a snapshot is pushing over its transpose, so a pull over the
+ * edges into each node takes 'graph_semiring_transpose' first.
+ *
+ * Both kernels take an optional mask. A masked node's output is never
+ * written, and with @complement set the mask is read inverted, eg "only nodes
+ * not yet visited" for breadth first search.
+ *
+ * === How to Use ===
+ * Put 'DEFINE_GRAPH_SEMIRING(Name, T, ZERO, ADD, MUL, WEIGHT)' at the top of
+ * your file to define kernels over values of type T, where ADD and MUL are
+ * macros or functions of two arguments, ZERO is the identity of ADD and
+ * WEIGHT converts an edge weight, a double, to T. This defines
+ * 'graph_Name_spmv' and 'graph_Name_spmspv', compiled for exactly those
+ * operations. The three semirings above are defined by this header as
+ * plus_times and min_plus over doubles and or_and over chars, where an edge
+ * is true if its weight is non-zero. Unweighted snapshots have weights of 1.
+ *
+ * This header does no memory management and spawns no threads. Pulls write
+ * only the outputs of their own range, so ranges can be given to separate
+ * workers. Pushes from separate ranges of a list write the same outputs; give
+ * each worker its own output vector, or make ADD atomic.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_SEMIRING_H
+#define GRAPH_SEMIRING_H
+
+#include <math.h>
+#include "graph_csr.h"
+
+/*  operations of the predefined semirings  */
+#define GRAPH_SR_PLUS(a, b) ((a) + (b))
+#define GRAPH_SR_TIMES(a, b) ((a) * (b))
+#define GRAPH_SR_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define GRAPH_SR_OR(a, b) ((char)((a) || (b)))
+#define GRAPH_SR_AND(a, b) ((char)((a) && (b)))
+
+/*  edge weight conversions of the predefined semirings  */
+#define GRAPH_SR_AS_IS(w) (w)
+#define GRAPH_SR_NONZERO(w) ((char)((w) != 0.0))
+
+/*  whether a mask lets a node's output be written  */
+#define GRAPH_SR_WRITABLE(mask, complement, node_id) \
+    ((mask) == 0 || ((mask)[node_id] != 0) != ((complement) != 0))
+
+/*
+ * Macro to define the kernels of a semiring.
+ *
+ * @Name: Name of the semiring. Must be alphanumerical.
+ * @T: Type of the values.
+ * @ZERO: Identity of @ADD, the value of a node nothing reaches.
+ * @ADD: Reduces two values, eg GRAPH_SR_PLUS.
+ * @MUL: Combines an edge weight, its first argument, with a value.
+ * @WEIGHT: Converts an edge weight from a double to @T, eg GRAPH_SR_AS_IS.
+ */
+#define DEFINE_GRAPH_SEMIRING(Name, T, ZERO, ADD, MUL, WEIGHT) \
+    DEFINE_GRAPH_SEMIRING_SPMV(Name, T, ZERO, ADD, MUL, WEIGHT) \
+    DEFINE_GRAPH_SEMIRING_SPMSPV(Name, T, ZERO, ADD, MUL, WEIGHT)
+
+/*
+ * Pull: compute the product of a range of rows of a snapshot with a dense
+ * vector.
+ *
+ * @x: Input value of each node.
+ * @y: Output value of each node. Must not be @x.
+ * @mask: Flag per node. May be null, for no mask.
+ * @complement: Nonzero to write only the nodes whose flag is clear.
+ * @accum: Nonzero to add the product into @y, zero to overwrite @y.
+ * @lo: First row to compute.
+ * @hi: One past the last row to compute.
+ * @return: The number of outputs in the range whose value changed.
+ */
+#define DEFINE_GRAPH_SEMIRING_SPMV(Name, T, ZERO, ADD, MUL, WEIGHT) \
+    static long graph_##Name##_spmv(const CsrGraph *csr, const T *x, T *y, \
+                                    const char *mask, int complement, \
+                                    int accum, int lo, int hi) \
+    { \
+        int node_id; \
+        int entry; \
+        long changed; \
+        T acc; \
+        \
+        changed = 0; \
+        for (node_id = lo; node_id < hi; node_id++) \
+        { \
+            if (!GRAPH_SR_WRITABLE(mask, complement, node_id)) \
+            { \
+                continue; \
+            } \
+            \
+            acc = (accum ? y[node_id] : (ZERO)); \
+            for (entry = csr->offsets[node_id]; \
+                 entry < csr->offsets[node_id + 1]; entry++) \
+            { \
+                acc = ADD(acc, MUL(WEIGHT(graph_csr_weight(csr, entry)), \
+                                   x[csr->adj[entry]])); \
+            } \
+            if (acc != y[node_id]) \
+            { \
+                y[node_id] = acc; \
+                changed++; \
+            } \
+        } \
+        \
+        return changed; \
+    }
+
+/*
+ * Push: add the products of the rows of a sparse list of nodes with their
+ * values into a dense output, listing the outputs it reaches.
+ * CAUTION: outputs not yet reached must hold ZERO, and an output is listed
+ *   when it first leaves ZERO. Reset the listed outputs before the next push
+ *   into the same vector.
+ *
+ * @in_ids: Ids of the nodes with input values.
+ * @lo: First position of @in_ids to push.
+ * @hi: One past the last position of @in_ids to push.
+ * @x: Input value of each node. Only read for the listed nodes.
+ * @y: Output value of each node.
+ * @mask: Flag per node. May be null, for no mask.
+ * @complement: Nonzero to write only the nodes whose flag is clear.
+ * @out_ids: Receives the ids of the outputs that left ZERO. Needs room for
+ *   every node in the worst case.
+ * @return: The number of ids written to @out_ids.
+ */
+#define DEFINE_GRAPH_SEMIRING_SPMSPV(Name, T, ZERO, ADD, MUL, WEIGHT) \
+    static int graph_##Name##_spmspv(const CsrGraph *csr, \
+                                     const int *in_ids, int lo, int hi, \
+                                     const T *x, T *y, const char *mask, \
+                                     int complement, int *out_ids) \
+    { \
+        int pos; \
+        int node_id; \
+        int to_id; \
+        int entry; \
+        int num_out; \
+        T old; \
+        \
+        num_out = 0; \
+        for (pos = lo; pos < hi; pos++) \
+        { \
+            node_id = in_ids[pos]; \
+            for (entry = csr->offsets[node_id]; \
+                 entry < csr->offsets[node_id + 1]; entry++) \
+            { \
+                to_id = csr->adj[entry]; \
+                if (!GRAPH_SR_WRITABLE(mask, complement, to_id)) \
+                { \
+                    continue; \
+                } \
+                \
+                old = y[to_id]; \
+                y[to_id] = ADD(old, \
+                               MUL(WEIGHT(graph_csr_weight(csr, entry)), \
+                                   x[node_id])); \
+                if (old == (ZERO) && y[to_id] != (ZERO)) \
+                { \
+                    out_ids[num_out++] = to_id; \
+                } \
+            } \
+        } \
+        \
+        return num_out; \
+    }
+
+DEFINE_GRAPH_SEMIRING(plus_times, double, 0.0, GRAPH_SR_PLUS, GRAPH_SR_TIMES,
+                      GRAPH_SR_AS_IS)
+DEFINE_GRAPH_SEMIRING(min_plus, double, HUGE_VAL, GRAPH_SR_MIN, GRAPH_SR_PLUS,
+                      GRAPH_SR_AS_IS)
+DEFINE_GRAPH_SEMIRING(or_and, char, 0, GRAPH_SR_OR, GRAPH_SR_AND,
+                      GRAPH_SR_NONZERO)
+
+/*
+ * Build the transpose of a snapshot, with an edge v -> u for every edge
+ * u -> v and the same weight. Rows of the transpose come out sorted.
+ *
+ * @out: Receives the transpose.
+ * @offsets: Array of csr->num_nodes + 1 ints.
+ * @adj: Array of csr->num_entries ints.
+ * @weights: Array of csr->num_entries doubles, or null to leave the
+ *   transpose unweighted. Ignored if @csr is unweighted.
+ */
+static void graph_semiring_transpose(const CsrGraph *csr, CsrGraph *out,
+                                     int *offsets, int *adj, double *weights)
+{
+    int node_id;
+    int entry;
+    int slot;
+
+    out->num_nodes = csr->num_nodes;
+    out->num_entries = csr->num_entries;
+    out->offsets = offsets;
+    out->adj = adj;
+    out->weights = (csr->weights == 0 ? 0 : weights);
+
+    /*  count edges into each node, then place them by source order, which
+     *  leaves each row sorted  */
+    for (node_id = 0; node_id <= csr->num_nodes; node_id++)
+    {
+        offsets[node_id] = 0;
+    }
+    for (entry = 0; entry < csr->num_entries; entry++)
+    {
+        offsets[csr->adj[entry] + 1]++;
+    }
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        offsets[node_id + 1] += offsets[node_id];
+    }
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        for (entry = csr->offsets[node_id];
+             entry < csr->offsets[node_id + 1]; entry++)
+        {
+            slot = offsets[csr->adj[entry]]++;
+            adj[slot] = node_id;
+            if (out->weights != 0)
+            {
+                out->weights[slot] = csr->weights[entry];
+            }
+        }
+    }
+
+    /*  each offset was advanced to the next row's start, shift them back  */
+    for (node_id = csr->num_nodes; node_id > 0; node_id--)
+    {
+        offsets[node_id] = offsets[node_id - 1];
+    }
+    offsets[0] = 0;
+}
+
+
+#endif
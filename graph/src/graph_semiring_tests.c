@@ -0,0 +1,284 @@
+/*
+ * Unit tests for the semiring kernel header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_semiring.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 8
+#define MAX_ENTRIES 32
+
+/*  a user-defined semiring: the largest value reaching a node  */
+#define MAX_OF(a, b) ((a) > (b) ? (a) : (b))
+#define SECOND(a, b) (b)
+#define TO_INT(w) ((int)(w))
+DEFINE_GRAPH_SEMIRING(max_second, int, -1, MAX_OF, SECOND, TO_INT)
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static CsrGraph csr;
+static int offsets[INIT_SIZE + 1];
+static int adj[MAX_ENTRIES];
+static double weights[MAX_ENTRIES];
+
+static void init_graph(void);
+
+
+void test_transpose()
+{
+    CsrGraph trans;
+    int trans_offsets[INIT_SIZE + 1];
+    int trans_adj[MAX_ENTRIES];
+    double trans_weights[MAX_ENTRIES];
+    int node_id;
+    int entry;
+    int found;
+
+    init_graph();
+    graph_semiring_transpose(&csr, &trans, trans_offsets, trans_adj,
+                             trans_weights);
+
+    TEST_ASSERT_EQUAL(csr.num_entries, trans.num_entries);
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        for (entry = csr.offsets[node_id];
+             entry < csr.offsets[node_id + 1]; entry++)
+        {
+            found = graph_csr_find(&trans, csr.adj[entry], node_id);
+            TEST_ASSERT_TRUE(found >= 0);
+            TEST_ASSERT_EQUAL_FLOAT(csr.weights[entry], trans.weights[found]);
+        }
+        for (entry = trans.offsets[node_id] + 1;
+             entry < trans.offsets[node_id + 1]; entry++)
+        {
+            TEST_ASSERT_TRUE(trans.adj[entry - 1] < trans.adj[entry]);
+        }
+    }
+}
+
+void test_pull_plus_times_with_mask()
+{
+    double x[INIT_SIZE];
+    double y[INIT_SIZE];
+    char mask[INIT_SIZE] = {0, 1, 0, 0, 0, 0, 0, 0};
+    int node_id;
+
+    init_graph();
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        x[node_id] = node_id;
+        y[node_id] = -1.0;
+    }
+
+    /* Row 0 is 2 * x[1] + 4 * x[2], row 1 is masked out. */
+    TEST_ASSERT_EQUAL(INIT_SIZE - 1, graph_plus_times_spmv(&csr, x, y, mask,
+                                                           1, 0, 0,
+                                                           INIT_SIZE));
+    TEST_ASSERT_EQUAL_FLOAT(10.0, y[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0, y[1]);
+    TEST_ASSERT_EQUAL_FLOAT(3.0 * 3 + 1.0 * 4, y[2]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, y[7]);
+
+    /* Accumulate a second product into half the rows. */
+    TEST_ASSERT_EQUAL(4, graph_plus_times_spmv(&csr, x, y, 0, 0, 1, 0, 4));
+    TEST_ASSERT_EQUAL_FLOAT(20.0, y[0]);
+    TEST_ASSERT_EQUAL_FLOAT(4.0, y[1]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0, y[7]);
+}
+
+void test_push_or_and_is_bfs()
+{
+    char frontier_vals[INIT_SIZE];
+    char next_vals[INIT_SIZE];
+    char visited[INIT_SIZE];
+    int frontier[INIT_SIZE];
+    int next[INIT_SIZE];
+    int level[INIT_SIZE];
+    int expected[INIT_SIZE] = {0, 1, 1, 2, 2, 3, 3, -1};
+    int count;
+    int depth;
+    int idx;
+
+    init_graph();
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        frontier_vals[idx] = 0;
+        next_vals[idx] = 0;
+        visited[idx] = 0;
+        level[idx] = -1;
+    }
+    frontier[0] = 0;
+    frontier_vals[0] = 1;
+    visited[0] = 1;
+    level[0] = 0;
+    count = 1;
+
+    /*  one level per push, never into visited nodes  */
+    for (depth = 1; count > 0; depth++)
+    {
+        count = graph_or_and_spmspv(&csr, frontier, 0, count, frontier_vals,
+                                    next_vals, visited, 1, next);
+        for (idx = 0; idx < count; idx++)
+        {
+            visited[next[idx]] = 1;
+            level[next[idx]] = depth;
+            frontier[idx] = next[idx];
+            frontier_vals[next[idx]] = 1;
+            next_vals[next[idx]] = 0;
+        }
+    }
+
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL(expected[idx], level[idx]);
+    }
+}
+
+void test_or_and_reads_weights()
+{
+    char x[INIT_SIZE] = {0, 0, 0, 1, 1, 0, 0, 0};
+    char y[INIT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0};
+    int out[INIT_SIZE];
+    int in[1] = {0};
+
+    /* A fractional weight is an edge, a weight of zero is none. */
+    init_graph();
+    weights[graph_csr_find(&csr, 0, 1)] = 0.5;
+    weights[graph_csr_find(&csr, 0, 2)] = 0.0;
+    x[0] = 1;
+    TEST_ASSERT_EQUAL(1, graph_or_and_spmspv(&csr, in, 0, 1, x, y, 0, 0,
+                                             out));
+    TEST_ASSERT_EQUAL(1, out[0]);
+    TEST_ASSERT_EQUAL(1, y[1]);
+    TEST_ASSERT_EQUAL(0, y[2]);
+
+    /* Row 2 reads 3 and 4, row 0 reads nothing set. */
+    weights[graph_csr_find(&csr, 2, 3)] = 0.25;
+    x[0] = 0;
+    graph_or_and_spmv(&csr, x, y, 0, 0, 0, 0, INIT_SIZE);
+    TEST_ASSERT_EQUAL(1, y[2]);
+    TEST_ASSERT_EQUAL(0, y[0]);
+    TEST_ASSERT_EQUAL(1, y[1]);
+}
+
+void test_pull_min_plus_is_bellman_ford()
+{
+    CsrGraph trans;
+    int trans_offsets[INIT_SIZE + 1];
+    int trans_adj[MAX_ENTRIES];
+    double trans_weights[MAX_ENTRIES];
+    double dist[INIT_SIZE];
+    double next[INIT_SIZE];
+    double expected[INIT_SIZE] = {0.0, 2.0, 3.0, 3.0, 4.0, 6.0, 5.0, HUGE_VAL};
+    int rounds;
+    int idx;
+
+    init_graph();
+    graph_semiring_transpose(&csr, &trans, trans_offsets, trans_adj,
+                             trans_weights);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        dist[idx] = HUGE_VAL;
+        next[idx] = HUGE_VAL;
+    }
+    dist[0] = 0.0;
+    next[0] = 0.0;
+
+    /*  relax every edge into each node until nothing changes  */
+    rounds = 0;
+    while (graph_min_plus_spmv(&trans, dist, next, 0, 0, 1, 0, INIT_SIZE) > 0)
+    {
+        for (idx = 0; idx < INIT_SIZE; idx++)
+        {
+            dist[idx] = next[idx];
+        }
+        rounds++;
+    }
+
+    TEST_ASSERT_TRUE(rounds < INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(expected[idx], dist[idx]);
+    }
+}
+
+void test_user_semiring()
+{
+    int x[INIT_SIZE] = {7, 3, 9, 1, 4, 8, 2, 5};
+    int y[INIT_SIZE];
+    int out[INIT_SIZE];
+    int in[2] = {0, 2};
+    int idx;
+
+    init_graph();
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        y[idx] = -1;
+    }
+
+    /* 0 reaches 1 and 2, 2 reaches 3 and 4: the largest input wins. */
+    TEST_ASSERT_EQUAL(4, graph_max_second_spmspv(&csr, in, 0, 2, x, y, 0, 0,
+                                                 out));
+    TEST_ASSERT_EQUAL(7, y[1]);
+    TEST_ASSERT_EQUAL(9, y[3]);
+    TEST_ASSERT_EQUAL(-1, y[0]);
+    TEST_ASSERT_EQUAL(1, out[0]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  transpose a weighted snapshot, verify edges and sorted rows  */
+    RUN_TEST(test_transpose);
+    /*  multiply by a dense vector under a mask, then accumulate  */
+    RUN_TEST(test_pull_plus_times_with_mask);
+    /*  run a breadth first search as pushes over or-and  */
+    RUN_TEST(test_push_or_and_is_bfs);
+    /*  push and pull or-and over fractional and zero weights  */
+    RUN_TEST(test_or_and_reads_weights);
+    /*  run Bellman-Ford as pulls over min-plus on the transpose  */
+    RUN_TEST(test_pull_min_plus_is_bellman_ford);
+    /*  define a semiring in the test and push through it  */
+    RUN_TEST(test_user_semiring);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build a weighted snapshot of:
+ *   0 -> 1 (2), 0 -> 2 (4), 1 -> 2 (1), 1 -> 3 (1), 2 -> 3 (3), 2 -> 4 (1),
+ *   3 -> 4 (1), 3 -> 5 (5), 4 -> 6 (1), 6 -> 5 (1), 5 -> 0 (1)
+ * Node 7 has no edges. The weight of an edge is in parentheses.
+ */
+static void init_graph(void)
+{
+    int from[11] = {0, 0, 1, 1, 2, 2, 3, 3, 4, 6, 5};
+    int to[11] = {1, 2, 2, 3, 3, 4, 4, 5, 6, 5, 0};
+    double w[11] = {2, 4, 1, 1, 3, 1, 1, 5, 1, 1, 1};
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (idx = 0; idx < 11; idx++)
+    {
+        graph_add_edge(&graph, from[idx], to[idx]);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+
+    /*  rows are sorted and have no duplicates, so look each weight up  */
+    csr.weights = weights;
+    for (idx = 0; idx < 11; idx++)
+    {
+        weights[graph_csr_find(&csr, from[idx], to[idx])] = w[idx];
+    }
+}
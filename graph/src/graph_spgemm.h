@@ -0,0 +1,344 @@
+/*
+ * Sparse matrix-matrix products of graph adjacencies: two-hop neighborhoods,
+ * path counts and graph squaring in one pass.
+ * See Gustavson, "Two Fast Algorithms for Sparse Matrices: Multiplication and
+ * Permuted Transposition" (1978) and Buluc and Gilbert, "Parallel Sparse
+ * Matrix-Matrix Multiplication and Indexing" (2012) for the theory.
+ *
+ * With the adjacency matrices A and B, the product C = A * B has an entry
+ * u -> w for every pair of edges u -> v in A and v -> w in B, and its weight is
+ * the sum over those v of w(u, v) times w(v, w). On unweighted snapshots that
+ * is the number of two-hop paths from u to w, so A * A lists friends of
+ * friends along with how many friends they have in common. Gustavson's
+ * algorithm builds C a row at a time: for each edge u -> v it scatters the row
+ * of v into an accumulator, then gathers the accumulator into row u. The work
+ * is the number of multiplications, never the n * n of the dense product.
+ *
+ * Most uses don't want every entry of the product. A mask snapshot restricts
+ * the output to its entries, or, complemented, to the entries it lacks: A * A
+ * masked by the complement of A is the two-hop pairs that aren't already
+ * edges, the candidates of link prediction. Masked entries are dropped as they
+ * are scattered and never take space in the output.
+ *
+ * The accumulator is dense, one slot per node, with slots stamped by row as in
+ * graph_traverse.h. Starting a row is bumping a stamp, so a row costs only
+ * what is scattered into it however many nodes there are.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. Each worker
+ * needs its own workspace: allocate graph->size unsigned ints, ints and
+ * doubles and call 'graph_spgemm_init'. A product takes two passes over the
+ * same rows:
+ *   1. Call 'graph_spgemm_count' with the output's row offsets array, of
+ *      num_nodes + 1 ints, to size each row, then 'graph_spgemm_offsets' to
+ *      turn the sizes into offsets. The last offset is the number of entries.
+ *   2. Allocate that many ints, and doubles if the weights are wanted, set up
+ *      the output snapshot and call 'graph_spgemm_fill'.
+ * Both passes take a range [lo, hi) of rows. Rows are independent, so ranges
+ * can be handed to separate workers; 'graph_spgemm_split' cuts ranges of
+ * equal work. Only 'graph_spgemm_offsets' runs over every row at once, between
+ * the passes. Rows of the output are sorted, like any snapshot.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_SPGEMM_H
+#define GRAPH_SPGEMM_H
+
+#include "graph_csr.h"
+
+typedef struct SpgemmSpaceTag SpgemmSpace;
+
+/*  flags of a product  */
+#define SPGEMM_COMPLEMENT 1 /* keep only the entries the mask lacks */
+#define SPGEMM_NO_SELF 2    /* drop the entries u -> u */
+
+static int graph_spgemm_row(const CsrGraph *a, const CsrGraph *b,
+                            const CsrGraph *mask, int flags,
+                            SpgemmSpace *space, int row, int with_vals);
+static long graph_spgemm_work(const CsrGraph *a, const CsrGraph *b, int row);
+
+/*
+ * A product workspace, reused from one row to the next.
+ *
+ * @size: Number of nodes.
+ * @epoch: Stamp of the slots in the current row. Slots stamped @epoch + 1 are
+ *   blocked by the mask, or let through by it when it isn't complemented.
+ * @stamp: Stamp of each slot.
+ * @vals: Accumulated weight of each slot.
+ * @cols: Ids of the slots in the current row, in the order they were reached.
+ */
+struct SpgemmSpaceTag
+{
+    int size;
+    unsigned int epoch;
+    unsigned int *stamp;
+    double *vals;
+    int *cols;
+};
+
+
+/*
+ * Initialize a product workspace.
+ *
+ * @size: Number of nodes of the snapshots it will multiply.
+ * @stamp: Array of @size unsigned ints.
+ * @cols: Array of @size ints.
+ * @vals: Array of @size doubles, or null if only the pattern of products will
+ *   be filled.
+ */
+static void graph_spgemm_init(SpgemmSpace *space, int size,
+                              unsigned int *stamp, int *cols, double *vals)
+{
+    int node_id;
+
+    space->size = size;
+    space->epoch = 0;
+    space->stamp = stamp;
+    space->vals = vals;
+    space->cols = cols;
+    for (node_id = 0; node_id < size; node_id++)
+    {
+        stamp[node_id] = 0;
+    }
+}
+
+/*
+ * Count the entries of a range of rows of a product.
+ *
+ * @a: Left factor.
+ * @b: Right factor. Must have as many nodes as @a.
+ * @mask: Snapshot whose entries the output is restricted to. May be null, for
+ *   no mask.
+ * @flags: Bitwise or of SPGEMM_ flags, or 0.
+ * @lo: First row to count.
+ * @hi: One past the last row to count.
+ * @offsets: Receives the number of entries of row u at @offsets[u + 1].
+ * @return: The number of entries in the range.
+ */
+static long graph_spgemm_count(const CsrGraph *a, const CsrGraph *b,
+                               const CsrGraph *mask, int flags,
+                               SpgemmSpace *space, int lo, int hi,
+                               int *offsets)
+{
+    int row;
+    long total;
+
+    total = 0;
+    for (row = lo; row < hi; row++)
+    {
+        offsets[row + 1] = graph_spgemm_row(a, b, mask, flags, space, row, 0);
+        total += offsets[row + 1];
+    }
+
+    return total;
+}
+
+/*
+ * Turn the row sizes left by 'graph_spgemm_count' into row offsets.
+ *
+ * @offsets: Array of @num_nodes + 1 ints, counted for every row.
+ * @return: The number of entries of the product.
+ */
+static int graph_spgemm_offsets(int *offsets, int num_nodes)
+{
+    int node_id;
+
+    offsets[0] = 0;
+    for (node_id = 0; node_id < num_nodes; node_id++)
+    {
+        offsets[node_id + 1] += offsets[node_id];
+    }
+
+    return offsets[num_nodes];
+}
+
+/*
+ * Fill a range of rows of a product.
+ * CAUTION: call with the same snapshots, mask and flags as
+ *   'graph_spgemm_count', or rows will overrun their offsets.
+ *
+ * @out: The product. Its @offsets must come from 'graph_spgemm_offsets' and
+ *   its @adj must hold offsets[num_nodes] ints. If its @weights is set, the
+ *   workspace must have been given @vals.
+ * @lo: First row to fill.
+ * @hi: One past the last row to fill.
+ */
+static void graph_spgemm_fill(const CsrGraph *a, const CsrGraph *b,
+                              const CsrGraph *mask, int flags,
+                              SpgemmSpace *space, int lo, int hi,
+                              CsrGraph *out)
+{
+    int row;
+    int len;
+    int idx;
+    int *dest;
+    double *dest_weights;
+
+    for (row = lo; row < hi; row++)
+    {
+        len = graph_spgemm_row(a, b, mask, flags, space, row,
+                               out->weights != 0);
+        dest = &out->adj[out->offsets[row]];
+        dest_weights = (out->weights == 0 ? 0 :
+                        &out->weights[out->offsets[row]]);
+        for (idx = 0; idx < len; idx++)
+        {
+            dest[idx] = space->cols[idx];
+            if (dest_weights != 0)
+            {
+                dest_weights[idx] = space->vals[space->cols[idx]];
+            }
+        }
+        graph_csr_sort_row(dest, dest_weights, len);
+    }
+}
+
+/*
+ * Cut the rows of a product into ranges of about equal work.
+ * The work of a row is the number of multiplications it takes, the sum of the
+ * degrees in @b of its neighbors in @a, so a row next to hubs gets a range of
+ * its own.
+ *
+ * @num_ranges: Number of ranges to cut.
+ * @bounds: Array of @num_ranges + 1 ints. Range r is
+ *   [bounds[r], bounds[r + 1]).
+ */
+static void graph_spgemm_split(const CsrGraph *a, const CsrGraph *b,
+                               int num_ranges, int *bounds)
+{
+    long total;
+    long sum;
+    int range;
+    int node_id;
+
+    total = 0;
+    for (node_id = 0; node_id < a->num_nodes; node_id++)
+    {
+        total += graph_spgemm_work(a, b, node_id);
+    }
+
+    bounds[0] = 0;
+    node_id = 0;
+    sum = 0;
+    for (range = 1; range < num_ranges; range++)
+    {
+        while (node_id < a->num_nodes && sum * num_ranges < total * range)
+        {
+            sum += graph_spgemm_work(a, b, node_id);
+            node_id++;
+        }
+        bounds[range] = node_id;
+    }
+    bounds[num_ranges] = a->num_nodes;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Scatter one row of a product into the workspace.
+ * The ids of the row's entries are left in space->cols, unsorted, and their
+ * weights in space->vals by id.
+ *
+ * @with_vals: Nonzero to accumulate weights, zero to find the pattern only.
+ * @return: The number of entries of the row.
+ */
+static int graph_spgemm_row(const CsrGraph *a, const CsrGraph *b,
+                            const CsrGraph *mask, int flags,
+                            SpgemmSpace *space, int row, int with_vals)
+{
+    unsigned int epoch;
+    int allow_list;
+    int len;
+    int entry;
+    int mid_id;
+    int mid_entry;
+    int to_id;
+    int node_id;
+    double weight;
+
+    /*  start a row, clearing the stamps only when the epoch wraps around  */
+    if (space->epoch >= (unsigned int)-1 - 2)
+    {
+        for (node_id = 0; node_id < space->size; node_id++)
+        {
+            space->stamp[node_id] = 0;
+        }
+        space->epoch = 0;
+    }
+    space->epoch += 2;
+    epoch = space->epoch;
+
+    /*  stamp the mask's row: entries let through by a plain mask, entries
+     *  blocked by a complemented one  */
+    allow_list = (mask != 0 && !(flags & SPGEMM_COMPLEMENT));
+    if (mask != 0)
+    {
+        for (entry = mask->offsets[row]; entry < mask->offsets[row + 1];
+             entry++)
+        {
+            space->stamp[mask->adj[entry]] = epoch + 1;
+        }
+    }
+    if (flags & SPGEMM_NO_SELF)
+    {
+        space->stamp[row] = (allow_list ? 0 : epoch + 1);
+    }
+
+    len = 0;
+    for (entry = a->offsets[row]; entry < a->offsets[row + 1]; entry++)
+    {
+        mid_id = a->adj[entry];
+        weight = graph_csr_weight(a, entry);
+        for (mid_entry = b->offsets[mid_id];
+             mid_entry < b->offsets[mid_id + 1]; mid_entry++)
+        {
+            to_id = b->adj[mid_entry];
+            if (space->stamp[to_id] == epoch)
+            {
+                if (with_vals)
+                {
+                    space->vals[to_id] += weight *
+                                          graph_csr_weight(b, mid_entry);
+                }
+                continue;
+            }
+            if ((space->stamp[to_id] == epoch + 1) != allow_list)
+            {
+                continue;
+            }
+
+            space->stamp[to_id] = epoch;
+            space->cols[len++] = to_id;
+            if (with_vals)
+            {
+                space->vals[to_id] = weight * graph_csr_weight(b, mid_entry);
+            }
+        }
+    }
+
+    return len;
+}
+
+/*
+ * Count the multiplications one row of a product takes, plus one so empty
+ * rows still count for something.
+ */
+static long graph_spgemm_work(const CsrGraph *a, const CsrGraph *b, int row)
+{
+    long work;
+    int entry;
+
+    work = 1;
+    for (entry = a->offsets[row]; entry < a->offsets[row + 1]; entry++)
+    {
+        work += graph_csr_degree(b, a->adj[entry]);
+    }
+
+    return work;
+}
+
+
+#endif
@@ -0,0 +1,293 @@
+/*
+ * Unit tests for the sparse matrix-matrix product header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_spgemm.h"
+#include "graph_generators.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 8
+#define MAX_ENTRIES 64
+#define RANDOM_SIZE 60
+#define RANDOM_EDGES 150
+#define NUM_RANGES 3
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static CsrGraph csr;
+static int offsets[INIT_SIZE + 1];
+static int adj[MAX_ENTRIES];
+static SpgemmSpace space;
+static unsigned int stamp[RANDOM_SIZE];
+static int cols[RANDOM_SIZE];
+static double vals[RANDOM_SIZE];
+
+static void init_graph(int undirected);
+static void multiply(const CsrGraph *a, const CsrGraph *b,
+                     const CsrGraph *mask, int flags, CsrGraph *out,
+                     int *out_offsets, int *out_adj, double *out_weights);
+static double naive_entry(const CsrGraph *a, const CsrGraph *b, int from_id,
+                          int to_id);
+
+
+void test_square_counts_paths()
+{
+    CsrGraph prod;
+    int prod_offsets[INIT_SIZE + 1];
+    int prod_adj[MAX_ENTRIES];
+    double prod_weights[MAX_ENTRIES];
+    int from_id;
+    int to_id;
+    int found;
+
+    init_graph(0);
+    multiply(&csr, &csr, 0, 0, &prod, prod_offsets, prod_adj, prod_weights);
+
+    /* 0 reaches 3 through both 1 and 2. */
+    TEST_ASSERT_EQUAL_FLOAT(2.0, prod.weights[graph_csr_find(&prod, 0, 3)]);
+    TEST_ASSERT_EQUAL(2, graph_csr_degree(&prod, 0));
+    TEST_ASSERT_EQUAL(0, graph_csr_degree(&prod, 7));
+    for (from_id = 0; from_id < INIT_SIZE; from_id++)
+    {
+        for (to_id = 0; to_id < INIT_SIZE; to_id++)
+        {
+            found = graph_csr_find(&prod, from_id, to_id);
+            TEST_ASSERT_EQUAL_FLOAT(naive_entry(&csr, &csr, from_id, to_id),
+                                    found < 0 ? 0.0 : prod.weights[found]);
+        }
+    }
+}
+
+void test_two_hop_candidates()
+{
+    CsrGraph prod;
+    int prod_offsets[INIT_SIZE + 1];
+    int prod_adj[MAX_ENTRIES];
+    double prod_weights[MAX_ENTRIES];
+    int node_id;
+    int entry;
+
+    /* Friends of friends that aren't friends yet, or oneself. */
+    init_graph(1);
+    multiply(&csr, &csr, &csr, SPGEMM_COMPLEMENT | SPGEMM_NO_SELF, &prod,
+             prod_offsets, prod_adj, prod_weights);
+
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        for (entry = prod.offsets[node_id];
+             entry < prod.offsets[node_id + 1]; entry++)
+        {
+            TEST_ASSERT_TRUE(prod.adj[entry] != node_id);
+            TEST_ASSERT_EQUAL(-1, graph_csr_find(&csr, node_id,
+                                                 prod.adj[entry]));
+            TEST_ASSERT_EQUAL_FLOAT(naive_entry(&csr, &csr, node_id,
+                                                prod.adj[entry]),
+                                    prod.weights[entry]);
+        }
+    }
+
+    /* 0 and 3 share 1 and 2. */
+    TEST_ASSERT_EQUAL_FLOAT(2.0, prod.weights[graph_csr_find(&prod, 0, 3)]);
+    TEST_ASSERT_EQUAL(-1, graph_csr_find(&prod, 0, 1));
+    TEST_ASSERT_EQUAL(0, graph_csr_degree(&prod, 7));
+}
+
+void test_mask_counts_triangles()
+{
+    CsrGraph prod;
+    int prod_offsets[INIT_SIZE + 1];
+    int prod_adj[MAX_ENTRIES];
+    double prod_weights[MAX_ENTRIES];
+    int entry;
+    double count;
+
+    /* Pattern only: the two-hop paths along existing edges. */
+    init_graph(1);
+    graph_spgemm_init(&space, INIT_SIZE, stamp, cols, 0);
+    multiply(&csr, &csr, &csr, 0, &prod, prod_offsets, prod_adj, 0);
+
+    /* Only the edges of the triangles 0 1 2, 1 2 3 and 4 5 6 are left. */
+    TEST_ASSERT_EQUAL(16, prod.num_entries);
+    TEST_ASSERT_EQUAL(-1, graph_csr_find(&prod, 3, 4));
+    TEST_ASSERT_TRUE(graph_csr_find(&prod, 6, 4) >= 0);
+
+    /* With weights, each edge counts its triangles: 6 per triangle. */
+    graph_spgemm_init(&space, INIT_SIZE, stamp, cols, vals);
+    multiply(&csr, &csr, &csr, 0, &prod, prod_offsets, prod_adj,
+             prod_weights);
+    count = 0.0;
+    for (entry = 0; entry < prod.num_entries; entry++)
+    {
+        count += prod_weights[entry];
+    }
+    TEST_ASSERT_EQUAL_FLOAT(18.0, count);
+}
+
+void test_ranges_match_naive()
+{
+    Graph rand_graph;
+    Node rand_nodes[RANDOM_SIZE];
+    CsrGraph rand_csr;
+    CsrGraph prod;
+    SpgemmSpace spaces[NUM_RANGES];
+    unsigned int *stamps;
+    int *cols_buf;
+    double *vals_buf;
+    int from[RANDOM_EDGES];
+    int to[RANDOM_EDGES];
+    int rand_offsets[RANDOM_SIZE + 1];
+    int *rand_adj;
+    int prod_offsets[RANDOM_SIZE + 1];
+    int *prod_adj;
+    double *prod_weights;
+    int bounds[NUM_RANGES + 1];
+    int range;
+    int from_id;
+    int to_id;
+    int found;
+    long total;
+
+    graph_gen_gnm(RANDOM_SIZE, 11, from, to, 0, RANDOM_EDGES);
+    graph_init(&rand_graph, rand_nodes, RANDOM_SIZE);
+    graph_gen_fill(&rand_graph, from, to, RANDOM_EDGES,
+                   malloc(RANDOM_EDGES * sizeof(Bucket)), RANDOM_EDGES);
+    rand_adj = malloc(graph_csr_count(&rand_graph, 0) * sizeof(int));
+    graph_csr_build(&rand_graph, &rand_csr, rand_offsets, rand_adj, 0);
+
+    /*  each range gets its own workspace, as a separate worker would  */
+    stamps = malloc(NUM_RANGES * RANDOM_SIZE * sizeof(unsigned int));
+    cols_buf = malloc(NUM_RANGES * RANDOM_SIZE * sizeof(int));
+    vals_buf = malloc(NUM_RANGES * RANDOM_SIZE * sizeof(double));
+    graph_spgemm_split(&rand_csr, &rand_csr, NUM_RANGES, bounds);
+    total = 0;
+    for (range = 0; range < NUM_RANGES; range++)
+    {
+        TEST_ASSERT_TRUE(bounds[range] <= bounds[range + 1]);
+        graph_spgemm_init(&spaces[range], RANDOM_SIZE,
+                          &stamps[range * RANDOM_SIZE],
+                          &cols_buf[range * RANDOM_SIZE],
+                          &vals_buf[range * RANDOM_SIZE]);
+        total += graph_spgemm_count(&rand_csr, &rand_csr, 0, 0,
+                                    &spaces[range], bounds[range],
+                                    bounds[range + 1], prod_offsets);
+    }
+    TEST_ASSERT_EQUAL(total, graph_spgemm_offsets(prod_offsets,
+                                                  RANDOM_SIZE));
+
+    prod_adj = malloc(total * sizeof(int));
+    prod_weights = malloc(total * sizeof(double));
+    prod.num_nodes = RANDOM_SIZE;
+    prod.num_entries = (int)total;
+    prod.offsets = prod_offsets;
+    prod.adj = prod_adj;
+    prod.weights = prod_weights;
+    for (range = NUM_RANGES - 1; range >= 0; range--)
+    {
+        graph_spgemm_fill(&rand_csr, &rand_csr, 0, 0, &spaces[range],
+                          bounds[range], bounds[range + 1], &prod);
+    }
+
+    for (from_id = 0; from_id < RANDOM_SIZE; from_id++)
+    {
+        for (to_id = 0; to_id < RANDOM_SIZE; to_id++)
+        {
+            found = graph_csr_find(&prod, from_id, to_id);
+            TEST_ASSERT_EQUAL_FLOAT(naive_entry(&rand_csr, &rand_csr,
+                                                from_id, to_id),
+                                    found < 0 ? 0.0 : prod_weights[found]);
+        }
+    }
+
+    free(rand_adj);
+    free(stamps);
+    free(cols_buf);
+    free(vals_buf);
+    free(prod_adj);
+    free(prod_weights);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  square a directed graph, compare path counts with a naive product  */
+    RUN_TEST(test_square_counts_paths);
+    /*  list two-hop pairs that aren't edges, under a complemented mask  */
+    RUN_TEST(test_two_hop_candidates);
+    /*  restrict the square to existing edges, count triangles  */
+    RUN_TEST(test_mask_counts_triangles);
+    /*  multiply a random graph in ranges, compare with a naive product  */
+    RUN_TEST(test_ranges_match_naive);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build a snapshot of:
+ *   0 -> 1, 0 -> 2, 1 -> 2, 1 -> 3, 2 -> 3, 3 -> 4, 4 -> 5, 5 -> 6, 6 -> 4
+ * Node 7 has no edges.
+ *
+ * @undirected: Nonzero to store every edge in both directions.
+ */
+static void init_graph(int undirected)
+{
+    int from[9] = {0, 0, 1, 1, 2, 3, 4, 5, 6};
+    int to[9] = {1, 2, 2, 3, 3, 4, 5, 6, 4};
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    for (idx = 0; idx < 9; idx++)
+    {
+        graph_add_edge(&graph, from[idx], to[idx]);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, undirected);
+    graph_spgemm_init(&space, INIT_SIZE, stamp, cols, vals);
+}
+
+/*
+ * Multiply two snapshots in one range with the shared workspace.
+ */
+static void multiply(const CsrGraph *a, const CsrGraph *b,
+                     const CsrGraph *mask, int flags, CsrGraph *out,
+                     int *out_offsets, int *out_adj, double *out_weights)
+{
+    graph_spgemm_count(a, b, mask, flags, &space, 0, a->num_nodes,
+                       out_offsets);
+    out->num_nodes = a->num_nodes;
+    out->num_entries = graph_spgemm_offsets(out_offsets, a->num_nodes);
+    out->offsets = out_offsets;
+    out->adj = out_adj;
+    out->weights = out_weights;
+    graph_spgemm_fill(a, b, mask, flags, &space, 0, a->num_nodes, out);
+}
+
+/*
+ * Count the two-hop paths between two nodes by testing every middle node.
+ */
+static double naive_entry(const CsrGraph *a, const CsrGraph *b, int from_id,
+                          int to_id)
+{
+    int mid_id;
+    double sum;
+
+    sum = 0.0;
+    for (mid_id = 0; mid_id < a->num_nodes; mid_id++)
+    {
+        if (graph_csr_find(a, from_id, mid_id) >= 0 &&
+            graph_csr_find(b, mid_id, to_id) >= 0)
+        {
+            sum += 1.0;
+        }
+    }
+    return sum;
+}
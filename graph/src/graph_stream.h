@@ -0,0 +1,466 @@
+/*
+ * Batched streaming edge updates with versioned snapshots for readers.
+ *
+ * The bucket chains of graph.h are changed in place, so a reader traversing
+ * them while a writer adds or deletes edges can see anything. This header
+ * separates the two:
+ *   - Producers append edge inserts and deletes to update logs, one log per
+ *     producer thread, with no sharing between them.
+ *   - Once per epoch a single writer gathers the logs, sorts the updates by
+ *     (from, to) with two stable counting-sort passes, and merges them with
+ *     the current snapshot into the spare one. Sorting keeps the merge a
+ *     single sequential sweep over both, and stability means the last update
+ *     to an edge in log order decides whether it exists.
+ *   - The spare snapshot is then published, and readers that acquire a
+ *     snapshot from then on see the new version. Readers that acquired the
+ *     old one keep a consistent view until they release it.
+ *
+ * Snapshots are directed graph_csr.h snapshots, so every algorithm header can
+ * read them directly. Rows are sorted and hold no duplicates, so an edge is
+ * either present or not: inserting a present edge or deleting a missing one
+ * does nothing.
+ *
+ * === How to Use ===
+ * This header does no memory management and spawns no threads. Allocate
+ * STREAM_INT_WORDS(n, entries, batch) ints and 2 * batch chars, where n is
+ * the number of nodes, entries the most edges a snapshot may hold and batch
+ * the most updates one epoch may apply. Call 'graph_stream_init', and
+ * optionally 'graph_stream_load' to start from an existing Graph.
+ *
+ *   - Producers: give each one a StreamLog with 'graph_stream_log_init' and
+ *     call 'graph_stream_log_insert' and 'graph_stream_log_delete'. A full log
+ *     returns 1; close the epoch or switch to a spare log.
+ *   - Writer: when producers have moved on to their next logs, call
+ *     'graph_stream_apply' with the closed ones.
+ *   - Readers: call 'graph_stream_acquire', read the returned snapshot, then
+ *     'graph_stream_release' it.
+ *
+ * Readers and the writer only share the snapshot index and the per-snapshot
+ * reader counts, accessed through the GRAPH_STREAM_LOAD, GRAPH_STREAM_STORE
+ * and GRAPH_STREAM_ADD macros. By default they are plain memory accesses, fine
+ * for a single thread. For concurrent use define them as sequentially
+ * consistent atomics before including this header, eg with GCC:
+ *   #define GRAPH_STREAM_LOAD(ptr) __sync_fetch_and_add((ptr), 0)
+ *   #define GRAPH_STREAM_STORE(ptr, val) __sync_lock_test_and_set((ptr), (val))
+ *   #define GRAPH_STREAM_ADD(ptr, val) __sync_fetch_and_add((ptr), (val))
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_STREAM_H
+#define GRAPH_STREAM_H
+
+#include "graph_csr.h"
+
+#ifndef GRAPH_STREAM_LOAD
+#define GRAPH_STREAM_LOAD(ptr) (*(ptr))
+#endif
+#ifndef GRAPH_STREAM_STORE
+#define GRAPH_STREAM_STORE(ptr, val) (*(ptr) = (val))
+#endif
+#ifndef GRAPH_STREAM_ADD
+#define GRAPH_STREAM_ADD(ptr, val) (*(ptr) += (val))
+#endif
+
+/*  kinds of update  */
+#define STREAM_INSERT 1
+#define STREAM_DELETE 2
+
+/*  workspace size for n nodes, snapshots of up to @entries edges and epochs
+ *  of up to @batch updates  */
+#define STREAM_INT_WORDS(n, entries, batch) \
+    (3 * ((n) + 1) + 2 * (entries) + 4 * (batch))
+
+typedef struct StreamLogTag StreamLog;
+typedef struct GraphStreamTag GraphStream;
+
+static int graph_stream_log_add(StreamLog *log, int from_id, int to_id,
+                                char op);
+static void graph_stream_sort(GraphStream *stream, const int *key,
+                              const int *from, const int *to, const char *op,
+                              int *out_from, int *out_to, char *out_op,
+                              int count);
+
+/*
+ * A log of edge updates from one producer.
+ *
+ * @from: Node each update's edge starts at.
+ * @to: Node each update's edge ends at.
+ * @op: STREAM_INSERT or STREAM_DELETE for each update.
+ * @count: Number of updates in the log.
+ * @capacity: The most updates the log can hold.
+ */
+struct StreamLogTag
+{
+    int *from;
+    int *to;
+    char *op;
+    int count;
+    int capacity;
+};
+
+/*
+ * A graph taking batched updates, published as versioned snapshots.
+ *
+ * @num_nodes: Number of nodes.
+ * @entry_capacity: The most edges one snapshot can hold.
+ * @batch_capacity: The most updates one epoch can apply.
+ * @snapshots: The published and the spare snapshot.
+ * @versions: Version of each snapshot. Grows by one per epoch.
+ * @readers: Number of readers holding each snapshot.
+ * @current: Index of the published snapshot.
+ * @batch_from, @batch_to, @batch_op: The epoch's updates, sorted.
+ * @sort_from, @sort_to, @sort_op: Updates after the first sorting pass.
+ * @counts: Counting-sort buckets, one per node plus one.
+ */
+struct GraphStreamTag
+{
+    int num_nodes;
+    int entry_capacity;
+    int batch_capacity;
+    CsrGraph snapshots[2];
+    long versions[2];
+    long readers[2];
+    int current;
+    int *batch_from;
+    int *batch_to;
+    char *batch_op;
+    int *sort_from;
+    int *sort_to;
+    char *sort_op;
+    int *counts;
+};
+
+/*
+ * Initialize an update log.
+ *
+ * @from: Array of @capacity ints.
+ * @to: Array of @capacity ints.
+ * @op: Array of @capacity chars.
+ * @capacity: The most updates the log can hold.
+ */
+static void graph_stream_log_init(StreamLog *log, int *from, int *to,
+                                  char *op, int capacity)
+{
+    log->from = from;
+    log->to = to;
+    log->op = op;
+    log->count = 0;
+    log->capacity = capacity;
+}
+
+/*
+ * Log an edge insert.
+ *
+ * @return: 0 if the update was logged, 1 if the log is full.
+ */
+static int graph_stream_log_insert(StreamLog *log, int from_id, int to_id)
+{
+    return graph_stream_log_add(log, from_id, to_id, STREAM_INSERT);
+}
+
+/*
+ * Log an edge delete.
+ *
+ * @return: 0 if the update was logged, 1 if the log is full.
+ */
+static int graph_stream_log_delete(StreamLog *log, int from_id, int to_id)
+{
+    return graph_stream_log_add(log, from_id, to_id, STREAM_DELETE);
+}
+
+/*
+ * Initialize a stream with an empty graph as version 0.
+ *
+ * @num_nodes: Number of nodes.
+ * @entry_capacity: The most edges one snapshot can hold.
+ * @batch_capacity: The most updates one epoch can apply.
+ * @int_buf: Array of STREAM_INT_WORDS(@num_nodes, @entry_capacity,
+ *   @batch_capacity) ints.
+ * @char_buf: Array of 2 * @batch_capacity chars.
+ */
+static void graph_stream_init(GraphStream *stream, int num_nodes,
+                              int entry_capacity, int batch_capacity,
+                              int *int_buf, char *char_buf)
+{
+    int slot;
+    int node_id;
+
+    stream->num_nodes = num_nodes;
+    stream->entry_capacity = entry_capacity;
+    stream->batch_capacity = batch_capacity;
+    for (slot = 0; slot < 2; slot++)
+    {
+        stream->snapshots[slot].num_nodes = num_nodes;
+        stream->snapshots[slot].num_entries = 0;
+        stream->snapshots[slot].offsets = int_buf;
+        stream->snapshots[slot].adj = int_buf + num_nodes + 1;
+        stream->snapshots[slot].weights = 0;
+        stream->versions[slot] = 0;
+        stream->readers[slot] = 0;
+        int_buf += num_nodes + 1 + entry_capacity;
+
+        for (node_id = 0; node_id <= num_nodes; node_id++)
+        {
+            stream->snapshots[slot].offsets[node_id] = 0;
+        }
+    }
+    stream->current = 0;
+
+    stream->batch_from = int_buf;
+    stream->batch_to = int_buf + batch_capacity;
+    stream->sort_from = int_buf + 2 * batch_capacity;
+    stream->sort_to = int_buf + 3 * batch_capacity;
+    stream->counts = int_buf + 4 * batch_capacity;
+    stream->batch_op = char_buf;
+    stream->sort_op = char_buf + batch_capacity;
+}
+
+/*
+ * Replace the published snapshot with the edges of a graph.
+ * CAUTION: Only call this while no reader holds a snapshot.
+ *
+ * @graph: Graph of at most num_nodes nodes. Nodes past its size are left
+ *   without edges.
+ * @return: 0 if loaded, 1 if the graph has more nodes or more edges than a
+ *   snapshot holds.
+ */
+static int graph_stream_load(GraphStream *stream, Graph *graph)
+{
+    CsrGraph *csr;
+    int node_id;
+
+    if (graph->size > stream->num_nodes ||
+        graph_csr_count(graph, 0) > stream->entry_capacity)
+    {
+        return 1;
+    }
+
+    csr = &stream->snapshots[stream->current];
+    graph_csr_build(graph, csr, csr->offsets, csr->adj, 0);
+    for (node_id = graph->size + 1; node_id <= stream->num_nodes; node_id++)
+    {
+        csr->offsets[node_id] = csr->num_entries;
+    }
+    csr->num_nodes = stream->num_nodes;
+    stream->versions[stream->current]++;
+    return 0;
+}
+
+/*
+ * Apply the updates of a closed epoch and publish the result.
+ * On success the logs are emptied. Otherwise nothing changes and the call can
+ * be retried with the same logs.
+ *
+ * @logs: The epoch's logs. No producer may append to them during the call.
+ * @num_logs: Number of logs.
+ * @return:
+ *   0 if a new version was published.
+ *   1 if readers still hold the spare snapshot.
+ *   2 if the logs hold more than batch_capacity updates.
+ *   3 if the result would have more edges than a snapshot holds.
+ */
+static int graph_stream_apply(GraphStream *stream, StreamLog *logs,
+                              int num_logs)
+{
+    int spare;
+    int count;
+    int log_idx;
+    int idx;
+    int node_id;
+    int read;
+    int write;
+    int row_end;
+    int to_id;
+    const CsrGraph *old_csr;
+    CsrGraph *new_csr;
+
+    spare = 1 - stream->current;
+    if (GRAPH_STREAM_LOAD(&stream->readers[spare]) != 0)
+    {
+        return 1;
+    }
+
+    /*  gather the logs in order, then sort by to, then stably by from  */
+    count = 0;
+    for (log_idx = 0; log_idx < num_logs; log_idx++)
+    {
+        if (count + logs[log_idx].count > stream->batch_capacity)
+        {
+            return 2;
+        }
+        for (idx = 0; idx < logs[log_idx].count; idx++)
+        {
+            stream->batch_from[count] = logs[log_idx].from[idx];
+            stream->batch_to[count] = logs[log_idx].to[idx];
+            stream->batch_op[count] = logs[log_idx].op[idx];
+            count++;
+        }
+    }
+    graph_stream_sort(stream, stream->batch_to, stream->batch_from,
+                      stream->batch_to, stream->batch_op, stream->sort_from,
+                      stream->sort_to, stream->sort_op, count);
+    graph_stream_sort(stream, stream->sort_from, stream->sort_from,
+                      stream->sort_to, stream->sort_op, stream->batch_from,
+                      stream->batch_to, stream->batch_op, count);
+
+    /*  merge each old row with its run of updates  */
+    old_csr = &stream->snapshots[stream->current];
+    new_csr = &stream->snapshots[spare];
+    write = 0;
+    idx = 0;
+    for (node_id = 0; node_id < stream->num_nodes; node_id++)
+    {
+        new_csr->offsets[node_id] = write;
+        read = old_csr->offsets[node_id];
+        row_end = old_csr->offsets[node_id + 1];
+        while (read < row_end ||
+               (idx < count && stream->batch_from[idx] == node_id))
+        {
+            if (idx < count && stream->batch_from[idx] == node_id &&
+                (read == row_end || stream->batch_to[idx] <= old_csr->adj[read]))
+            {
+                /*  the last update to an edge decides it  */
+                to_id = stream->batch_to[idx];
+                while (idx + 1 < count &&
+                       stream->batch_from[idx + 1] == node_id &&
+                       stream->batch_to[idx + 1] == to_id)
+                {
+                    idx++;
+                }
+                if (read < row_end && old_csr->adj[read] == to_id)
+                {
+                    read++;
+                }
+                if (stream->batch_op[idx++] != STREAM_INSERT)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                to_id = old_csr->adj[read++];
+            }
+
+            if (write == stream->entry_capacity)
+            {
+                return 3;
+            }
+            new_csr->adj[write++] = to_id;
+        }
+    }
+    new_csr->offsets[stream->num_nodes] = write;
+    new_csr->num_entries = write;
+    stream->versions[spare] = stream->versions[stream->current] + 1;
+
+    GRAPH_STREAM_STORE(&stream->current, spare);
+    for (log_idx = 0; log_idx < num_logs; log_idx++)
+    {
+        logs[log_idx].count = 0;
+    }
+    return 0;
+}
+
+/*
+ * Acquire the published snapshot for reading. It stays valid and unchanged
+ * until released, no matter how many epochs are applied meanwhile.
+ *
+ * @slot: Receives the index to pass to 'graph_stream_release'.
+ * @return: The snapshot.
+ */
+static const CsrGraph *graph_stream_acquire(GraphStream *stream, int *slot)
+{
+    int current;
+
+    while (1)
+    {
+        current = GRAPH_STREAM_LOAD(&stream->current);
+        GRAPH_STREAM_ADD(&stream->readers[current], 1);
+        /*  if the writer published in between, it may be rebuilding this one  */
+        if (GRAPH_STREAM_LOAD(&stream->current) == current)
+        {
+            break;
+        }
+        GRAPH_STREAM_ADD(&stream->readers[current], -1);
+    }
+
+    *slot = current;
+    return &stream->snapshots[current];
+}
+
+/*
+ * Release a snapshot acquired with 'graph_stream_acquire'.
+ *
+ * @slot: The index received from 'graph_stream_acquire'.
+ */
+static void graph_stream_release(GraphStream *stream, int slot)
+{
+    GRAPH_STREAM_ADD(&stream->readers[slot], -1);
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Append an update to a log.
+ *
+ * @op: STREAM_INSERT or STREAM_DELETE.
+ * @return: 0 if the update was logged, 1 if the log is full.
+ */
+static int graph_stream_log_add(StreamLog *log, int from_id, int to_id,
+                                char op)
+{
+    if (log->count == log->capacity)
+    {
+        return 1;
+    }
+    log->from[log->count] = from_id;
+    log->to[log->count] = to_id;
+    log->op[log->count] = op;
+    log->count++;
+    return 0;
+}
+
+/*
+ * Stably counting-sort updates by a node id key.
+ *
+ * @key: The key of each update, one of @from or @to.
+ * @from, @to, @op: The updates to sort.
+ * @out_from, @out_to, @out_op: Receive the sorted updates.
+ * @count: Number of updates.
+ */
+static void graph_stream_sort(GraphStream *stream, const int *key,
+                              const int *from, const int *to, const char *op,
+                              int *out_from, int *out_to, char *out_op,
+                              int count)
+{
+    int node_id;
+    int idx;
+    int pos;
+    int *counts;
+
+    counts = stream->counts;
+    for (node_id = 0; node_id <= stream->num_nodes; node_id++)
+    {
+        counts[node_id] = 0;
+    }
+    for (idx = 0; idx < count; idx++)
+    {
+        counts[key[idx] + 1]++;
+    }
+    for (node_id = 1; node_id <= stream->num_nodes; node_id++)
+    {
+        counts[node_id] += counts[node_id - 1];
+    }
+    for (idx = 0; idx < count; idx++)
+    {
+        pos = counts[key[idx]]++;
+        out_from[pos] = from[idx];
+        out_to[pos] = to[idx];
+        out_op[pos] = op[idx];
+    }
+}
+
+
+#endif
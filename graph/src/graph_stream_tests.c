@@ -0,0 +1,286 @@
+/*
+ * Unit tests for the streaming update header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_stream.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 20
+#define MAX_ENTRIES 400
+#define MAX_BATCH 64
+#define NUM_LOGS 3
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static GraphStream stream;
+static int int_buf[STREAM_INT_WORDS(INIT_SIZE, MAX_ENTRIES, MAX_BATCH)];
+static char char_buf[2 * MAX_BATCH];
+static StreamLog logs[NUM_LOGS];
+static int log_from[NUM_LOGS][MAX_BATCH];
+static int log_to[NUM_LOGS][MAX_BATCH];
+static char log_op[NUM_LOGS][MAX_BATCH];
+
+static void init_stream(int log_capacity);
+static int snapshot_has(const CsrGraph *csr, int from_id, int to_id);
+
+
+void test_log_fills()
+{
+    int idx;
+
+    init_stream(4);
+    for (idx = 0; idx < 4; idx++)
+    {
+        TEST_ASSERT_EQUAL(0, graph_stream_log_insert(&logs[0], idx, idx));
+    }
+    TEST_ASSERT_EQUAL(1, graph_stream_log_delete(&logs[0], 0, 0));
+    TEST_ASSERT_EQUAL(4, logs[0].count);
+}
+
+void test_last_update_wins()
+{
+    const CsrGraph *csr;
+    int slot;
+
+    init_stream(MAX_BATCH);
+    graph_stream_log_insert(&logs[0], 3, 7);
+    graph_stream_log_insert(&logs[0], 3, 2);
+    graph_stream_log_delete(&logs[0], 3, 7);
+    graph_stream_log_delete(&logs[1], 5, 1);
+    graph_stream_log_insert(&logs[1], 5, 1);
+    graph_stream_log_insert(&logs[2], 3, 2);
+
+    TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, NUM_LOGS));
+    TEST_ASSERT_EQUAL(0, logs[0].count);
+
+    csr = graph_stream_acquire(&stream, &slot);
+    TEST_ASSERT_EQUAL(1, stream.versions[slot]);
+    TEST_ASSERT_EQUAL(2, csr->num_entries);
+    TEST_ASSERT_TRUE(snapshot_has(csr, 3, 2));
+    TEST_ASSERT_TRUE(snapshot_has(csr, 5, 1));
+    TEST_ASSERT_FALSE(snapshot_has(csr, 3, 7));
+    graph_stream_release(&stream, slot);
+}
+
+void test_load_then_update()
+{
+    const CsrGraph *csr;
+    int slot;
+    int idx;
+
+    init_stream(MAX_BATCH);
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+    }
+    TEST_ASSERT_EQUAL(0, graph_stream_load(&stream, &graph));
+
+    graph_stream_log_delete(&logs[0], 4, 5);
+    graph_stream_log_insert(&logs[0], 4, 0);
+    graph_stream_log_insert(&logs[1], 4, 9);
+    graph_stream_log_insert(&logs[1], 0, 1);
+    TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, 2));
+
+    csr = graph_stream_acquire(&stream, &slot);
+    TEST_ASSERT_EQUAL(INIT_SIZE + 1, csr->num_entries);
+    TEST_ASSERT_EQUAL(2, graph_csr_degree(csr, 4));
+    TEST_ASSERT_EQUAL(0, csr->adj[csr->offsets[4]]);
+    TEST_ASSERT_EQUAL(9, csr->adj[csr->offsets[4] + 1]);
+    TEST_ASSERT_EQUAL(1, graph_csr_degree(csr, 0));
+    graph_stream_release(&stream, slot);
+}
+
+void test_load_smaller_graph()
+{
+    Graph small;
+    Node small_nodes[4];
+    const CsrGraph *csr;
+    int slot;
+    int node_id;
+
+    /* Fill the rows past the small graph first. */
+    init_stream(MAX_BATCH);
+    graph_stream_log_insert(&logs[0], 6, 7);
+    graph_stream_log_insert(&logs[0], 7, 6);
+    graph_stream_log_insert(&logs[0], 5, 7);
+    TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, 1));
+
+    graph_init(&small, small_nodes, 4);
+    graph_add_bucket(&small, 0, malloc(sizeof(Bucket)));
+    graph_add_edge(&small, 0, 1);
+    TEST_ASSERT_EQUAL(0, graph_stream_load(&stream, &small));
+
+    /* Nodes past the small graph have no edges left. */
+    csr = graph_stream_acquire(&stream, &slot);
+    TEST_ASSERT_EQUAL(1, csr->num_entries);
+    for (node_id = 1; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_EQUAL(0, graph_csr_degree(csr, node_id));
+        TEST_ASSERT_EQUAL(1, csr->offsets[node_id + 1]);
+    }
+    graph_stream_release(&stream, slot);
+
+    /* The next merge reads those rows. */
+    graph_stream_log_insert(&logs[0], 10, 11);
+    TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, 1));
+    csr = graph_stream_acquire(&stream, &slot);
+    TEST_ASSERT_EQUAL(2, csr->num_entries);
+    TEST_ASSERT_EQUAL(1, snapshot_has(csr, 0, 1));
+    TEST_ASSERT_EQUAL(1, snapshot_has(csr, 10, 11));
+    TEST_ASSERT_EQUAL(0, snapshot_has(csr, 6, 7));
+    graph_stream_release(&stream, slot);
+}
+
+void test_reader_keeps_its_version()
+{
+    const CsrGraph *old_csr;
+    const CsrGraph *csr;
+    int old_slot;
+    int slot;
+
+    init_stream(MAX_BATCH);
+    graph_stream_log_insert(&logs[0], 1, 2);
+    graph_stream_apply(&stream, logs, 1);
+    old_csr = graph_stream_acquire(&stream, &old_slot);
+
+    /* The next epoch goes to the other snapshot. */
+    graph_stream_log_delete(&logs[0], 1, 2);
+    graph_stream_log_insert(&logs[0], 2, 3);
+    TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, 1));
+    TEST_ASSERT_TRUE(snapshot_has(old_csr, 1, 2));
+    TEST_ASSERT_FALSE(snapshot_has(old_csr, 2, 3));
+
+    /* The one after would overwrite the held snapshot, so it waits. */
+    graph_stream_log_insert(&logs[0], 3, 4);
+    TEST_ASSERT_EQUAL(1, graph_stream_apply(&stream, logs, 1));
+    TEST_ASSERT_EQUAL(1, logs[0].count);
+    TEST_ASSERT_TRUE(snapshot_has(old_csr, 1, 2));
+
+    graph_stream_release(&stream, old_slot);
+    TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, 1));
+    csr = graph_stream_acquire(&stream, &slot);
+    TEST_ASSERT_EQUAL(3, stream.versions[slot]);
+    TEST_ASSERT_FALSE(snapshot_has(csr, 1, 2));
+    TEST_ASSERT_TRUE(snapshot_has(csr, 2, 3));
+    TEST_ASSERT_TRUE(snapshot_has(csr, 3, 4));
+    graph_stream_release(&stream, slot);
+}
+
+void test_random_epochs_match_reference()
+{
+    char present[INIT_SIZE][INIT_SIZE];
+    const CsrGraph *csr;
+    int slot;
+    int epoch;
+    int idx;
+    int from_id, to_id;
+    int count;
+
+    init_stream(MAX_BATCH / NUM_LOGS);
+    for (from_id = 0; from_id < INIT_SIZE; from_id++)
+    {
+        for (to_id = 0; to_id < INIT_SIZE; to_id++)
+        {
+            present[from_id][to_id] = 0;
+        }
+    }
+
+    /* Logs are replayed in log order, so the reference does the same. */
+    srand(30);
+    for (epoch = 0; epoch < 50; epoch++)
+    {
+        for (idx = 0; idx < NUM_LOGS; idx++)
+        {
+            while (logs[idx].count < logs[idx].capacity)
+            {
+                from_id = rand() % INIT_SIZE;
+                to_id = rand() % INIT_SIZE;
+                if (rand() % 3 == 0)
+                {
+                    graph_stream_log_delete(&logs[idx], from_id, to_id);
+                }
+                else
+                {
+                    graph_stream_log_insert(&logs[idx], from_id, to_id);
+                }
+            }
+        }
+        for (idx = 0; idx < NUM_LOGS; idx++)
+        {
+            for (count = 0; count < logs[idx].count; count++)
+            {
+                present[logs[idx].from[count]][logs[idx].to[count]] =
+                    (logs[idx].op[count] == STREAM_INSERT);
+            }
+        }
+        TEST_ASSERT_EQUAL(0, graph_stream_apply(&stream, logs, NUM_LOGS));
+
+        csr = graph_stream_acquire(&stream, &slot);
+        count = 0;
+        for (from_id = 0; from_id < INIT_SIZE; from_id++)
+        {
+            for (to_id = 0; to_id < INIT_SIZE; to_id++)
+            {
+                TEST_ASSERT_EQUAL(present[from_id][to_id],
+                                  snapshot_has(csr, from_id, to_id));
+                count += present[from_id][to_id];
+            }
+        }
+        TEST_ASSERT_EQUAL(count, csr->num_entries);
+        graph_stream_release(&stream, slot);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  fill a log, verify it refuses more updates  */
+    RUN_TEST(test_log_fills);
+    /*  apply conflicting updates, verify the last one decides  */
+    RUN_TEST(test_last_update_wins);
+    /*  load a graph and update it, verify the merged rows  */
+    RUN_TEST(test_load_then_update);
+    /*  load a smaller graph after an update, verify the rows past it  */
+    RUN_TEST(test_load_smaller_graph);
+    /*  hold a snapshot across epochs, verify it never changes  */
+    RUN_TEST(test_reader_keeps_its_version);
+    /*  apply random epochs, verify against a reference matrix  */
+    RUN_TEST(test_random_epochs_match_reference);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize the stream and its logs.
+ *
+ * @log_capacity: Capacity of each log.
+ */
+static void init_stream(int log_capacity)
+{
+    int idx;
+
+    graph_stream_init(&stream, INIT_SIZE, MAX_ENTRIES, MAX_BATCH, int_buf,
+                      char_buf);
+    for (idx = 0; idx < NUM_LOGS; idx++)
+    {
+        graph_stream_log_init(&logs[idx], log_from[idx], log_to[idx],
+                              log_op[idx], log_capacity);
+    }
+}
+
+/*
+ * Determine if a snapshot has an edge.
+ */
+static int snapshot_has(const CsrGraph *csr, int from_id, int to_id)
+{
+    return graph_csr_find(csr, from_id, to_id) != -1;
+}
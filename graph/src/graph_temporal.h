@@ -0,0 +1,395 @@
+/*
+ * Temporal graphs: timestamped edges kept in time order, with time-window
+ * lookups, expiry and earliest-arrival searches.
+ * See Holme and Saramaki, "Temporal Networks" (2012) and Wu et al, "Path
+ * Problems in Temporal Graphs" (2014) for the theory.
+ *
+ * Each edge of a temporal graph is an event: u reached v at time t. The bucket
+ * chains of graph.h have no room for times, and filtering a whole adjacency
+ * for every window query reads edges the query never wanted. Here every node
+ * keeps a log of its out-edges sorted by time, as a ring buffer:
+ *   - Edges mostly arrive in time order, so adding one is appending it. A late
+ *     edge is moved back past the ones after it.
+ *   - The edges of a node in a window of time are a contiguous run of its log,
+ *     found with two binary searches in O(log d).
+ *   - Expiring edges older than a horizon is advancing the head of each ring
+ *     past them, one binary search per node, without touching the edges.
+ *
+ * A time-respecting path crosses its edges in time order. The earliest a node
+ * can be reached from a source is not found by a breadth first search, since
+ * a path of more hops may arrive sooner. The search here relaxes a node's
+ * edges that leave no earlier than the node is reached, and when a node is
+ * reached earlier than before it only relaxes the edges between the new and
+ * the old arrival: the later ones were relaxed already and lead to the same
+ * arrivals. Every edge of the window is relaxed at most once.
+ *
+ * === How to Use ===
+ * This header does no memory management. Pick the most edges each node's log
+ * may hold, fill an array of n + 1 ints with their running sums as row
+ * offsets, like a CSR snapshot's, and allocate TEMPORAL_INT_WORDS(n, entries)
+ * ints and @entries longs, where @entries is the last offset. Call
+ * 'graph_temporal_init', then:
+ *   - 'graph_temporal_add_edge' to log an edge. A full log returns 1; expire
+ *     old edges, or rebuild with room to spare.
+ *   - 'graph_temporal_window' to find the edges of a node in a window of
+ *     time, then 'graph_temporal_target' and 'graph_temporal_time' to read
+ *     them by position.
+ *   - 'graph_temporal_expire' to drop every edge older than a horizon.
+ *   - 'graph_temporal_earliest' for earliest arrival times from a source.
+ * Searches only read the graph, so any number can run at once with their own
+ * buffers, as long as nothing is added or expired meanwhile.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_TEMPORAL_H
+#define GRAPH_TEMPORAL_H
+
+/*  ints of storage for n nodes and logs of @entries edges in all  */
+#define TEMPORAL_INT_WORDS(n, entries) (2 * (n) + (entries))
+
+/*  ints of space an earliest-arrival search over n nodes needs  */
+#define TEMPORAL_SEARCH_INT_WORDS(n) (3 * (n))
+
+/*  arrival time of a node that can't be reached  */
+#define TEMPORAL_NEVER ((long)(~0UL >> 1))
+
+typedef struct TemporalGraphTag TemporalGraph;
+
+static int graph_temporal_slot(const TemporalGraph *tg, int node_id, int pos);
+static int graph_temporal_lower_bound(const TemporalGraph *tg, int node_id,
+                                      long time);
+
+/*
+ * A graph of timestamped edges.
+ * The log of node u holds up to offsets[u + 1] - offsets[u] edges, stored in
+ * targets and times from offsets[u] on as a ring starting at heads[u].
+ *
+ * @num_nodes: Number of nodes.
+ * @num_edges: Number of edges in all logs.
+ * @horizon: Edges older than this were expired, and can't be added.
+ * @offsets: Start of each node's log. Has num_nodes + 1 entries.
+ * @heads: Slot of the oldest edge of each node's log, relative to its start.
+ * @counts: Number of edges in each node's log.
+ * @targets: Node each edge ends at.
+ * @times: Time of each edge.
+ */
+struct TemporalGraphTag
+{
+    int num_nodes;
+    long num_edges;
+    long horizon;
+    const int *offsets;
+    int *heads;
+    int *counts;
+    int *targets;
+    long *times;
+};
+
+
+/*
+ * Initialize an empty temporal graph.
+ *
+ * @num_nodes: Number of nodes.
+ * @offsets: Array of @num_nodes + 1 ints, ascending from 0. Node u's log holds
+ *   up to offsets[u + 1] - offsets[u] edges. Read, not copied.
+ * @int_buf: Array of TEMPORAL_INT_WORDS(@num_nodes, offsets[num_nodes]) ints.
+ * @long_buf: Array of offsets[num_nodes] longs.
+ */
+static void graph_temporal_init(TemporalGraph *tg, int num_nodes,
+                                const int *offsets, int *int_buf,
+                                long *long_buf)
+{
+    int node_id;
+
+    tg->num_nodes = num_nodes;
+    tg->num_edges = 0;
+    tg->horizon = -TEMPORAL_NEVER;
+    tg->offsets = offsets;
+    tg->heads = int_buf;
+    tg->counts = int_buf + num_nodes;
+    tg->targets = int_buf + 2 * num_nodes;
+    tg->times = long_buf;
+    for (node_id = 0; node_id < num_nodes; node_id++)
+    {
+        tg->heads[node_id] = 0;
+        tg->counts[node_id] = 0;
+    }
+}
+
+/*
+ * Log an edge.
+ * O(1) if no edge of its start node is later, else O(number that are).
+ *
+ * @from_id: Node the edge starts at. Assumed to be valid.
+ * @to_id: Node the edge ends at. Assumed to be valid.
+ * @time: Time of the edge. Edges at the same time keep the order they were
+ *   added in.
+ * @return: 0 if the edge was logged, 1 if its start node's log is full, 2 if
+ *   it is older than the horizon.
+ */
+static int graph_temporal_add_edge(TemporalGraph *tg, int from_id, int to_id,
+                                   long time)
+{
+    int pos;
+    int slot;
+    int prev;
+
+    if (time < tg->horizon)
+    {
+        return 2;
+    }
+    if (tg->counts[from_id] ==
+        tg->offsets[from_id + 1] - tg->offsets[from_id])
+    {
+        return 1;
+    }
+
+    /*  shift later edges up one slot, then drop the edge in the gap  */
+    pos = tg->counts[from_id];
+    slot = graph_temporal_slot(tg, from_id, pos);
+    while (pos > 0)
+    {
+        prev = graph_temporal_slot(tg, from_id, pos - 1);
+        if (tg->times[prev] <= time)
+        {
+            break;
+        }
+        tg->targets[slot] = tg->targets[prev];
+        tg->times[slot] = tg->times[prev];
+        slot = prev;
+        pos--;
+    }
+    tg->targets[slot] = to_id;
+    tg->times[slot] = time;
+    tg->counts[from_id]++;
+    tg->num_edges++;
+
+    return 0;
+}
+
+/*
+ * Drop every edge older than a horizon, and refuse them from then on.
+ * O(n log d), the dropped edges aren't read.
+ *
+ * @horizon: Time of the oldest edges to keep. A horizon earlier than the
+ *   current one does nothing.
+ * @return: The number of edges dropped.
+ */
+static long graph_temporal_expire(TemporalGraph *tg, long horizon)
+{
+    int node_id;
+    int cap;
+    int drop;
+    long dropped;
+
+    if (horizon <= tg->horizon)
+    {
+        return 0;
+    }
+
+    dropped = 0;
+    for (node_id = 0; node_id < tg->num_nodes; node_id++)
+    {
+        drop = graph_temporal_lower_bound(tg, node_id, horizon);
+        if (drop == 0)
+        {
+            continue;
+        }
+        cap = tg->offsets[node_id + 1] - tg->offsets[node_id];
+        tg->heads[node_id] = (tg->heads[node_id] + drop) % cap;
+        tg->counts[node_id] -= drop;
+        dropped += drop;
+    }
+    tg->num_edges -= dropped;
+    tg->horizon = horizon;
+
+    return dropped;
+}
+
+/*
+ * Find the edges of a node in a window of time. O(log d).
+ *
+ * @node_id: Id of the node. Assumed to be valid.
+ * @from_time: Start of the window, inclusive.
+ * @to_time: End of the window, exclusive.
+ * @first: Receives the position of the first edge in the window.
+ * @return: The number of edges in the window. They are at positions @first
+ *   on, oldest first.
+ */
+static int graph_temporal_window(const TemporalGraph *tg, int node_id,
+                                 long from_time, long to_time, int *first)
+{
+    int last;
+
+    *first = graph_temporal_lower_bound(tg, node_id, from_time);
+    last = graph_temporal_lower_bound(tg, node_id, to_time);
+    return (last > *first ? last - *first : 0);
+}
+
+/*
+ * Get the node an edge ends at.
+ *
+ * @pos: Position of the edge in its start node's log, 0 for the oldest.
+ */
+static int graph_temporal_target(const TemporalGraph *tg, int node_id,
+                                 int pos)
+{
+    return tg->targets[graph_temporal_slot(tg, node_id, pos)];
+}
+
+/*
+ * Get the time of an edge.
+ *
+ * @pos: Position of the edge in its start node's log, 0 for the oldest.
+ */
+static long graph_temporal_time(const TemporalGraph *tg, int node_id, int pos)
+{
+    return tg->times[graph_temporal_slot(tg, node_id, pos)];
+}
+
+/*
+ * Find the earliest time each node can be reached from a source by a
+ * time-respecting path inside a window of time.
+ *
+ * @source: Id of the node to start from. Assumed to be valid.
+ * @from_time: Time the search leaves the source. Edges before it are ignored.
+ * @to_time: Edges at this time or later are ignored.
+ * @duration: Time it takes to cross an edge. With 0, a path may cross edges
+ *   at the same time one after another; with 1 and whole times, each edge must
+ *   be later than the last.
+ * @arrival: Array of num_nodes longs. Receives the earliest arrival at each
+ *   node, @from_time for the source and TEMPORAL_NEVER for nodes not reached.
+ * @int_buf: Array of TEMPORAL_SEARCH_INT_WORDS(num_nodes) ints.
+ * @return: The number of nodes reached, the source included.
+ */
+static int graph_temporal_earliest(const TemporalGraph *tg, int source,
+                                   long from_time, long to_time,
+                                   long duration, long *arrival,
+                                   int *int_buf)
+{
+    int *done;
+    int *queue;
+    int *queued;
+    int head;
+    int size;
+    int node_id;
+    int to_id;
+    int pos;
+    int lo;
+    int num_reached;
+    long reach;
+
+    /*  @done is the first position of each log already relaxed, -1 for
+     *  nodes not reached; the queue is a ring holding each node at most
+     *  once  */
+    done = int_buf;
+    queue = int_buf + tg->num_nodes;
+    queued = int_buf + 2 * tg->num_nodes;
+    for (node_id = 0; node_id < tg->num_nodes; node_id++)
+    {
+        arrival[node_id] = TEMPORAL_NEVER;
+        done[node_id] = -1;
+        queued[node_id] = 0;
+    }
+
+    arrival[source] = from_time;
+    done[source] = graph_temporal_lower_bound(tg, source, to_time);
+    queue[0] = source;
+    queued[source] = 1;
+    head = 0;
+    size = 1;
+    num_reached = 1;
+    while (size > 0)
+    {
+        node_id = queue[head];
+        head = (head + 1) % tg->num_nodes;
+        size--;
+        queued[node_id] = 0;
+
+        /*  relax only the edges leaving between this and the last arrival  */
+        lo = graph_temporal_lower_bound(tg, node_id, arrival[node_id]);
+        for (pos = lo; pos < done[node_id]; pos++)
+        {
+            to_id = graph_temporal_target(tg, node_id, pos);
+            reach = graph_temporal_time(tg, node_id, pos) + duration;
+            if (reach >= arrival[to_id])
+            {
+                continue;
+            }
+
+            if (done[to_id] < 0)
+            {
+                done[to_id] = graph_temporal_lower_bound(tg, to_id, to_time);
+                num_reached++;
+            }
+            arrival[to_id] = reach;
+            if (!queued[to_id])
+            {
+                queue[(head + size) % tg->num_nodes] = to_id;
+                queued[to_id] = 1;
+                size++;
+            }
+        }
+        if (lo < done[node_id])
+        {
+            done[node_id] = lo;
+        }
+    }
+
+    return num_reached;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the index in targets and times of a position of a node's log.
+ */
+static int graph_temporal_slot(const TemporalGraph *tg, int node_id, int pos)
+{
+    int cap;
+    int slot;
+
+    cap = tg->offsets[node_id + 1] - tg->offsets[node_id];
+    slot = tg->heads[node_id] + pos;
+    if (slot >= cap)
+    {
+        slot -= cap;
+    }
+    return tg->offsets[node_id] + slot;
+}
+
+/*
+ * Find the position of the first edge of a node's log at or after a time.
+ *
+ * @return: The position, or the number of edges of the log if all are
+ *   earlier.
+ */
+static int graph_temporal_lower_bound(const TemporalGraph *tg, int node_id,
+                                      long time)
+{
+    int lo;
+    int hi;
+    int mid;
+
+    lo = 0;
+    hi = tg->counts[node_id];
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (tg->times[graph_temporal_slot(tg, node_id, mid)] < time)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+
+#endif
@@ -0,0 +1,238 @@
+/*
+ * Unit tests for the temporal graph header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_temporal.h"
+#include "graph_rng.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 8
+#define LOG_SIZE 4
+#define RANDOM_SIZE 30
+#define RANDOM_LOG 40
+#define RANDOM_EDGES 600
+
+static TemporalGraph tg;
+static int offsets[RANDOM_SIZE + 1];
+static int int_buf[TEMPORAL_INT_WORDS(RANDOM_SIZE, RANDOM_SIZE * RANDOM_LOG)];
+static long long_buf[RANDOM_SIZE * RANDOM_LOG];
+static int search_buf[TEMPORAL_SEARCH_INT_WORDS(RANDOM_SIZE)];
+
+static void init_graph(int size, int log_size);
+static void naive_earliest(const int *from, const int *to, const long *times,
+                           int count, int source, long from_time,
+                           long to_time, long duration, long *arrival,
+                           int size);
+
+
+void test_add_keeps_time_order()
+{
+    int pos;
+
+    init_graph(INIT_SIZE, LOG_SIZE);
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 0, 1, 10));
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 0, 2, 30));
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 0, 3, 20));
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 0, 4, 20));
+    TEST_ASSERT_EQUAL(1, graph_temporal_add_edge(&tg, 0, 5, 40));
+    TEST_ASSERT_EQUAL(4, tg.num_edges);
+
+    /* The late edges moved back, in the order they were added. */
+    TEST_ASSERT_EQUAL(1, graph_temporal_target(&tg, 0, 0));
+    TEST_ASSERT_EQUAL(3, graph_temporal_target(&tg, 0, 1));
+    TEST_ASSERT_EQUAL(4, graph_temporal_target(&tg, 0, 2));
+    TEST_ASSERT_EQUAL(2, graph_temporal_target(&tg, 0, 3));
+    for (pos = 1; pos < 4; pos++)
+    {
+        TEST_ASSERT_TRUE(graph_temporal_time(&tg, 0, pos - 1) <=
+                         graph_temporal_time(&tg, 0, pos));
+    }
+}
+
+void test_window_lookup()
+{
+    int first;
+    int count;
+
+    init_graph(INIT_SIZE, LOG_SIZE);
+    graph_temporal_add_edge(&tg, 2, 1, 5);
+    graph_temporal_add_edge(&tg, 2, 3, 10);
+    graph_temporal_add_edge(&tg, 2, 4, 10);
+    graph_temporal_add_edge(&tg, 2, 5, 15);
+
+    /* The start of a window is inclusive, its end exclusive. */
+    count = graph_temporal_window(&tg, 2, 10, 15, &first);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL(1, first);
+    TEST_ASSERT_EQUAL(3, graph_temporal_target(&tg, 2, first));
+
+    TEST_ASSERT_EQUAL(4, graph_temporal_window(&tg, 2, 0, 100, &first));
+    TEST_ASSERT_EQUAL(0, graph_temporal_window(&tg, 2, 16, 100, &first));
+    TEST_ASSERT_EQUAL(0, graph_temporal_window(&tg, 2, 12, 8, &first));
+    TEST_ASSERT_EQUAL(0, graph_temporal_window(&tg, 6, 0, 100, &first));
+}
+
+void test_expire_and_wrap()
+{
+    int first;
+    int time;
+
+    init_graph(INIT_SIZE, LOG_SIZE);
+    for (time = 0; time < 4; time++)
+    {
+        graph_temporal_add_edge(&tg, 1, time, time);
+    }
+    graph_temporal_add_edge(&tg, 3, 0, 1);
+
+    TEST_ASSERT_EQUAL(4, graph_temporal_expire(&tg, 3));
+    TEST_ASSERT_EQUAL(0, graph_temporal_expire(&tg, 2));
+    TEST_ASSERT_EQUAL(1, tg.num_edges);
+    TEST_ASSERT_EQUAL(2, graph_temporal_add_edge(&tg, 1, 7, 2));
+
+    /* The log of 1 now wraps around the end of its storage. */
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 1, 4, 5));
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 1, 5, 4));
+    TEST_ASSERT_EQUAL(0, graph_temporal_add_edge(&tg, 1, 6, 6));
+    TEST_ASSERT_EQUAL(1, graph_temporal_add_edge(&tg, 1, 7, 7));
+    TEST_ASSERT_EQUAL(3, tg.heads[1]);
+    TEST_ASSERT_EQUAL(3, graph_temporal_target(&tg, 1, 0));
+    TEST_ASSERT_EQUAL(5, graph_temporal_target(&tg, 1, 1));
+    TEST_ASSERT_EQUAL(4, graph_temporal_target(&tg, 1, 2));
+    TEST_ASSERT_EQUAL(2, graph_temporal_window(&tg, 1, 4, 6, &first));
+    TEST_ASSERT_EQUAL(1, first);
+    TEST_ASSERT_EQUAL(0, graph_temporal_window(&tg, 3, 0, 100, &first));
+}
+
+void test_earliest_arrival()
+{
+    GraphRng rng;
+    long arrival[RANDOM_SIZE];
+    long expected[RANDOM_SIZE];
+    int from[RANDOM_EDGES];
+    int to[RANDOM_EDGES];
+    long times[RANDOM_EDGES];
+    int idx;
+    int count;
+    int num_reached;
+    long duration;
+
+    /* 0 -> 1 at 9 is direct but late, 0 -> 2 -> 3 -> 1 is sooner. Only a
+     * path at non-decreasing times reaches 4. */
+    init_graph(INIT_SIZE, LOG_SIZE);
+    graph_temporal_add_edge(&tg, 0, 1, 9);
+    graph_temporal_add_edge(&tg, 0, 2, 1);
+    graph_temporal_add_edge(&tg, 2, 3, 2);
+    graph_temporal_add_edge(&tg, 3, 1, 3);
+    graph_temporal_add_edge(&tg, 1, 4, 3);
+    graph_temporal_add_edge(&tg, 4, 5, 0);
+    TEST_ASSERT_EQUAL(5, graph_temporal_earliest(&tg, 0, 0, 100, 0, arrival,
+                                                 search_buf));
+    TEST_ASSERT_EQUAL(0, arrival[0]);
+    TEST_ASSERT_EQUAL(3, arrival[1]);
+    TEST_ASSERT_EQUAL(3, arrival[4]);
+    TEST_ASSERT_EQUAL(TEMPORAL_NEVER, arrival[5]);
+
+    /* With a duration of 1, 1 -> 4 leaves before the path gets to 1. */
+    TEST_ASSERT_EQUAL(4, graph_temporal_earliest(&tg, 0, 0, 100, 1, arrival,
+                                                 search_buf));
+    TEST_ASSERT_EQUAL(4, arrival[1]);
+    TEST_ASSERT_EQUAL(TEMPORAL_NEVER, arrival[4]);
+
+    /* Random edges, compared against relaxing every edge to a fixed point. */
+    init_graph(RANDOM_SIZE, RANDOM_LOG);
+    graph_rng_seed(&rng, 7, 0);
+    count = 0;
+    for (idx = 0; idx < RANDOM_EDGES; idx++)
+    {
+        from[count] = graph_rng_below(&rng, RANDOM_SIZE);
+        to[count] = graph_rng_below(&rng, RANDOM_SIZE);
+        times[count] = graph_rng_below(&rng, 100);
+        if (graph_temporal_add_edge(&tg, from[count], to[count],
+                                    times[count]) == 0)
+        {
+            count++;
+        }
+    }
+    for (duration = 0; duration < 3; duration++)
+    {
+        num_reached = graph_temporal_earliest(&tg, 0, 10, 80, duration,
+                                              arrival, search_buf);
+        naive_earliest(from, to, times, count, 0, 10, 80, duration, expected,
+                       RANDOM_SIZE);
+        for (idx = 0; idx < RANDOM_SIZE; idx++)
+        {
+            TEST_ASSERT_EQUAL(expected[idx], arrival[idx]);
+            num_reached -= (arrival[idx] != TEMPORAL_NEVER);
+        }
+        TEST_ASSERT_EQUAL(0, num_reached);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  add edges out of time order, verify logs stay sorted and fill up  */
+    RUN_TEST(test_add_keeps_time_order);
+    /*  look up the edges of a node in windows of time  */
+    RUN_TEST(test_window_lookup);
+    /*  expire old edges, refuse them after, wrap a log around  */
+    RUN_TEST(test_expire_and_wrap);
+    /*  find earliest arrivals, compare with a naive search  */
+    RUN_TEST(test_earliest_arrival);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize an empty temporal graph with logs of the same size.
+ */
+static void init_graph(int size, int log_size)
+{
+    int node_id;
+
+    for (node_id = 0; node_id <= size; node_id++)
+    {
+        offsets[node_id] = node_id * log_size;
+    }
+    graph_temporal_init(&tg, size, offsets, int_buf, long_buf);
+}
+
+/*
+ * Find earliest arrivals by relaxing every edge until nothing changes.
+ */
+static void naive_earliest(const int *from, const int *to, const long *times,
+                           int count, int source, long from_time,
+                           long to_time, long duration, long *arrival,
+                           int size)
+{
+    int idx;
+    int changed;
+
+    for (idx = 0; idx < size; idx++)
+    {
+        arrival[idx] = TEMPORAL_NEVER;
+    }
+    arrival[source] = from_time;
+
+    changed = 1;
+    while (changed)
+    {
+        changed = 0;
+        for (idx = 0; idx < count; idx++)
+        {
+            if (times[idx] >= arrival[from[idx]] && times[idx] < to_time &&
+                times[idx] + duration < arrival[to[idx]])
+            {
+                arrival[to[idx]] = times[idx] + duration;
+                changed = 1;
+            }
+        }
+    }
+}
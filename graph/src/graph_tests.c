@@ -47,6 +47,8 @@ void test_bucket_init()
     {
         TEST_ASSERT_EQUAL( NULL, (bucket->adj_nodes)[idx] );
     }
+    TEST_ASSERT_EQUAL(0, bucket->used);
+    TEST_ASSERT_EQUAL(0, bucket->count);
     TEST_ASSERT_EQUAL(NULL, bucket->next);
 }
 
@@ -262,6 +264,211 @@ void test_basic_not_has_edge()
     TEST_ASSERT_EQUAL(1, retval);
 }
 
+void test_counters_follow_changes()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    graph_add_edge(&graph, 0, 1);
+    TEST_ASSERT_EQUAL(0, graph.num_edges);
+
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    graph_add_bucket(&graph, 3, malloc(sizeof(Bucket)));
+    TEST_ASSERT_EQUAL(INIT_SIZE + 1, graph.num_buckets);
+
+    graph_add_edge(&graph, 3, 1);
+    graph_add_edge(&graph, 3, 2);
+    graph_add_edge(&graph, 4, 3);
+    TEST_ASSERT_EQUAL(3, graph.num_edges);
+    TEST_ASSERT_EQUAL(2, node_arr[3].degree);
+    TEST_ASSERT_EQUAL(1, node_arr[4].degree);
+
+    /* Deleting a missing edge changes nothing. */
+    graph_del_edge(&graph, 3, 1);
+    graph_del_edge(&graph, 3, 1);
+    TEST_ASSERT_EQUAL(2, graph.num_edges);
+    TEST_ASSERT_EQUAL(1, node_arr[3].degree);
+}
+
+void test_stats()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    GraphStats stats;
+    int histogram[4];
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 1, malloc(sizeof(Bucket)));
+    for (idx = 0; idx < BUCKET_SIZE + 2; idx++)
+    {
+        graph_add_edge(&graph, 0, idx % INIT_SIZE);
+    }
+    graph_add_edge(&graph, 1, 0);
+    graph_add_edge(&graph, 1, 2);
+    graph_add_edge(&graph, 1, 3);
+    /* Leave a hole at the front of node 0's chain. */
+    graph_del_edge(&graph, 0, 0);
+
+    graph_stats(&graph, &stats, histogram, 4);
+
+    TEST_ASSERT_EQUAL(INIT_SIZE, stats.num_nodes);
+    TEST_ASSERT_EQUAL(BUCKET_SIZE + 4, stats.num_edges);
+    TEST_ASSERT_EQUAL(3, stats.num_buckets);
+    TEST_ASSERT_EQUAL(BUCKET_SIZE + 1, stats.max_degree);
+    TEST_ASSERT_EQUAL(2, stats.max_chain);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.5, stats.avg_chain);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, (BUCKET_SIZE + 4) / (3.0 * BUCKET_SIZE),
+                             stats.fill_ratio);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0 / (BUCKET_SIZE + 2 + 3),
+                             stats.hole_ratio);
+    TEST_ASSERT_EQUAL(sizeof(Graph) + INIT_SIZE * sizeof(Node) +
+                      3 * sizeof(Bucket), stats.bytes);
+
+    /* Degrees 0, [1, 2), [2, 4) and everything from 4 up. */
+    TEST_ASSERT_EQUAL(INIT_SIZE - 2, histogram[0]);
+    TEST_ASSERT_EQUAL(0, histogram[1]);
+    TEST_ASSERT_EQUAL(1, histogram[2]);
+    TEST_ASSERT_EQUAL(1, histogram[3]);
+}
+
+void test_occupancy_mask()
+{
+    Graph graph;
+    Node node_arr[3 * BUCKET_SIZE];
+    Bucket *first;
+    Bucket *second;
+    int idx;
+
+    graph_init(&graph, node_arr, 3 * BUCKET_SIZE);
+    first = malloc(sizeof(Bucket));
+    second = malloc(sizeof(Bucket));
+    graph_add_bucket(&graph, 0, first);
+    graph_add_bucket(&graph, 0, second);
+    for (idx = 0; idx < BUCKET_SIZE + 1; idx++)
+    {
+        graph_add_edge(&graph, 0, idx);
+    }
+    TEST_ASSERT_EQUAL(GRAPH_BUCKET_FULL, first->used);
+    TEST_ASSERT_EQUAL(BUCKET_SIZE, first->count);
+    TEST_ASSERT_EQUAL(1, second->used);
+    TEST_ASSERT_EQUAL(1, second->count);
+
+    /* Deleting clears the edge's bit, and the next edge fills the hole. */
+    graph_del_edge(&graph, 0, 2);
+    TEST_ASSERT_EQUAL(GRAPH_BUCKET_FULL & ~(1U << 2), first->used);
+    TEST_ASSERT_EQUAL(BUCKET_SIZE - 1, first->count);
+    graph_add_edge(&graph, 0, 5);
+    TEST_ASSERT_EQUAL(&node_arr[5], first->adj_nodes[2]);
+    TEST_ASSERT_EQUAL(GRAPH_BUCKET_FULL, first->used);
+
+    /* Emptying a bucket leaves a mask of 0. */
+    graph_del_edge(&graph, 0, BUCKET_SIZE);
+    TEST_ASSERT_EQUAL(0, second->used);
+    TEST_ASSERT_EQUAL(0, second->count);
+    TEST_ASSERT_EQUAL(1, graph_has_edge(&graph, 0, BUCKET_SIZE));
+}
+
+void test_for_each_out_edge()
+{
+    Graph graph;
+    Node node_arr[3 * BUCKET_SIZE];
+    Bucket *cursor;
+    Node *adj_node;
+    unsigned int bits;
+    int seen[3 * BUCKET_SIZE];
+    int visits;
+    int idx;
+
+    graph_init(&graph, node_arr, 3 * BUCKET_SIZE);
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    for (idx = 0; idx < 2 * BUCKET_SIZE + 2; idx++)
+    {
+        graph_add_edge(&graph, 0, idx);
+    }
+    /* Empty the middle bucket and punch a hole in the first. */
+    for (idx = BUCKET_SIZE; idx < 2 * BUCKET_SIZE; idx++)
+    {
+        graph_del_edge(&graph, 0, idx);
+    }
+    graph_del_edge(&graph, 0, 1);
+
+    for (idx = 0; idx < 3 * BUCKET_SIZE; idx++)
+    {
+        seen[idx] = 0;
+    }
+    visits = 0;
+    GRAPH_FOR_EACH_OUT_EDGE(&node_arr[0], cursor, bits, adj_node)
+    {
+        seen[adj_node->id]++;
+        visits++;
+    }
+
+    TEST_ASSERT_EQUAL(node_arr[0].degree, visits);
+    TEST_ASSERT_EQUAL(1, seen[0]);
+    TEST_ASSERT_EQUAL(0, seen[1]);
+    TEST_ASSERT_EQUAL(1, seen[BUCKET_SIZE - 1]);
+    TEST_ASSERT_EQUAL(0, seen[BUCKET_SIZE]);
+    TEST_ASSERT_EQUAL(1, seen[2 * BUCKET_SIZE + 1]);
+}
+
+void test_has_edges_batch()
+{
+    Graph graph;
+    Node node_arr[3 * BUCKET_SIZE];
+    int from[9 * BUCKET_SIZE];
+    int to[9 * BUCKET_SIZE];
+    unsigned char found[(9 * BUCKET_SIZE + 7) / 8];
+    long expected;
+    int idx;
+
+    /* Node 0 has three buckets, node 1 one and node 2 none. */
+    graph_init(&graph, node_arr, 3 * BUCKET_SIZE);
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 0, malloc(sizeof(Bucket)));
+    graph_add_bucket(&graph, 1, malloc(sizeof(Bucket)));
+    for (idx = 0; idx < 3 * BUCKET_SIZE; idx += 2)
+    {
+        graph_add_edge(&graph, 0, idx);
+    }
+    graph_add_edge(&graph, 1, 2);
+    graph_del_edge(&graph, 0, 4);
+
+    /* More lookups than are kept in flight, hits and misses mixed. */
+    for (idx = 0; idx < 9 * BUCKET_SIZE; idx++)
+    {
+        from[idx] = idx % 3;
+        to[idx] = (idx * 7) % (3 * BUCKET_SIZE);
+    }
+    expected = 0;
+    for (idx = 0; idx < 9 * BUCKET_SIZE; idx++)
+    {
+        expected += (graph_has_edge(&graph, from[idx], to[idx]) == 0);
+    }
+
+    TEST_ASSERT_TRUE(expected > 0);
+    TEST_ASSERT_EQUAL(expected, graph_has_edges(&graph, from, to,
+                                                9 * BUCKET_SIZE, found));
+    for (idx = 0; idx < 9 * BUCKET_SIZE; idx++)
+    {
+        TEST_ASSERT_EQUAL(graph_has_edge(&graph, from[idx], to[idx]) == 0,
+                          (found[idx / 8] >> (idx % 8)) & 1);
+    }
+
+    /* An empty batch finds nothing. */
+    TEST_ASSERT_EQUAL(0, graph_has_edges(&graph, from, to, 0, found));
+}
+
 int main()
 {
     UNITY_BEGIN();
@@ -296,6 +503,18 @@ int main()
     /*  test a basic graph for nonexistent edges  */
     RUN_TEST(test_basic_not_has_edge);
 
+    /*  add and delete edges and buckets, verify the counts  */
+    RUN_TEST(test_counters_follow_changes);
+    /*  summarize a small graph, verify every figure  */
+    RUN_TEST(test_stats);
+
+    /*  add and delete edges, verify the buckets' masks and counts  */
+    RUN_TEST(test_occupancy_mask);
+    /*  iterate over edges around holes and an empty bucket  */
+    RUN_TEST(test_for_each_out_edge);
+    /*  look up a batch of edges, verify against single lookups  */
+    RUN_TEST(test_has_edges_batch);
+
 
     UNITY_END();
 }
@@ -0,0 +1,287 @@
+/*
+ * Online topological order with incremental cycle detection.
+ * See Marchetti-Spaccamela, Nanni and Rohnert, "Maintaining a Topological
+ * Order Under Edge Insertions" (1996) for the theory.
+ *
+ * Instead of searching the whole graph for a cycle every time an edge is
+ * added, this header keeps every node's position in a topological order and
+ * only does work when a new edge (x, y) points backwards, with y placed before
+ * x. Then only the nodes placed between y and x can be affected: a search
+ * forward from y that never leaves that window either reaches x, meaning the
+ * edge would close a cycle, or finds the set of nodes that must move. Those
+ * nodes are moved, in their old relative order, to just after the others in
+ * the window, and the order is valid again. An edge that already points
+ * forward costs nothing.
+ *
+ * Pearce and Kelly's algorithm narrows the window further by also searching
+ * backward from x, but that needs edges into each node, which graph.h doesn't
+ * keep. The search here only follows edges out.
+ *
+ * === How to Use ===
+ * This header does no memory management. Allocate three arrays of graph->size
+ * ints and one of graph->size chars, then call 'graph_topo_init' once on a
+ * graph without cycles. From then on add edges with 'graph_topo_add_edge'
+ * instead of 'graph_add_edge', which refuses edges that would make a cycle.
+ * Deleting edges with 'graph_del_edge' never invalidates the order.
+ *
+ * @ord[u] is the position of node u and @node_at[i] the node at position i, so
+ * for every edge (u, v), ord[u] < ord[v].
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_TOPO_H
+#define GRAPH_TOPO_H
+
+#include "graph.h"
+
+typedef struct TopoOrderTag TopoOrder;
+
+static int graph_topo_search(Graph *graph, TopoOrder *topo, int start_id,
+                             int target_id, int upper);
+static void graph_topo_shift(TopoOrder *topo, int lower, int upper);
+
+/*
+ * A topological order of a graph.
+ *
+ * @size: Number of nodes.
+ * @ord: Position of each node.
+ * @node_at: Node at each position.
+ * @stack: Search stack of node ids.
+ * @visited: Flag per node. Set for nodes reached by the current search, all
+ *   clear between calls.
+ * @reordered: Number of nodes moved so far, for tuning.
+ */
+struct TopoOrderTag
+{
+    int size;
+    int *ord;
+    int *node_at;
+    int *stack;
+    char *visited;
+    long reordered;
+};
+
+/*
+ * Compute a topological order of a graph with Kahn's algorithm.
+ *
+ * @graph: The graph to order.
+ * @ord: Array of graph->size ints.
+ * @node_at: Array of graph->size ints.
+ * @stack: Array of graph->size ints.
+ * @visited: Array of graph->size chars.
+ * @return: 0 if the order was computed, 1 if the graph already has a cycle.
+ */
+static int graph_topo_init(Graph *graph, TopoOrder *topo, int *ord,
+                           int *node_at, int *stack, char *visited)
+{
+    int node_id;
+    int idx;
+    int head;
+    int tail;
+    int to_id;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    topo->size = graph->size;
+    topo->ord = ord;
+    topo->node_at = node_at;
+    topo->stack = stack;
+    topo->visited = visited;
+    topo->reordered = 0;
+
+    /*  count edges in, reusing @ord  */
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        ord[node_id] = 0;
+        visited[node_id] = 0;
+    }
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            ord[adj_node->id]++;
+        }
+    }
+
+    /*  @node_at doubles as the queue of nodes with no edges in left  */
+    tail = 0;
+    for (node_id = 0; node_id < graph->size; node_id++)
+    {
+        if (ord[node_id] == 0)
+        {
+            node_at[tail++] = node_id;
+        }
+    }
+    for (head = 0; head < tail; head++)
+    {
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_at[head]], cursor, bits,
+                                adj_node)
+        {
+            to_id = adj_node->id;
+            if (--ord[to_id] == 0)
+            {
+                node_at[tail++] = to_id;
+            }
+        }
+    }
+    if (tail < graph->size)
+    {
+        return 1;
+    }
+
+    for (idx = 0; idx < graph->size; idx++)
+    {
+        ord[node_at[idx]] = idx;
+    }
+    return 0;
+}
+
+/*
+ * Add an edge to a graph unless it would create a cycle, keeping the
+ * topological order valid.
+ *
+ * @topo: Order initialized by 'graph_topo_init' on @graph.
+ * @from_id: The id of the node the edge starts at. Assumed to be valid.
+ * @to_id: The id of the node the edge ends at. Assumed to be valid.
+ * @return: 0 if the edge was added, 1 if there wasn't enough space for it,
+ *   2 if it would have created a cycle. The graph is unchanged unless 0 is
+ *   returned, though the order may have been rearranged.
+ */
+static int graph_topo_add_edge(Graph *graph, TopoOrder *topo, int from_id,
+                               int to_id)
+{
+    int lower;
+    int upper;
+
+    if (from_id == to_id)
+    {
+        return 2;
+    }
+
+    lower = topo->ord[to_id];
+    upper = topo->ord[from_id];
+    if (lower < upper)
+    {
+        /*  the edge points backwards, search the window between them  */
+        if (graph_topo_search(graph, topo, to_id, from_id, upper) != 0)
+        {
+            return 2;
+        }
+        graph_topo_shift(topo, lower, upper);
+    }
+
+    return graph_add_edge(graph, from_id, to_id);
+}
+
+/*
+ * Determine if a node comes before another in the topological order.
+ * If there is a path from @from_id to @to_id, this is always true.
+ *
+ * @return: Bool. 1 if @from_id is placed before @to_id, 0 if not.
+ */
+static int graph_topo_precedes(const TopoOrder *topo, int from_id, int to_id)
+{
+    return topo->ord[from_id] < topo->ord[to_id];
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Mark every node reachable from a node without leaving the window of
+ * positions up to @upper.
+ *
+ * @start_id: Node to search from.
+ * @target_id: Node whose discovery means a cycle.
+ * @upper: Position of @target_id, the end of the window.
+ * @return: 0 if @target_id wasn't reached, 1 if it was. On 1 no marks are
+ *   left behind.
+ */
+static int graph_topo_search(Graph *graph, TopoOrder *topo, int start_id,
+                             int target_id, int upper)
+{
+    int top;
+    int node_id;
+    int to_id;
+    int pos;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    topo->stack[0] = start_id;
+    topo->visited[start_id] = 1;
+    top = 1;
+    while (top > 0)
+    {
+        node_id = topo->stack[--top];
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            to_id = adj_node->id;
+            if (to_id == target_id)
+            {
+                /*  cycle, clear the marks of the window  */
+                for (pos = topo->ord[start_id]; pos <= upper; pos++)
+                {
+                    topo->visited[topo->node_at[pos]] = 0;
+                }
+                return 1;
+            }
+            if (!topo->visited[to_id] && topo->ord[to_id] < upper)
+            {
+                topo->visited[to_id] = 1;
+                topo->stack[top++] = to_id;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Move the marked nodes of a window of positions after the unmarked ones,
+ * keeping the relative order of both groups, and clear the marks.
+ *
+ * @lower: First position of the window.
+ * @upper: Last position of the window.
+ */
+static void graph_topo_shift(TopoOrder *topo, int lower, int upper)
+{
+    int read;
+    int write;
+    int moved;
+    int node_id;
+
+    /*  unmarked nodes slide down, marked ones wait on the stack  */
+    write = lower;
+    moved = 0;
+    for (read = lower; read <= upper; read++)
+    {
+        node_id = topo->node_at[read];
+        if (topo->visited[node_id])
+        {
+            topo->stack[moved++] = node_id;
+            topo->visited[node_id] = 0;
+        }
+        else
+        {
+            topo->node_at[write] = node_id;
+            topo->ord[node_id] = write;
+            write++;
+        }
+    }
+    for (read = 0; read < moved; read++)
+    {
+        node_id = topo->stack[read];
+        topo->node_at[write] = node_id;
+        topo->ord[node_id] = write;
+        write++;
+    }
+
+    topo->reordered += moved;
+}
+
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ * Unit tests for the online topological order header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_topo.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 30
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static TopoOrder topo;
+static int ord[INIT_SIZE];
+static int node_at[INIT_SIZE];
+static int stack[INIT_SIZE];
+static char visited[INIT_SIZE];
+
+static void init_graph(void);
+static int reaches(int from_id, int to_id);
+static void assert_valid_order(void);
+
+
+void test_init_orders_dag()
+{
+    init_graph();
+    graph_add_edge(&graph, 5, 3);
+    graph_add_edge(&graph, 3, 1);
+    graph_add_edge(&graph, 5, 1);
+    graph_add_edge(&graph, 7, 5);
+
+    TEST_ASSERT_EQUAL(0, graph_topo_init(&graph, &topo, ord, node_at, stack,
+                                         visited));
+    assert_valid_order();
+}
+
+void test_init_rejects_cycle()
+{
+    init_graph();
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 1, 2);
+    graph_add_edge(&graph, 2, 0);
+
+    TEST_ASSERT_EQUAL(1, graph_topo_init(&graph, &topo, ord, node_at, stack,
+                                         visited));
+}
+
+void test_backward_edge_reorders()
+{
+    init_graph();
+    graph_topo_init(&graph, &topo, ord, node_at, stack, visited);
+
+    /* Nodes start in id order, so these edges point backwards. */
+    TEST_ASSERT_EQUAL(0, graph_topo_add_edge(&graph, &topo, 4, 2));
+    TEST_ASSERT_EQUAL(0, graph_topo_add_edge(&graph, &topo, 2, 1));
+    TEST_ASSERT_EQUAL(0, graph_topo_add_edge(&graph, &topo, 9, 4));
+    assert_valid_order();
+    TEST_ASSERT_TRUE(graph_topo_precedes(&topo, 9, 1));
+
+    TEST_ASSERT_EQUAL(2, graph_topo_add_edge(&graph, &topo, 1, 9));
+    TEST_ASSERT_EQUAL(2, graph_topo_add_edge(&graph, &topo, 3, 3));
+    TEST_ASSERT_EQUAL(1, graph_has_edge(&graph, 1, 9));
+    assert_valid_order();
+}
+
+void test_random_inserts_match_search()
+{
+    int from_id;
+    int to_id;
+    int expected;
+    int idx;
+
+    init_graph();
+    graph_topo_init(&graph, &topo, ord, node_at, stack, visited);
+    srand(21);
+    for (idx = 0; idx < 300; idx++)
+    {
+        from_id = rand() % INIT_SIZE;
+        to_id = rand() % INIT_SIZE;
+        expected = (from_id == to_id || reaches(to_id, from_id)) ? 2 : 0;
+
+        TEST_ASSERT_EQUAL(expected,
+                          graph_topo_add_edge(&graph, &topo, from_id, to_id));
+        assert_valid_order();
+    }
+}
+
+void test_delete_then_reverse()
+{
+    init_graph();
+    graph_topo_init(&graph, &topo, ord, node_at, stack, visited);
+    graph_topo_add_edge(&graph, &topo, 6, 8);
+    graph_topo_add_edge(&graph, &topo, 8, 2);
+
+    TEST_ASSERT_EQUAL(2, graph_topo_add_edge(&graph, &topo, 2, 6));
+    graph_del_edge(&graph, 6, 8);
+    TEST_ASSERT_EQUAL(0, graph_topo_add_edge(&graph, &topo, 2, 6));
+    assert_valid_order();
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  order an existing graph, verify every edge points forward  */
+    RUN_TEST(test_init_orders_dag);
+    /*  order a graph with a cycle, verify it is refused  */
+    RUN_TEST(test_init_rejects_cycle);
+    /*  add backward edges, verify the order is repaired  */
+    RUN_TEST(test_backward_edge_reorders);
+    /*  add random edges, verify cycle checks against a full search  */
+    RUN_TEST(test_random_inserts_match_search);
+    /*  delete an edge, verify the reverse edge is accepted  */
+    RUN_TEST(test_delete_then_reverse);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize the graph with enough buckets for any test.
+ */
+static void init_graph(void)
+{
+    int idx;
+    int cnt;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        for (cnt = 0; cnt < 4; cnt++)
+        {
+            graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+        }
+    }
+}
+
+/*
+ * Determine if there is a path between two nodes with a full search.
+ */
+static int reaches(int from_id, int to_id)
+{
+    char seen[INIT_SIZE];
+    int queue[INIT_SIZE];
+    int head, tail;
+    int node_id;
+    int idx;
+    Bucket *cursor;
+
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        seen[idx] = 0;
+    }
+    queue[0] = from_id;
+    seen[from_id] = 1;
+    tail = 1;
+    for (head = 0; head < tail; head++)
+    {
+        node_id = queue[head];
+        if (node_id == to_id)
+        {
+            return 1;
+        }
+        for (cursor = node_arr[node_id].edges_out; cursor != 0;
+             cursor = cursor->next)
+        {
+            for (idx = 0; idx < BUCKET_SIZE; idx++)
+            {
+                if (cursor->adj_nodes[idx] != 0 &&
+                    !seen[cursor->adj_nodes[idx]->id])
+                {
+                    seen[cursor->adj_nodes[idx]->id] = 1;
+                    queue[tail++] = cursor->adj_nodes[idx]->id;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Check that the order is a permutation and every edge points forward.
+ */
+static void assert_valid_order(void)
+{
+    int node_id;
+    int idx;
+    Bucket *cursor;
+
+    for (node_id = 0; node_id < INIT_SIZE; node_id++)
+    {
+        TEST_ASSERT_EQUAL(node_id, node_at[ord[node_id]]);
+        TEST_ASSERT_FALSE(visited[node_id]);
+        for (cursor = node_arr[node_id].edges_out; cursor != 0;
+             cursor = cursor->next)
+        {
+            for (idx = 0; idx < BUCKET_SIZE; idx++)
+            {
+                if (cursor->adj_nodes[idx] != 0)
+                {
+                    TEST_ASSERT_TRUE(ord[node_id] <
+                                     ord[cursor->adj_nodes[idx]->id]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,417 @@
+/*
+ * Breadth and depth first traversals with visitor hooks and a reusable
+ * workspace.
+ *
+ * Most traversals differ only in what they do when they reach a node or cross
+ * an edge, and short ones, a reachability check or a search a few hops out,
+ * spend more time clearing their visited array than searching. This header
+ * runs the search and calls back into a visitor, and keeps its visited marks
+ * as stamps: a node is visited if its stamp equals the workspace's current
+ * epoch, so starting a new traversal is bumping the epoch, not clearing an
+ * array. The array is only cleared when the epoch wraps around, once every
+ * 4 billion or so traversals.
+ *
+ * === Visitors ===
+ * A visitor holds up to three hooks and a context pointer passed to each. Any
+ * hook may be null.
+ *   - discover(ctx, node_id, parent_id): a node is reached for the first time,
+ *     from @parent_id, or -1 for a source.
+ *   - examine(ctx, from_id, to_id): an edge out of a node is looked at, before
+ *     its end is checked for a visit.
+ *   - finish(ctx, node_id): every edge out of a node has been examined.
+ * Hooks return TRAVERSE_CONTINUE to carry on, TRAVERSE_STOP to end the
+ * traversal at once, or TRAVERSE_PRUNE to skip: a pruned node is marked but
+ * its edges aren't followed, a pruned edge isn't followed. Every discovered
+ * node is finished, a pruned one right after its discovery, since it has no
+ * edges left to examine.
+ *
+ * === How to Use ===
+ * This header does no memory management. Allocate graph->size unsigned ints
+ * for the stamps and graph->size ints for the queue, and graph->size
+ * TraverseFrames for depth first traversals and graph->size ints for parents
+ * if they're wanted, then call 'graph_traverse_init' once. Every call to
+ * 'graph_traverse_bfs' or 'graph_traverse_dfs' starts a fresh epoch; the marks
+ * and parents of the last traversal stay readable until the next one. Give
+ * each thread its own workspace.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_TRAVERSE_H
+#define GRAPH_TRAVERSE_H
+
+#include "graph.h"
+
+typedef struct TraverseSpaceTag TraverseSpace;
+typedef struct TraverseFrameTag TraverseFrame;
+typedef struct TraverseVisitorTag TraverseVisitor;
+
+/*  hook results  */
+#define TRAVERSE_CONTINUE 0
+#define TRAVERSE_STOP 1
+#define TRAVERSE_PRUNE 2
+
+static void graph_traverse_begin(TraverseSpace *space);
+static int graph_traverse_discover(TraverseSpace *space,
+                                   const TraverseVisitor *visitor, int node_id,
+                                   int parent_id);
+static int graph_traverse_finish(const TraverseVisitor *visitor,
+                                 int node_id);
+static int graph_traverse_found(void *ctx, int node_id, int parent_id);
+
+/*
+ * A traversal workspace, reused from one traversal to the next.
+ *
+ * @size: Number of nodes.
+ * @epoch: Stamp of the nodes visited by the current traversal.
+ * @stamp: Stamp of each node.
+ * @queue: Queue of node ids for breadth first traversals.
+ * @frames: Stack for depth first traversals. May be null.
+ * @parent: Node each node was discovered from, -1 for sources. May be null.
+ *   Only valid for nodes visited by the current traversal.
+ * @num_visited: Number of nodes visited by the current traversal.
+ */
+struct TraverseSpaceTag
+{
+    int size;
+    unsigned int epoch;
+    unsigned int *stamp;
+    int *queue;
+    TraverseFrame *frames;
+    int *parent;
+    int num_visited;
+};
+
+/*
+ * A node on the depth first stack and where its edges were left off.
+ */
+struct TraverseFrameTag
+{
+    int node_id;
+    Bucket *cursor;
+    unsigned int bits;
+};
+
+/*
+ * Hooks called during a traversal. See the top of the file.
+ */
+struct TraverseVisitorTag
+{
+    int (*discover)(void *ctx, int node_id, int parent_id);
+    int (*examine)(void *ctx, int from_id, int to_id);
+    int (*finish)(void *ctx, int node_id);
+    void *ctx;
+};
+
+
+/*
+ * Initialize a traversal workspace.
+ *
+ * @size: Number of nodes of the graphs it will traverse.
+ * @stamp: Array of @size unsigned ints.
+ * @queue: Array of @size ints.
+ * @frames: Array of @size frames, or null for breadth first use only.
+ * @parent: Array of @size ints, or null if parents aren't wanted.
+ */
+static void graph_traverse_init(TraverseSpace *space, int size,
+                                unsigned int *stamp, int *queue,
+                                TraverseFrame *frames, int *parent)
+{
+    int node_id;
+
+    space->size = size;
+    space->epoch = 0;
+    space->stamp = stamp;
+    space->queue = queue;
+    space->frames = frames;
+    space->parent = parent;
+    space->num_visited = 0;
+    for (node_id = 0; node_id < size; node_id++)
+    {
+        stamp[node_id] = 0;
+    }
+}
+
+/*
+ * Determine if the last traversal visited a node.
+ *
+ * @return: Bool. 1 if the node was visited, 0 if not, or if there was no
+ *   traversal yet.
+ */
+static int graph_traverse_visited(const TraverseSpace *space, int node_id)
+{
+    return space->epoch != 0 && space->stamp[node_id] == space->epoch;
+}
+
+/*
+ * Traverse a graph breadth first from a set of sources, in order of distance.
+ *
+ * @sources: Ids of the nodes to start from. Assumed to be valid.
+ * @num_sources: Number of sources.
+ * @visitor: Hooks to call. May be null, for a plain search.
+ * @return: The node whose hook stopped the traversal, or -1 if it ran out of
+ *   nodes.
+ */
+static int graph_traverse_bfs(Graph *graph, TraverseSpace *space,
+                              const int *sources, int num_sources,
+                              const TraverseVisitor *visitor)
+{
+    int head;
+    int tail;
+    int idx;
+    int node_id;
+    int to_id;
+    int result;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    graph_traverse_begin(space);
+    tail = 0;
+    for (idx = 0; idx < num_sources; idx++)
+    {
+        if (graph_traverse_visited(space, sources[idx]))
+        {
+            continue;
+        }
+        result = graph_traverse_discover(space, visitor, sources[idx], -1);
+        if (result == TRAVERSE_PRUNE)
+        {
+            result = graph_traverse_finish(visitor, sources[idx]);
+        }
+        else if (result == TRAVERSE_CONTINUE)
+        {
+            space->queue[tail++] = sources[idx];
+        }
+        if (result == TRAVERSE_STOP)
+        {
+            return sources[idx];
+        }
+    }
+
+    for (head = 0; head < tail; head++)
+    {
+        node_id = space->queue[head];
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            to_id = adj_node->id;
+            if (visitor != 0 && visitor->examine != 0)
+            {
+                result = visitor->examine(visitor->ctx, node_id, to_id);
+                if (result == TRAVERSE_STOP)
+                {
+                    return node_id;
+                }
+                if (result == TRAVERSE_PRUNE)
+                {
+                    continue;
+                }
+            }
+            if (graph_traverse_visited(space, to_id))
+            {
+                continue;
+            }
+
+            result = graph_traverse_discover(space, visitor, to_id, node_id);
+            if (result == TRAVERSE_PRUNE)
+            {
+                result = graph_traverse_finish(visitor, to_id);
+            }
+            else if (result == TRAVERSE_CONTINUE)
+            {
+                space->queue[tail++] = to_id;
+            }
+            if (result == TRAVERSE_STOP)
+            {
+                return to_id;
+            }
+        }
+
+        if (graph_traverse_finish(visitor, node_id) == TRAVERSE_STOP)
+        {
+            return node_id;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Traverse a graph depth first from a source. Nodes are finished in post-order:
+ * after every node discovered from them.
+ * CAUTION: the workspace must have been given frames.
+ *
+ * @source: Id of the node to start from. Assumed to be valid.
+ * @visitor: Hooks to call. May be null, for a plain search.
+ * @return: The node whose hook stopped the traversal, or -1 if it ran out of
+ *   nodes.
+ */
+static int graph_traverse_dfs(Graph *graph, TraverseSpace *space, int source,
+                              const TraverseVisitor *visitor)
+{
+    TraverseFrame *frame;
+    int top;
+    int to_id;
+    int result;
+
+    graph_traverse_begin(space);
+    result = graph_traverse_discover(space, visitor, source, -1);
+    if (result == TRAVERSE_STOP)
+    {
+        return source;
+    }
+
+    top = 0;
+    frame = &space->frames[0];
+    frame->node_id = source;
+    frame->cursor = (result == TRAVERSE_PRUNE ? 0 :
+                     graph->nodes[source].edges_out);
+    frame->bits = (frame->cursor == 0 ? 0 : frame->cursor->used);
+    while (top >= 0)
+    {
+        frame = &space->frames[top];
+
+        /*  move to the next live slot of the frame's node  */
+        while (frame->bits == 0 && frame->cursor != 0)
+        {
+            frame->cursor = frame->cursor->next;
+            frame->bits = (frame->cursor == 0 ? 0 : frame->cursor->used);
+        }
+        if (frame->cursor == 0)
+        {
+            if (graph_traverse_finish(visitor, frame->node_id) ==
+                TRAVERSE_STOP)
+            {
+                return frame->node_id;
+            }
+            top--;
+            continue;
+        }
+
+        to_id = frame->cursor->adj_nodes[GRAPH_CTZ(frame->bits)]->id;
+        frame->bits &= frame->bits - 1;
+        if (visitor != 0 && visitor->examine != 0)
+        {
+            result = visitor->examine(visitor->ctx, frame->node_id, to_id);
+            if (result == TRAVERSE_STOP)
+            {
+                return frame->node_id;
+            }
+            if (result == TRAVERSE_PRUNE)
+            {
+                continue;
+            }
+        }
+        if (graph_traverse_visited(space, to_id))
+        {
+            continue;
+        }
+
+        result = graph_traverse_discover(space, visitor, to_id,
+                                         frame->node_id);
+        if (result == TRAVERSE_STOP)
+        {
+            return to_id;
+        }
+        frame = &space->frames[++top];
+        frame->node_id = to_id;
+        frame->cursor = (result == TRAVERSE_PRUNE ? 0 :
+                         graph->nodes[to_id].edges_out);
+        frame->bits = (frame->cursor == 0 ? 0 : frame->cursor->used);
+    }
+
+    return -1;
+}
+
+/*
+ * Determine if there is a path between two nodes, stopping as soon as the
+ * target is found.
+ *
+ * @from_id: Id of the node to start from. Assumed to be valid.
+ * @to_id: Id of the node to look for. Assumed to be valid.
+ * @return: Bool. 1 if @to_id is reachable from @from_id, 0 if not.
+ */
+static int graph_traverse_reaches(Graph *graph, TraverseSpace *space,
+                                  int from_id, int to_id)
+{
+    TraverseVisitor visitor;
+
+    visitor.discover = graph_traverse_found;
+    visitor.examine = 0;
+    visitor.finish = 0;
+    visitor.ctx = &to_id;
+    return graph_traverse_bfs(graph, space, &from_id, 1, &visitor) == to_id;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Start a new epoch, clearing the stamps only when the epoch wraps around.
+ */
+static void graph_traverse_begin(TraverseSpace *space)
+{
+    int node_id;
+
+    space->epoch++;
+    if (space->epoch == 0)
+    {
+        for (node_id = 0; node_id < space->size; node_id++)
+        {
+            space->stamp[node_id] = 0;
+        }
+        space->epoch = 1;
+    }
+    space->num_visited = 0;
+}
+
+/*
+ * Mark a node visited, record its parent and call the discover hook.
+ *
+ * @return: The hook's result, TRAVERSE_CONTINUE if there is none.
+ */
+static int graph_traverse_discover(TraverseSpace *space,
+                                   const TraverseVisitor *visitor, int node_id,
+                                   int parent_id)
+{
+    space->stamp[node_id] = space->epoch;
+    space->num_visited++;
+    if (space->parent != 0)
+    {
+        space->parent[node_id] = parent_id;
+    }
+    if (visitor == 0 || visitor->discover == 0)
+    {
+        return TRAVERSE_CONTINUE;
+    }
+    return visitor->discover(visitor->ctx, node_id, parent_id);
+}
+
+/*
+ * Call the finish hook of a node.
+ *
+ * @return: The hook's result, TRAVERSE_CONTINUE if there is none.
+ */
+static int graph_traverse_finish(const TraverseVisitor *visitor, int node_id)
+{
+    if (visitor == 0 || visitor->finish == 0)
+    {
+        return TRAVERSE_CONTINUE;
+    }
+    return visitor->finish(visitor->ctx, node_id);
+}
+
+/*
+ * Discover hook of 'graph_traverse_reaches': stop at the target.
+ *
+ * @ctx: Pointer to the target's id.
+ */
+static int graph_traverse_found(void *ctx, int node_id, int parent_id)
+{
+    (void)parent_id;
+    return (node_id == *(int *)ctx ? TRAVERSE_STOP : TRAVERSE_CONTINUE);
+}
+
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * Unit tests for the traversal header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_traverse.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 12
+
+static Graph graph;
+static Node node_arr[INIT_SIZE];
+static TraverseSpace space;
+static unsigned int stamp[INIT_SIZE];
+static int queue[INIT_SIZE];
+static TraverseFrame frames[INIT_SIZE];
+static int parent[INIT_SIZE];
+
+/*  what the hooks saw, in order  */
+static int events[4 * INIT_SIZE];
+static int num_events;
+
+static void init_graph(void);
+static int record_discover(void *ctx, int node_id, int parent_id);
+static int record_finish(void *ctx, int node_id);
+static int prune_edge(void *ctx, int from_id, int to_id);
+static int prune_node(void *ctx, int node_id, int parent_id);
+
+
+void test_bfs_order_and_parents()
+{
+    TraverseVisitor visitor;
+    int source;
+
+    init_graph();
+    visitor.discover = record_discover;
+    visitor.examine = 0;
+    visitor.finish = 0;
+    visitor.ctx = 0;
+    num_events = 0;
+
+    /* Nothing is visited before the first traversal. */
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 0));
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 7));
+
+    source = 0;
+    TEST_ASSERT_EQUAL(-1, graph_traverse_bfs(&graph, &space, &source, 1,
+                                             &visitor));
+    TEST_ASSERT_EQUAL(7, space.num_visited);
+    TEST_ASSERT_EQUAL(0, events[0]);
+    TEST_ASSERT_EQUAL(6, events[num_events - 1]);
+    TEST_ASSERT_EQUAL(-1, parent[0]);
+    TEST_ASSERT_EQUAL(3, parent[5]);
+    TEST_ASSERT_EQUAL(5, parent[6]);
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 8));
+}
+
+void test_early_stop_and_prune()
+{
+    TraverseVisitor visitor;
+    int sources[2];
+
+    init_graph();
+    num_events = 0;
+
+    /* A discover hook that returns STOP at node 4. */
+    visitor.discover = record_discover;
+    visitor.examine = 0;
+    visitor.finish = 0;
+    visitor.ctx = &node_arr[4];
+    sources[0] = 0;
+    TEST_ASSERT_EQUAL(4, graph_traverse_bfs(&graph, &space, sources, 1,
+                                            &visitor));
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 6));
+
+    /* Never cross the edge 3 -> 5, so 5 and 6 are cut off. */
+    visitor.discover = 0;
+    visitor.examine = prune_edge;
+    visitor.ctx = 0;
+    TEST_ASSERT_EQUAL(-1, graph_traverse_bfs(&graph, &space, sources, 1,
+                                             &visitor));
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 5));
+    TEST_ASSERT_EQUAL(5, space.num_visited);
+
+    /* Two sources, one of them from the other component. */
+    sources[1] = 8;
+    graph_traverse_bfs(&graph, &space, sources, 2, 0);
+    TEST_ASSERT_EQUAL(10, space.num_visited);
+    TEST_ASSERT_EQUAL(-1, parent[8]);
+}
+
+void test_dfs_finishes_in_post_order()
+{
+    TraverseVisitor visitor;
+    int idx;
+    int node_id;
+    int pos[INIT_SIZE];
+
+    init_graph();
+    visitor.discover = record_discover;
+    visitor.examine = 0;
+    visitor.finish = record_finish;
+    visitor.ctx = 0;
+    num_events = 0;
+
+    TEST_ASSERT_EQUAL(-1, graph_traverse_dfs(&graph, &space, 0, &visitor));
+
+    /* Discoveries are logged as ids, finishes as ~ids. Every node finishes
+     * after every node discovered from it. */
+    TEST_ASSERT_EQUAL(14, num_events);
+    TEST_ASSERT_EQUAL(~0, events[num_events - 1]);
+    for (idx = 0; idx < num_events; idx++)
+    {
+        if (events[idx] < 0)
+        {
+            pos[~events[idx]] = idx;
+        }
+    }
+    for (node_id = 1; node_id <= 6; node_id++)
+    {
+        TEST_ASSERT_TRUE(pos[node_id] < pos[parent[node_id]]);
+    }
+}
+
+void test_pruned_nodes_finish()
+{
+    TraverseVisitor visitor;
+    int source;
+    int pass;
+    int idx;
+
+    init_graph();
+    visitor.discover = prune_node;
+    visitor.examine = 0;
+    visitor.finish = record_finish;
+    visitor.ctx = 0;
+    source = 0;
+
+    /* Node 3 is pruned, so 5 and 6 are cut off. Both traversals finish it
+     * right after discovering it. */
+    for (pass = 0; pass < 2; pass++)
+    {
+        num_events = 0;
+        if (pass == 0)
+        {
+            graph_traverse_bfs(&graph, &space, &source, 1, &visitor);
+        }
+        else
+        {
+            graph_traverse_dfs(&graph, &space, 0, &visitor);
+        }
+        TEST_ASSERT_EQUAL(5, space.num_visited);
+        TEST_ASSERT_EQUAL(10, num_events);
+        TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 5));
+        for (idx = 0; events[idx] != 3; idx++)
+        {
+        }
+        TEST_ASSERT_EQUAL(~3, events[idx + 1]);
+    }
+}
+
+void test_epochs_reuse_workspace()
+{
+    init_graph();
+
+    TEST_ASSERT_EQUAL(1, graph_traverse_reaches(&graph, &space, 0, 6));
+    TEST_ASSERT_EQUAL(0, graph_traverse_reaches(&graph, &space, 6, 0));
+    TEST_ASSERT_EQUAL(1, graph_traverse_reaches(&graph, &space, 9, 9));
+    TEST_ASSERT_EQUAL(1, space.num_visited);
+
+    /* Wrap the epoch around, the stamps of old traversals are cleared. */
+    graph_traverse_reaches(&graph, &space, 0, 6);
+    space.epoch = (unsigned int)-1;
+    TEST_ASSERT_EQUAL(0, graph_traverse_reaches(&graph, &space, 8, 11));
+    TEST_ASSERT_EQUAL(1, space.epoch);
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 11));
+    TEST_ASSERT_EQUAL(0, graph_traverse_visited(&space, 0));
+    TEST_ASSERT_EQUAL(1, graph_traverse_visited(&space, 10));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  search breadth first, verify order, parents and visit marks  */
+    RUN_TEST(test_bfs_order_and_parents);
+    /*  stop from a discover hook, prune an edge, start from two sources  */
+    RUN_TEST(test_early_stop_and_prune);
+    /*  search depth first, verify nodes finish after their children  */
+    RUN_TEST(test_dfs_finishes_in_post_order);
+    /*  prune a node from both traversals, verify it still finishes  */
+    RUN_TEST(test_pruned_nodes_finish);
+    /*  run many searches on one workspace, wrap the epoch around  */
+    RUN_TEST(test_epochs_reuse_workspace);
+
+
+    UNITY_END();
+}
+
+/*
+ * Build the graph and its workspace:
+ *   0 -> 1, 0 -> 2, 1 -> 3, 2 -> 3, 2 -> 4, 3 -> 5, 5 -> 6, 6 -> 2
+ *   8 -> 9, 9 -> 10, 10 -> 8
+ * Nodes 7 and 11 have no edges.
+ */
+static void init_graph(void)
+{
+    int idx;
+
+    graph_init(&graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 1, 3);
+    graph_add_edge(&graph, 2, 3);
+    graph_add_edge(&graph, 2, 4);
+    graph_add_edge(&graph, 3, 5);
+    graph_add_edge(&graph, 5, 6);
+    graph_add_edge(&graph, 6, 2);
+    graph_add_edge(&graph, 8, 9);
+    graph_add_edge(&graph, 9, 10);
+    graph_add_edge(&graph, 10, 8);
+
+    graph_traverse_init(&space, INIT_SIZE, stamp, queue, frames, parent);
+}
+
+/*
+ * Log a discovered node. Stop at the node @ctx points to, if any.
+ */
+static int record_discover(void *ctx, int node_id, int parent_id)
+{
+    events[num_events++] = node_id;
+    if (ctx != 0 && ((Node *)ctx)->id == node_id)
+    {
+        return TRAVERSE_STOP;
+    }
+    return TRAVERSE_CONTINUE;
+}
+
+/*
+ * Log a finished node as its complement.
+ */
+static int record_finish(void *ctx, int node_id)
+{
+    events[num_events++] = ~node_id;
+    return TRAVERSE_CONTINUE;
+}
+
+/*
+ * Refuse the edge 3 -> 5.
+ */
+static int prune_edge(void *ctx, int from_id, int to_id)
+{
+    if (from_id == 3 && to_id == 5)
+    {
+        return TRAVERSE_PRUNE;
+    }
+    return TRAVERSE_CONTINUE;
+}
+
+/*
+ * Log a discovered node. Prune node 3.
+ */
+static int prune_node(void *ctx, int node_id, int parent_id)
+{
+    events[num_events++] = node_id;
+    if (node_id == 3)
+    {
+        return TRAVERSE_PRUNE;
+    }
+    return TRAVERSE_CONTINUE;
+}
@@ -0,0 +1,423 @@
+/*
+ * Constant time ancestor queries on graphs shaped like rooted trees.
+ *
+ * Many graphs are trees: org charts, category hierarchies, file systems. On
+ * those, asking whether one node is under another, or which node is the lowest
+ * common ancestor of two, walks edges up or down the tree every time. This
+ * header walks the tree once and keeps three structures that answer those
+ * questions without touching the graph again:
+ *   - Pre-order ranges. Nodes are numbered in the order a depth first walk
+ *     enters them, so the subtree of a node is one contiguous range of
+ *     numbers, and "is u an ancestor of v" is two comparisons.
+ *   - An Euler tour with a sparse table. The tour lists each node every time
+ *     the walk passes through it, 2n - 1 entries in all, and the lowest common
+ *     ancestor of u and v is the shallowest node on the tour between their
+ *     first visits. The sparse table keeps the shallowest node of every range
+ *     of the tour whose length is a power of two, so any range is covered by
+ *     two overlapping ones. See Bender and Farach-Colton, "The LCA Problem
+ *     Revisited" (2000).
+ *   - Binary lifting. The 2^j-th ancestor of every node, for the k-th
+ *     ancestor in one step per set bit of k.
+ *
+ * === How to Use ===
+ * This header does no memory management. Edges of the graph point from parent
+ * to child. Allocate an int array of 'graph_tree_int_words' ints and call
+ * 'graph_tree_init' with the root. Nodes the root doesn't reach are left out
+ * of the tree; check them with 'graph_tree_contains' before querying. The
+ * structures are not updated when the graph changes; build them again instead.
+ *
+ * @tin[u] is the pre-order number of node u and @order[i] the node numbered i,
+ * so the subtree of u is order[tin[u]] to order[tout[u] - 1].
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_TREE_H
+#define GRAPH_TREE_H
+
+#include "graph.h"
+
+typedef struct TreeTag Tree;
+
+static int graph_tree_levels(int size);
+static int graph_tree_link(Graph *graph, Tree *tree, int root_id);
+static void graph_tree_walk(Tree *tree, int root_id);
+static void graph_tree_build_tables(Tree *tree);
+static int *graph_tree_row(const Tree *tree, int level);
+static int graph_tree_shallower(const Tree *tree, int left_id, int right_id);
+
+/*
+ * A rooted tree with its query structures.
+ *
+ * @size: Number of node ids, reached or not.
+ * @root: Id of the root.
+ * @num_nodes: Number of nodes in the tree.
+ * @levels: Number of rows of the sparse and lifting tables.
+ * @parent: Parent of each node, -1 for the root and nodes not in the tree.
+ * @depth: Edges between each node and the root, -1 for nodes not in the tree.
+ * @tin: Pre-order number of each node, -1 for nodes not in the tree.
+ * @tout: One past the last pre-order number in the subtree of each node.
+ * @order: Node of each pre-order number.
+ * @first: Position of each node's first visit on the Euler tour.
+ * @euler: The Euler tour, @euler_len node ids.
+ * @lg: Floor of log2 of each range length up to @euler_len.
+ * @sparse: Rows 1 to @levels - 1 of the sparse table, @euler_len entries
+ *   each. Row 0 is the tour itself.
+ * @up: Rows 1 to @levels - 1 of the lifting table, @size entries each. Row
+ *   0 is @parent.
+ * @child: Scratch for building, first child of each node.
+ * @sibling: Scratch for building, next sibling of each node.
+ */
+struct TreeTag
+{
+    int size;
+    int root;
+    int num_nodes;
+    int levels;
+    int *parent;
+    int *depth;
+    int *tin;
+    int *tout;
+    int *order;
+    int *first;
+    int *euler;
+    int euler_len;
+    int *lg;
+    int *sparse;
+    int *up;
+    int *child;
+    int *sibling;
+};
+
+
+/*
+ * Determine how many ints 'graph_tree_init' needs for a graph.
+ *
+ * @size: Number of nodes in the graph.
+ */
+static long graph_tree_int_words(int size)
+{
+    long levels;
+
+    levels = graph_tree_levels(size);
+    return 12L * size + 3L * (levels - 1) * size;
+}
+
+/*
+ * Walk a tree from its root and build its query structures.
+ *
+ * @graph: Graph whose edges point from parent to child.
+ * @root_id: Id of the root. Assumed to be valid.
+ * @int_buf: Array of @int_words ints.
+ * @int_words: Size of @int_buf, at least 'graph_tree_int_words'.
+ * @return: 0 if the tree was built, 1 if a node reachable from the root has
+ *   two edges in or the root has one, 2 if @int_buf is too small.
+ */
+static int graph_tree_init(Graph *graph, Tree *tree, int root_id, int *int_buf,
+                           long int_words)
+{
+    int size;
+
+    size = graph->size;
+    if (int_words < graph_tree_int_words(size))
+    {
+        return 2;
+    }
+
+    tree->size = size;
+    tree->root = root_id;
+    tree->levels = graph_tree_levels(size);
+    tree->parent = int_buf;
+    tree->depth = tree->parent + size;
+    tree->tin = tree->depth + size;
+    tree->tout = tree->tin + size;
+    tree->order = tree->tout + size;
+    tree->first = tree->order + size;
+    tree->child = tree->first + size;
+    tree->sibling = tree->child + size;
+    tree->euler = tree->sibling + size;
+    tree->lg = tree->euler + 2 * size;
+    tree->sparse = tree->lg + 2 * size;
+    tree->up = tree->sparse + (long)(tree->levels - 1) * 2 * size;
+
+    if (graph_tree_link(graph, tree, root_id) != 0)
+    {
+        return 1;
+    }
+    graph_tree_walk(tree, root_id);
+    graph_tree_build_tables(tree);
+
+    return 0;
+}
+
+/*
+ * Determine if a node is in a tree.
+ *
+ * @return: Bool. 1 if the root reaches @node_id, 0 if not.
+ */
+static int graph_tree_contains(const Tree *tree, int node_id)
+{
+    return tree->tin[node_id] >= 0;
+}
+
+/*
+ * Determine if a node is an ancestor of another, counting a node as its own
+ * ancestor. Both nodes must be in the tree.
+ *
+ * @return: Bool. 1 if @node_id is in the subtree of @anc_id, 0 if not.
+ */
+static int graph_tree_is_ancestor(const Tree *tree, int anc_id, int node_id)
+{
+    return tree->tin[anc_id] <= tree->tin[node_id] &&
+           tree->tin[node_id] < tree->tout[anc_id];
+}
+
+/*
+ * Find the lowest common ancestor of two nodes. Both nodes must be in the
+ * tree.
+ *
+ * @return: Id of the deepest node with both nodes in its subtree.
+ */
+static int graph_tree_lca(const Tree *tree, int left_id, int right_id)
+{
+    int lower;
+    int upper;
+    int level;
+    int *row;
+
+    lower = tree->first[left_id];
+    upper = tree->first[right_id];
+    if (lower > upper)
+    {
+        level = lower;
+        lower = upper;
+        upper = level;
+    }
+
+    /*  two ranges of 2^level entries cover [lower, upper]  */
+    level = tree->lg[upper - lower + 1];
+    row = graph_tree_row(tree, level);
+    return graph_tree_shallower(tree, row[lower],
+                                row[upper - (1 << level) + 1]);
+}
+
+/*
+ * Find the number of edges on the path between two nodes. Both nodes must be
+ * in the tree.
+ */
+static int graph_tree_distance(const Tree *tree, int left_id, int right_id)
+{
+    return tree->depth[left_id] + tree->depth[right_id] -
+           2 * tree->depth[graph_tree_lca(tree, left_id, right_id)];
+}
+
+/*
+ * Find the ancestor a given number of edges above a node. The node must be in
+ * the tree.
+ *
+ * @steps: Number of edges to climb. 0 gives the node itself.
+ * @return: Id of the ancestor, -1 if @steps is negative or more than the depth
+ *   of the node.
+ */
+static int graph_tree_kth_ancestor(const Tree *tree, int node_id, int steps)
+{
+    int level;
+
+    if (steps < 0 || steps > tree->depth[node_id])
+    {
+        return -1;
+    }
+
+    for (level = 0; steps != 0; level++, steps >>= 1)
+    {
+        if (steps & 1)
+        {
+            node_id = (level == 0 ? tree->parent[node_id] :
+                       tree->up[(long)(level - 1) * tree->size + node_id]);
+        }
+    }
+
+    return node_id;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Find the number of sparse table rows for a tree of a given size: one more
+ * than the floor of log2 of the longest possible tour.
+ */
+static int graph_tree_levels(int size)
+{
+    int levels;
+    long span;
+
+    levels = 1;
+    for (span = 2; span <= 2L * size; span <<= 1)
+    {
+        levels++;
+    }
+
+    return levels;
+}
+
+/*
+ * Record the parent and the children of every node reachable from the root,
+ * chaining children through @child and @sibling.
+ *
+ * @return: 0 on success, 1 if a node would have two parents.
+ */
+static int graph_tree_link(Graph *graph, Tree *tree, int root_id)
+{
+    int node_id;
+    int head;
+    int tail;
+    unsigned int bits;
+    Bucket *cursor;
+    Node *adj_node;
+
+    for (node_id = 0; node_id < tree->size; node_id++)
+    {
+        tree->parent[node_id] = -1;
+        tree->depth[node_id] = -1;
+        tree->tin[node_id] = -1;
+        tree->tout[node_id] = -1;
+        tree->child[node_id] = -1;
+        tree->sibling[node_id] = -1;
+    }
+
+    /*  breadth first from the root, @order doubles as the queue  */
+    tree->order[0] = root_id;
+    tree->depth[root_id] = 0;
+    tail = 1;
+    for (head = 0; head < tail; head++)
+    {
+        node_id = tree->order[head];
+        GRAPH_FOR_EACH_OUT_EDGE(&graph->nodes[node_id], cursor, bits, adj_node)
+        {
+            if (tree->depth[adj_node->id] >= 0)
+            {
+                return 1;
+            }
+            tree->depth[adj_node->id] = tree->depth[node_id] + 1;
+            tree->parent[adj_node->id] = node_id;
+            tree->sibling[adj_node->id] = tree->child[node_id];
+            tree->child[node_id] = adj_node->id;
+            tree->order[tail++] = adj_node->id;
+        }
+    }
+
+    tree->num_nodes = tail;
+    return 0;
+}
+
+/*
+ * Walk the tree depth first without a stack, following @child down and
+ * @sibling and @parent back up, numbering nodes and recording the tour.
+ */
+static void graph_tree_walk(Tree *tree, int root_id)
+{
+    int node_id;
+    int next_id;
+    int number;
+    int len;
+
+    number = 0;
+    len = 0;
+    node_id = -1;
+    next_id = root_id;
+    while (1)
+    {
+        if (next_id >= 0)
+        {
+            /*  enter the next node  */
+            node_id = next_id;
+            tree->tin[node_id] = number;
+            tree->order[number++] = node_id;
+            tree->first[node_id] = len;
+            tree->euler[len++] = node_id;
+            next_id = tree->child[node_id];
+        }
+        else
+        {
+            /*  leave the node, back to its parent  */
+            tree->tout[node_id] = number;
+            if (node_id == root_id)
+            {
+                break;
+            }
+            next_id = tree->sibling[node_id];
+            node_id = tree->parent[node_id];
+            tree->euler[len++] = node_id;
+        }
+    }
+
+    tree->euler_len = len;
+}
+
+/*
+ * Fill the log table, the sparse table over the tour and the lifting table.
+ */
+static void graph_tree_build_tables(Tree *tree)
+{
+    int level;
+    int half;
+    int idx;
+    int node_id;
+    int *row;
+    int *prev;
+    int *lift;
+    int *below;
+
+    tree->lg[1] = 0;
+    for (idx = 2; idx <= tree->euler_len; idx++)
+    {
+        tree->lg[idx] = tree->lg[idx / 2] + 1;
+    }
+
+    for (level = 1; level < tree->levels; level++)
+    {
+        prev = graph_tree_row(tree, level - 1);
+        row = graph_tree_row(tree, level);
+        half = 1 << (level - 1);
+        for (idx = 0; idx + 2 * half <= tree->euler_len; idx++)
+        {
+            row[idx] = graph_tree_shallower(tree, prev[idx], prev[idx + half]);
+        }
+
+        /*  the 2^level-th ancestor is the 2^(level-1)-th one's, twice  */
+        below = (level == 1 ? tree->parent :
+                 tree->up + (long)(level - 2) * tree->size);
+        lift = tree->up + (long)(level - 1) * tree->size;
+        for (node_id = 0; node_id < tree->size; node_id++)
+        {
+            lift[node_id] = (below[node_id] < 0 ? -1 :
+                             below[below[node_id]]);
+        }
+    }
+}
+
+/*
+ * Find a row of the sparse table.
+ */
+static int *graph_tree_row(const Tree *tree, int level)
+{
+    if (level == 0)
+    {
+        return tree->euler;
+    }
+    return tree->sparse + (long)(level - 1) * 2 * tree->size;
+}
+
+/*
+ * Pick the shallower of two nodes.
+ */
+static int graph_tree_shallower(const Tree *tree, int left_id, int right_id)
+{
+    return (tree->depth[left_id] <= tree->depth[right_id] ? left_id :
+            right_id);
+}
+
+
+#endif
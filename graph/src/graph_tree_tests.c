@@ -0,0 +1,238 @@
+/*
+ * Unit tests for the rooted tree header.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_tree.h"
+#include "graph_rng.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 12
+#define RANDOM_SIZE 300
+
+static void init_graph(Graph *graph, Node *node_arr, int size);
+static int naive_lca(const int *parent, const int *depth, int left_id,
+                     int right_id);
+
+
+void test_queries_on_small_tree()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    Tree tree;
+    int *int_buf;
+
+    /*
+     *          0
+     *        / | \
+     *       1  2  3
+     *      / \     \
+     *     4   5     6
+     *    /         / \
+     *   7         8   9
+     */
+    init_graph(&graph, node_arr, INIT_SIZE);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 0, 3);
+    graph_add_edge(&graph, 1, 4);
+    graph_add_edge(&graph, 1, 5);
+    graph_add_edge(&graph, 3, 6);
+    graph_add_edge(&graph, 4, 7);
+    graph_add_edge(&graph, 6, 8);
+    graph_add_edge(&graph, 6, 9);
+
+    int_buf = malloc(graph_tree_int_words(INIT_SIZE) * sizeof(int));
+    TEST_ASSERT_EQUAL(0, graph_tree_init(&graph, &tree, 0, int_buf,
+                                         graph_tree_int_words(INIT_SIZE)));
+    TEST_ASSERT_EQUAL(10, tree.num_nodes);
+    TEST_ASSERT_EQUAL(19, tree.euler_len);
+
+    TEST_ASSERT_EQUAL(1, graph_tree_lca(&tree, 7, 5));
+    TEST_ASSERT_EQUAL(0, graph_tree_lca(&tree, 7, 9));
+    TEST_ASSERT_EQUAL(6, graph_tree_lca(&tree, 8, 9));
+    TEST_ASSERT_EQUAL(3, graph_tree_lca(&tree, 3, 8));
+    TEST_ASSERT_EQUAL(2, graph_tree_lca(&tree, 2, 2));
+    TEST_ASSERT_EQUAL(6, graph_tree_distance(&tree, 7, 9));
+
+    TEST_ASSERT_EQUAL(1, graph_tree_is_ancestor(&tree, 1, 7));
+    TEST_ASSERT_EQUAL(1, graph_tree_is_ancestor(&tree, 4, 4));
+    TEST_ASSERT_EQUAL(0, graph_tree_is_ancestor(&tree, 7, 1));
+    TEST_ASSERT_EQUAL(0, graph_tree_is_ancestor(&tree, 2, 8));
+
+    TEST_ASSERT_EQUAL(7, graph_tree_kth_ancestor(&tree, 7, 0));
+    TEST_ASSERT_EQUAL(1, graph_tree_kth_ancestor(&tree, 7, 2));
+    TEST_ASSERT_EQUAL(0, graph_tree_kth_ancestor(&tree, 7, 3));
+    TEST_ASSERT_EQUAL(-1, graph_tree_kth_ancestor(&tree, 7, 4));
+    free(int_buf);
+}
+
+void test_subtree_ranges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    Tree tree;
+    int *int_buf;
+    int idx;
+
+    init_graph(&graph, node_arr, INIT_SIZE);
+    graph_add_edge(&graph, 5, 2);
+    graph_add_edge(&graph, 5, 8);
+    graph_add_edge(&graph, 2, 0);
+    graph_add_edge(&graph, 2, 11);
+    graph_add_edge(&graph, 8, 3);
+
+    int_buf = malloc(graph_tree_int_words(INIT_SIZE) * sizeof(int));
+    graph_tree_init(&graph, &tree, 5, int_buf,
+                    graph_tree_int_words(INIT_SIZE));
+
+    /* The subtree of 2 is 2, 0 and 11, in one range starting at 2. */
+    TEST_ASSERT_EQUAL(3, tree.tout[2] - tree.tin[2]);
+    TEST_ASSERT_EQUAL(2, tree.order[tree.tin[2]]);
+    for (idx = tree.tin[2]; idx < tree.tout[2]; idx++)
+    {
+        TEST_ASSERT_EQUAL(1, graph_tree_is_ancestor(&tree, 2, tree.order[idx]));
+    }
+    TEST_ASSERT_EQUAL(0, tree.tin[5]);
+    TEST_ASSERT_EQUAL(6, tree.tout[5]);
+
+    /* Nodes the root doesn't reach are left out. */
+    TEST_ASSERT_EQUAL(1, graph_tree_contains(&tree, 11));
+    TEST_ASSERT_EQUAL(0, graph_tree_contains(&tree, 4));
+    TEST_ASSERT_EQUAL(-1, tree.parent[4]);
+    free(int_buf);
+}
+
+void test_rejects_non_trees()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    Tree tree;
+    int *int_buf;
+
+    int_buf = malloc(graph_tree_int_words(INIT_SIZE) * sizeof(int));
+
+    /* Node 3 has two parents. */
+    init_graph(&graph, node_arr, INIT_SIZE);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 1, 3);
+    graph_add_edge(&graph, 2, 3);
+    TEST_ASSERT_EQUAL(1, graph_tree_init(&graph, &tree, 0, int_buf,
+                                         graph_tree_int_words(INIT_SIZE)));
+
+    /* The root has a parent. */
+    init_graph(&graph, node_arr, INIT_SIZE);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 1, 0);
+    TEST_ASSERT_EQUAL(1, graph_tree_init(&graph, &tree, 0, int_buf,
+                                         graph_tree_int_words(INIT_SIZE)));
+
+    TEST_ASSERT_EQUAL(2, graph_tree_init(&graph, &tree, 0, int_buf,
+                                         graph_tree_int_words(INIT_SIZE) - 1));
+    free(int_buf);
+}
+
+void test_random_tree_matches_naive()
+{
+    Graph graph;
+    Node node_arr[RANDOM_SIZE];
+    Tree tree;
+    GraphRng rng;
+    int *int_buf;
+    int left_id;
+    int right_id;
+    int lca_id;
+    int idx;
+
+    /* Each node hangs off a random earlier one, a deep and bushy tree. */
+    graph_init(&graph, node_arr, RANDOM_SIZE);
+    for (idx = 0; idx < RANDOM_SIZE; idx++)
+    {
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+        graph_add_bucket(&graph, idx, malloc(sizeof(Bucket)));
+    }
+    graph_rng_seed(&rng, 11, 0);
+    for (idx = 1; idx < RANDOM_SIZE; idx++)
+    {
+        left_id = idx - 1 - graph_rng_below(&rng, (idx < 4 ? idx : 4));
+        graph_add_edge(&graph, left_id, idx);
+    }
+
+    int_buf = malloc(graph_tree_int_words(RANDOM_SIZE) * sizeof(int));
+    TEST_ASSERT_EQUAL(0, graph_tree_init(&graph, &tree, 0, int_buf,
+                                         graph_tree_int_words(RANDOM_SIZE)));
+    TEST_ASSERT_EQUAL(RANDOM_SIZE, tree.num_nodes);
+
+    for (idx = 0; idx < 2000; idx++)
+    {
+        left_id = graph_rng_below(&rng, RANDOM_SIZE);
+        right_id = graph_rng_below(&rng, RANDOM_SIZE);
+        lca_id = naive_lca(tree.parent, tree.depth, left_id, right_id);
+        TEST_ASSERT_EQUAL(lca_id, graph_tree_lca(&tree, left_id, right_id));
+        TEST_ASSERT_EQUAL(lca_id == left_id,
+                          graph_tree_is_ancestor(&tree, left_id, right_id));
+        TEST_ASSERT_EQUAL(lca_id,
+                          graph_tree_kth_ancestor(&tree, left_id,
+                                                  tree.depth[left_id] -
+                                                  tree.depth[lca_id]));
+    }
+    free(int_buf);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  build a small tree, verify lca, ancestor and kth ancestor queries  */
+    RUN_TEST(test_queries_on_small_tree);
+    /*  verify subtrees are contiguous ranges and unreached nodes left out  */
+    RUN_TEST(test_subtree_ranges);
+    /*  give a node two parents and the root a parent, verify errors  */
+    RUN_TEST(test_rejects_non_trees);
+    /*  compare queries against walking parents on a random tree  */
+    RUN_TEST(test_random_tree_matches_naive);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize a graph with one bucket per node.
+ */
+static void init_graph(Graph *graph, Node *node_arr, int size)
+{
+    int idx;
+
+    graph_init(graph, node_arr, size);
+    for (idx = 0; idx < size; idx++)
+    {
+        graph_add_bucket(graph, idx, malloc(sizeof(Bucket)));
+    }
+}
+
+/*
+ * Find the lowest common ancestor by walking parents.
+ */
+static int naive_lca(const int *parent, const int *depth, int left_id,
+                     int right_id)
+{
+    while (depth[left_id] > depth[right_id])
+    {
+        left_id = parent[left_id];
+    }
+    while (depth[right_id] > depth[left_id])
+    {
+        right_id = parent[right_id];
+    }
+    while (left_id != right_id)
+    {
+        left_id = parent[left_id];
+        right_id = parent[right_id];
+    }
+    return left_id;
+}
@@ -0,0 +1,313 @@
+/*
+ * Random walks and node2vec sampling over graph snapshots.
+ * See https://en.wikipedia.org/wiki/Alias_method and the node2vec paper
+ * (Grover and Leskovec, 2016) for the theory.
+ *
+ * Walks run over a snapshot from graph_csr.h rather than over bucket chains:
+ * a node's neighbors are one contiguous row, so a uniform step is a single
+ * random index into it.
+ *   - Uniform walks pick each next node uniformly among the neighbors.
+ *   - Weighted walks pick neighbors in proportion to the snapshot's weights in
+ *     O(1) per step using per-row alias tables.
+ *   - node2vec walks bias each step by where the walk came from: returning to
+ *     the previous node is weighted by 1/p, staying next to it by 1 and moving
+ *     away from it by 1/q. Rather than building a table for every (previous,
+ *     current) pair, a candidate is drawn from the first-order distribution and
+ *     accepted with probability bias / max_bias.
+ *
+ * === How to Use ===
+ * This header does no memory management. For weighted or weighted node2vec
+ * walks, allocate a double array and an int array with one entry per neighbor
+ * entry of the snapshot and fill them once with 'graph_walk_alias_build'.
+ *
+ * Describe the walk with a 'WalkParams' and generate walks in batches with
+ * 'graph_walk_batch'. Every walk seeds its own generator from the batch seed
+ * and the walk's global number, so a set of walks comes out the same no matter
+ * how it is divided into batches. To use several threads, give each a disjoint
+ * range of walk numbers; the snapshot and alias tables are only read.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#ifndef GRAPH_WALK_H
+#define GRAPH_WALK_H
+
+#include "graph_csr.h"
+#include "graph_rng.h"
+
+typedef struct WalkParamsTag WalkParams;
+
+static int graph_walk_first_order(const CsrGraph *csr,
+                                  const WalkParams *params, int node_id,
+                                  GraphRng *rng);
+
+/*
+ * Parameters of a random walk.
+ *
+ * @prob: Alias table acceptance probabilities, from 'graph_walk_alias_build'.
+ *   Null for unweighted steps.
+ * @alias: Alias table fallbacks, parallel to @prob. Null if @prob is null.
+ * @return_param: node2vec p. Returning to the previous node is weighted 1/p.
+ * @inout_param: node2vec q. Moving away from the previous node is weighted 1/q.
+ *   Walks with p = q = 1 are first-order walks and skip the rejection test.
+ */
+struct WalkParamsTag
+{
+    double *prob;
+    int *alias;
+    double return_param;
+    double inout_param;
+};
+
+/*
+ * Set up parameters for a first-order walk.
+ *
+ * @prob: Alias table probabilities, or null for uniform steps.
+ * @alias: Alias table fallbacks, or null for uniform steps.
+ */
+static void graph_walk_params_init(WalkParams *params, double *prob,
+                                   int *alias)
+{
+    params->prob = prob;
+    params->alias = alias;
+    params->return_param = 1.0;
+    params->inout_param = 1.0;
+}
+
+/*
+ * Build the alias table of every row of a weighted snapshot (Vose's method).
+ * After this, a neighbor entry is drawn in proportion to its weight by picking
+ * a slot i of the row uniformly and taking it with probability prob[i], or
+ * taking the row's alias[i]-th entry otherwise.
+ *
+ * @csr: Weighted snapshot. All weights must be non-negative and each non-empty
+ *   row must have a positive weight sum.
+ * @prob: Array of csr->num_entries doubles.
+ * @alias: Array of csr->num_entries ints. Holds offsets within the row.
+ * @scratch: Array of ints as long as the largest row.
+ */
+static void graph_walk_alias_build(const CsrGraph *csr, double *prob,
+                                   int *alias, int *scratch)
+{
+    int node_id;
+    int start;
+    int degree;
+    int idx;
+    int num_small;
+    int num_large;
+    int small;
+    int large;
+    double sum;
+
+    for (node_id = 0; node_id < csr->num_nodes; node_id++)
+    {
+        start = csr->offsets[node_id];
+        degree = csr->offsets[node_id + 1] - start;
+        if (degree == 0)
+        {
+            continue;
+        }
+
+        /*  scale weights so the average slot holds exactly 1  */
+        sum = 0.0;
+        for (idx = 0; idx < degree; idx++)
+        {
+            sum += graph_csr_weight(csr, start + idx);
+        }
+
+        /*  small slots grow from the front of scratch, large from the back  */
+        num_small = 0;
+        num_large = 0;
+        for (idx = 0; idx < degree; idx++)
+        {
+            prob[start + idx] = graph_csr_weight(csr, start + idx) *
+                                degree / sum;
+            alias[start + idx] = idx;
+            if (prob[start + idx] < 1.0)
+            {
+                scratch[num_small++] = idx;
+            }
+            else
+            {
+                scratch[degree - 1 - num_large++] = idx;
+            }
+        }
+
+        /*  top up each small slot with mass from a large one  */
+        while (num_small > 0 && num_large > 0)
+        {
+            small = scratch[--num_small];
+            large = scratch[degree - num_large];
+            alias[start + small] = large;
+            prob[start + large] -= 1.0 - prob[start + small];
+            if (prob[start + large] < 1.0)
+            {
+                num_large--;
+                scratch[num_small++] = large;
+            }
+        }
+
+        /*  leftovers are 1 up to rounding  */
+        while (num_large > 0)
+        {
+            prob[start + scratch[degree - num_large--]] = 1.0;
+        }
+        while (num_small > 0)
+        {
+            prob[start + scratch[--num_small]] = 1.0;
+        }
+    }
+}
+
+/*
+ * Generate a single walk.
+ *
+ * @csr: The snapshot to walk. Rows must be sorted (they are after building)
+ *   for node2vec walks.
+ * @params: Walk parameters.
+ * @start_id: Node the walk starts at. Assumed to be valid.
+ * @length: Number of nodes in a full walk, including @start_id.
+ * @path: Array of @length ints. Receives the walk. Entries after a dead end
+ *   are set to -1.
+ * @rng: Generator to draw from.
+ * @return: The number of nodes walked, @length unless a node without
+ *   neighbors ended the walk early.
+ */
+static int graph_walk(const CsrGraph *csr, const WalkParams *params,
+                      int start_id, int length, int *path, GraphRng *rng)
+{
+    int step;
+    int walked;
+    int prev;
+    int cur;
+    int next;
+    int second_order;
+    double max_bias;
+    double bias;
+
+    second_order = (params->return_param != 1.0 ||
+                    params->inout_param != 1.0);
+    max_bias = 1.0;
+    if (1.0 / params->return_param > max_bias)
+    {
+        max_bias = 1.0 / params->return_param;
+    }
+    if (1.0 / params->inout_param > max_bias)
+    {
+        max_bias = 1.0 / params->inout_param;
+    }
+
+    walked = 0;
+    prev = -1;
+    cur = start_id;
+    if (length > 0)
+    {
+        path[walked++] = cur;
+    }
+    for (step = 1; step < length; step++)
+    {
+        if (csr->offsets[cur] == csr->offsets[cur + 1])
+        {
+            break;
+        }
+
+        /*  the first step has no history, so it is always first-order  */
+        next = graph_walk_first_order(csr, params, cur, rng);
+        while (second_order && prev != -1)
+        {
+            if (next == prev)
+            {
+                bias = 1.0 / params->return_param;
+            }
+            else if (graph_csr_find(csr, prev, next) != -1)
+            {
+                bias = 1.0;
+            }
+            else
+            {
+                bias = 1.0 / params->inout_param;
+            }
+            if (graph_rng_double(rng) * max_bias < bias)
+            {
+                break;
+            }
+            next = graph_walk_first_order(csr, params, cur, rng);
+        }
+
+        path[walked++] = next;
+        prev = cur;
+        cur = next;
+    }
+
+    for (step = walked; step < length; step++)
+    {
+        path[step] = -1;
+    }
+    return walked;
+}
+
+/*
+ * Generate a batch of walks.
+ * Walk i of the batch is walk number (@first_walk + i) of the whole job and
+ * draws from its own generator seeded with (@seed, @first_walk + i).
+ *
+ * @csr: The snapshot to walk.
+ * @params: Walk parameters.
+ * @starts: Start node of each walk of the batch.
+ * @num_walks: Number of walks in the batch.
+ * @length: Number of nodes in a full walk.
+ * @paths: Array of @num_walks * @length ints. Walk i is written at
+ *   paths[i * @length], padded with -1 after a dead end.
+ * @seed: Seed shared by every batch of the job.
+ * @first_walk: Global number of the first walk of the batch.
+ * @return: The total number of nodes walked.
+ */
+static long graph_walk_batch(const CsrGraph *csr, const WalkParams *params,
+                             const int *starts, int num_walks, int length,
+                             int *paths, unsigned long seed, long first_walk)
+{
+    GraphRng rng;
+    int walk;
+    long total;
+
+    total = 0;
+    for (walk = 0; walk < num_walks; walk++)
+    {
+        graph_rng_seed(&rng, seed, (unsigned long)(first_walk + walk));
+        total += graph_walk(csr, params, starts[walk], length,
+                            paths + (long)walk * length, &rng);
+    }
+
+    return total;
+}
+
+
+/* === HELPER FUNCTIONS === */
+
+/*
+ * Draw a neighbor of a node from the first-order distribution: uniform, or in
+ * proportion to weight if the parameters carry alias tables.
+ *
+ * @node_id: Node to step from. Must have at least one neighbor.
+ * @return: Id of the chosen neighbor.
+ */
+static int graph_walk_first_order(const CsrGraph *csr,
+                                  const WalkParams *params, int node_id,
+                                  GraphRng *rng)
+{
+    int start;
+    int slot;
+
+    start = csr->offsets[node_id];
+    slot = start + graph_rng_below(rng, csr->offsets[node_id + 1] - start);
+    if (params->prob != 0 && graph_rng_double(rng) >= params->prob[slot])
+    {
+        slot = start + params->alias[slot];
+    }
+
+    return csr->adj[slot];
+}
+
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Unit tests for the random walk and random number headers.
+ *
+ * Written by agent, October 2026.
+ * Released into the public domain under CC0. See README.md for more details.
+ */
+
+#include "graph_walk.h"
+#include "../../deps/unity/unity.h"
+#include <stdlib.h>
+
+#define INIT_SIZE 10
+#define MAX_ENTRIES 64
+
+static void init_graph(Graph *graph, Node *node_arr);
+
+
+void test_rng_streams()
+{
+    GraphRng rng_a, rng_b, rng_c;
+    int idx;
+    int same;
+
+    graph_rng_seed(&rng_a, 42, 0);
+    graph_rng_seed(&rng_b, 42, 0);
+    graph_rng_seed(&rng_c, 42, 1);
+
+    same = 0;
+    for (idx = 0; idx < 100; idx++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(graph_rng_next(&rng_a),
+                                 graph_rng_next(&rng_b));
+        same += (graph_rng_next(&rng_b) == graph_rng_next(&rng_c));
+        graph_rng_next(&rng_a);
+    }
+    TEST_ASSERT_TRUE(same < 2);
+    TEST_ASSERT_EQUAL_UINT32(graph_rng_hash(7, 3), graph_rng_hash(7, 3));
+    TEST_ASSERT_TRUE(graph_rng_hash(7, 3) != graph_rng_hash(7, 4));
+}
+
+void test_rng_ranges()
+{
+    GraphRng rng;
+    int counts[7] = { 0 };
+    int idx;
+    int value;
+    double real;
+
+    graph_rng_seed(&rng, 1, 0);
+    for (idx = 0; idx < 70000; idx++)
+    {
+        value = graph_rng_below(&rng, 7);
+        TEST_ASSERT_TRUE(value >= 0 && value < 7);
+        counts[value]++;
+        real = graph_rng_double(&rng);
+        TEST_ASSERT_TRUE(real >= 0.0 && real < 1.0);
+    }
+    for (idx = 0; idx < 7; idx++)
+    {
+        TEST_ASSERT_INT_WITHIN(500, 10000, counts[idx]);
+    }
+}
+
+void test_walk_dead_end()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    WalkParams params;
+    GraphRng rng;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int path[6];
+
+    init_graph(&graph, node_arr);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 1, 2);
+    graph_add_edge(&graph, 2, 3);
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+    graph_walk_params_init(&params, 0, 0);
+    graph_rng_seed(&rng, 5, 0);
+
+    TEST_ASSERT_EQUAL(4, graph_walk(&csr, &params, 0, 6, path, &rng));
+    TEST_ASSERT_EQUAL(0, path[0]);
+    TEST_ASSERT_EQUAL(1, path[1]);
+    TEST_ASSERT_EQUAL(2, path[2]);
+    TEST_ASSERT_EQUAL(3, path[3]);
+    TEST_ASSERT_EQUAL(-1, path[4]);
+    TEST_ASSERT_EQUAL(-1, path[5]);
+}
+
+void test_walk_follows_edges()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    WalkParams params;
+    GraphRng rng;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int path[50];
+    int idx;
+
+    /* A ring with chords, every node has out-edges. */
+    init_graph(&graph, node_arr);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+        graph_add_edge(&graph, idx, (idx + 3) % INIT_SIZE);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+    graph_walk_params_init(&params, 0, 0);
+    graph_rng_seed(&rng, 9, 0);
+
+    TEST_ASSERT_EQUAL(50, graph_walk(&csr, &params, 4, 50, path, &rng));
+    for (idx = 1; idx < 50; idx++)
+    {
+        TEST_ASSERT_TRUE(graph_csr_find(&csr, path[idx - 1], path[idx]) != -1);
+    }
+}
+
+void test_alias_weighted_steps()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    WalkParams params;
+    GraphRng rng;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    double weights[MAX_ENTRIES];
+    double prob[MAX_ENTRIES];
+    int alias[MAX_ENTRIES];
+    int scratch[INIT_SIZE];
+    int path[2];
+    int counts[4] = { 0 };
+    int idx;
+
+    init_graph(&graph, node_arr);
+    graph_add_edge(&graph, 0, 1);
+    graph_add_edge(&graph, 0, 2);
+    graph_add_edge(&graph, 0, 3);
+    graph_csr_build(&graph, &csr, offsets, adj, 0);
+    weights[0] = 1.0;
+    weights[1] = 2.0;
+    weights[2] = 7.0;
+    csr.weights = weights;
+
+    graph_walk_alias_build(&csr, prob, alias, scratch);
+    graph_walk_params_init(&params, prob, alias);
+    graph_rng_seed(&rng, 3, 0);
+    for (idx = 0; idx < 100000; idx++)
+    {
+        graph_walk(&csr, &params, 0, 2, path, &rng);
+        counts[path[1]]++;
+    }
+
+    TEST_ASSERT_INT_WITHIN(600, 10000, counts[1]);
+    TEST_ASSERT_INT_WITHIN(800, 20000, counts[2]);
+    TEST_ASSERT_INT_WITHIN(1000, 70000, counts[3]);
+}
+
+void test_node2vec_return_bias()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    WalkParams params;
+    GraphRng rng;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int path[101];
+    int idx;
+    int returns;
+
+    /* An undirected ring, each step can go back or onward. */
+    init_graph(&graph, node_arr);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+
+    graph_walk_params_init(&params, 0, 0);
+    params.return_param = 0.01;
+    graph_rng_seed(&rng, 11, 0);
+    graph_walk(&csr, &params, 0, 101, path, &rng);
+
+    returns = 0;
+    for (idx = 2; idx < 101; idx++)
+    {
+        returns += (path[idx] == path[idx - 2]);
+    }
+    TEST_ASSERT_TRUE(returns > 90);
+
+    /* Large p and small q push the walk onward instead. */
+    params.return_param = 100.0;
+    params.inout_param = 0.01;
+    graph_walk(&csr, &params, 0, 101, path, &rng);
+    returns = 0;
+    for (idx = 2; idx < 101; idx++)
+    {
+        returns += (path[idx] == path[idx - 2]);
+    }
+    TEST_ASSERT_TRUE(returns < 10);
+}
+
+void test_batches_are_split_independent()
+{
+    Graph graph;
+    Node node_arr[INIT_SIZE];
+    CsrGraph csr;
+    WalkParams params;
+    int offsets[INIT_SIZE + 1];
+    int adj[MAX_ENTRIES];
+    int starts[8];
+    int whole[8 * 12];
+    int split[8 * 12];
+    int idx;
+
+    init_graph(&graph, node_arr);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_edge(&graph, idx, (idx + 1) % INIT_SIZE);
+        graph_add_edge(&graph, idx, (idx + 4) % INIT_SIZE);
+        starts[idx % 8] = idx;
+    }
+    graph_csr_build(&graph, &csr, offsets, adj, 1);
+    graph_walk_params_init(&params, 0, 0);
+    params.inout_param = 0.5;
+
+    TEST_ASSERT_EQUAL(8 * 12, graph_walk_batch(&csr, &params, starts, 8, 12,
+                                               whole, 77, 0));
+    graph_walk_batch(&csr, &params, starts, 3, 12, split, 77, 0);
+    graph_walk_batch(&csr, &params, starts + 3, 5, 12, split + 3 * 12, 77, 3);
+
+    TEST_ASSERT_EQUAL_INT_ARRAY(whole, split, 8 * 12);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+
+    /*  seed generators, verify streams repeat and differ  */
+    RUN_TEST(test_rng_streams);
+    /*  draw bounded values, verify range and uniformity  */
+    RUN_TEST(test_rng_ranges);
+
+    /*  walk a path into a dead end, verify padding  */
+    RUN_TEST(test_walk_dead_end);
+    /*  walk a ring with chords, verify every step is an edge  */
+    RUN_TEST(test_walk_follows_edges);
+    /*  step from a weighted star, verify frequencies follow weights  */
+    RUN_TEST(test_alias_weighted_steps);
+    /*  walk a ring with node2vec biases, verify return behavior  */
+    RUN_TEST(test_node2vec_return_bias);
+    /*  generate walks in one batch and in two, verify they match  */
+    RUN_TEST(test_batches_are_split_independent);
+
+
+    UNITY_END();
+}
+
+/*
+ * Initialize a graph of INIT_SIZE nodes with one bucket per node.
+ */
+static void init_graph(Graph *graph, Node *node_arr)
+{
+    int idx;
+
+    graph_init(graph, node_arr, INIT_SIZE);
+    for (idx = 0; idx < INIT_SIZE; idx++)
+    {
+        graph_add_bucket(graph, idx, malloc(sizeof(Bucket)));
+    }
+}